@@ -0,0 +1,25 @@
+# - find DuckDB
+# DUCKDB_INCLUDE_DIR - Where to find duckdb.h
+# DUCKDB_LIBRARY - DuckDB library
+# DUCKDB_FOUND - Set to TRUE if header and library were found
+
+FIND_PATH( DUCKDB_INCLUDE_DIR duckdb.h )
+
+FIND_LIBRARY( DUCKDB_LIBRARY NAMES duckdb )
+
+IF( DUCKDB_INCLUDE_DIR AND DUCKDB_LIBRARY )
+	SET( DUCKDB_FOUND TRUE )
+ENDIF( DUCKDB_INCLUDE_DIR AND DUCKDB_LIBRARY )
+
+IF( DUCKDB_FOUND )
+	IF( NOT DUCKDB_FIND_QUIETLY )
+		MESSAGE( STATUS "Found DuckDB header file in ${DUCKDB_INCLUDE_DIR}")
+		MESSAGE( STATUS "Found DuckDB library: ${DUCKDB_LIBRARY}")
+	ENDIF( NOT DUCKDB_FIND_QUIETLY )
+ELSE( DUCKDB_FOUND )
+	IF( DUCKDB_FIND_REQUIRED )
+		MESSAGE( FATAL_ERROR "Could not find DuckDB" )
+	ELSE( DUCKDB_FIND_REQUIRED )
+		MESSAGE( STATUS "Optional package DuckDB was not found" )
+	ENDIF( DUCKDB_FIND_REQUIRED )
+ENDIF( DUCKDB_FOUND )
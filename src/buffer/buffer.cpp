@@ -29,18 +29,18 @@
 #include "unit.h"
 #include "nullablevector.h"
 
-unsigned int Buffer::ids_ = 0;
+std::atomic<unsigned int> Buffer::ids_ {0};
 
 /**
  * Creates an empty buffer withput an DBO type
  *
  */
 Buffer::Buffer()
+    : last_one_(false)
 {
     logdbg  << "Buffer: constructor: start";
 
-    id_ = ids_;
-    ++ids_;
+    id_ = ids_++;
 
     logdbg  << "Buffer: constructor: end";
 }
@@ -51,14 +51,14 @@ Buffer::Buffer()
  *
  * \param member_list PropertyList defining all properties
  * \param type DBO type
+ * \param pool storage pool of the creating run, may be nullptr
  */
-Buffer::Buffer(PropertyList properties, const std::string &dbo_name)
-    : dbo_name_(dbo_name), last_one_(false)
+Buffer::Buffer(PropertyList properties, const std::string &dbo_name, std::shared_ptr<BufferPool> pool)
+    : dbo_name_(dbo_name), pool_(pool), last_one_(false)
 {
     logdbg  << "Buffer: constructor: start";
 
-    id_ = ids_;
-    ++ids_;
+    id_ = ids_++;
 
     for (unsigned int cnt=0; cnt < properties.size(); cnt++)
         addProperty(properties.at(cnt));
@@ -99,56 +99,34 @@ void Buffer::addProperty (std::string id, PropertyDataType type)
     switch (type)
     {
     case PropertyDataType::BOOL:
-        assert (getArrayListMap<bool>().count(id) == 0);
-        getArrayListMap<bool>()[id] =
-                std::shared_ptr<NullableVector<bool>> (new NullableVector<bool>(property, *this));
+        addArrayList<bool>(property);
         break;
     case PropertyDataType::CHAR:
-        assert (getArrayListMap<char>().count(id) == 0);
-        getArrayListMap<char>() [id] =
-                std::shared_ptr<NullableVector<char>> (new NullableVector<char>(property, *this));
+        addArrayList<char>(property);
         break;
     case PropertyDataType::UCHAR:
-        assert (getArrayListMap<unsigned char>().count(id) == 0);
-        getArrayListMap<unsigned char>() [id] =
-                std::shared_ptr<NullableVector<unsigned char>> (new NullableVector<unsigned char>(property,
-                                                                                                        *this));
+        addArrayList<unsigned char>(property);
         break;
     case PropertyDataType::INT:
-        assert (getArrayListMap<int>().count(id) == 0);
-        getArrayListMap<int>() [id] =
-                std::shared_ptr<NullableVector<int>> (new NullableVector<int>(property, *this));
+        addArrayList<int>(property);
         break;
     case PropertyDataType::UINT:
-        assert (getArrayListMap<unsigned int>().count(id) == 0);
-        getArrayListMap<unsigned int>() [id] =
-                std::shared_ptr<NullableVector<unsigned int>> (new NullableVector<unsigned int>(property, *this));
+        addArrayList<unsigned int>(property);
         break;
     case PropertyDataType::LONGINT:
-        assert (getArrayListMap<long int>().count(id) == 0);
-        getArrayListMap<long int>() [id] =
-                std::shared_ptr<NullableVector<long>> (new NullableVector<long>(property, *this));
+        addArrayList<long int>(property);
         break;
     case PropertyDataType::ULONGINT:
-        assert (getArrayListMap<unsigned long int>().count(id) == 0);
-        getArrayListMap<unsigned long int>() [id] =
-                std::shared_ptr<NullableVector<unsigned long>> (new NullableVector<unsigned long>(property,
-                                                                                                        *this));
+        addArrayList<unsigned long int>(property);
         break;
     case PropertyDataType::FLOAT:
-        assert (getArrayListMap<float>().count(id) == 0);
-        getArrayListMap<float>() [id] =
-                std::shared_ptr<NullableVector<float>> (new NullableVector<float>(property, *this));
+        addArrayList<float>(property);
         break;
     case PropertyDataType::DOUBLE:
-        assert (getArrayListMap<double>().count(id) == 0);
-        getArrayListMap<double>() [id] =
-                std::shared_ptr<NullableVector<double>> (new NullableVector<double>(property, *this));
+        addArrayList<double>(property);
         break;
     case PropertyDataType::STRING:
-        assert (getArrayListMap<std::string>().count(id) == 0);
-        getArrayListMap<std::string>() [id] =
-                std::shared_ptr<NullableVector<std::string>> (new NullableVector<std::string>(property, *this));
+        addArrayList<std::string>(property);
         break;
     default:
         logerr  <<  "Buffer: addProperty: unknown property type " << Property::asString(type);
@@ -223,6 +201,82 @@ void Buffer::cutToSize (size_t size)
     data_size_ = size;
 }
 
+void Buffer::reserve (size_t size)
+{
+    logdbg  << "Buffer: reserve: size " << size;
+
+    for (auto& it : getArrayListMap<bool>())
+        it.second->reserve(size);
+    for (auto& it : getArrayListMap<char>())
+        it.second->reserve(size);
+    for (auto& it : getArrayListMap<unsigned char>())
+        it.second->reserve(size);
+    for (auto& it : getArrayListMap<int>())
+        it.second->reserve(size);
+    for (auto& it : getArrayListMap<unsigned int>())
+        it.second->reserve(size);
+    for (auto& it : getArrayListMap<long int>())
+        it.second->reserve(size);
+    for (auto& it : getArrayListMap<unsigned long int>())
+        it.second->reserve(size);
+    for (auto& it : getArrayListMap<float>())
+        it.second->reserve(size);
+    for (auto& it : getArrayListMap<double>())
+        it.second->reserve(size);
+    for (auto& it : getArrayListMap<std::string>())
+        it.second->reserve(size);
+}
+
+std::vector<size_t> Buffer::handleIndexes ()
+{
+    std::vector<size_t> indexes;
+
+    for (unsigned int cnt=0; cnt < properties_.size(); ++cnt)
+    {
+        const Property& property = properties_.at(cnt);
+
+        switch (property.dataType())
+        {
+        case PropertyDataType::BOOL:
+            indexes.push_back(handle<bool>(property.name()).index());
+            break;
+        case PropertyDataType::CHAR:
+            indexes.push_back(handle<char>(property.name()).index());
+            break;
+        case PropertyDataType::UCHAR:
+            indexes.push_back(handle<unsigned char>(property.name()).index());
+            break;
+        case PropertyDataType::INT:
+            indexes.push_back(handle<int>(property.name()).index());
+            break;
+        case PropertyDataType::UINT:
+            indexes.push_back(handle<unsigned int>(property.name()).index());
+            break;
+        case PropertyDataType::LONGINT:
+            indexes.push_back(handle<long int>(property.name()).index());
+            break;
+        case PropertyDataType::ULONGINT:
+            indexes.push_back(handle<unsigned long int>(property.name()).index());
+            break;
+        case PropertyDataType::FLOAT:
+            indexes.push_back(handle<float>(property.name()).index());
+            break;
+        case PropertyDataType::DOUBLE:
+            indexes.push_back(handle<double>(property.name()).index());
+            break;
+        case PropertyDataType::STRING:
+            indexes.push_back(handle<std::string>(property.name()).index());
+            break;
+        default:
+            logerr  <<  "Buffer: handleIndexes: unknown property type " << Property::asString(property.dataType());
+            throw std::runtime_error ("Buffer: handleIndexes: unknown property type "
+                                      +Property::asString(property.dataType()));
+        }
+    }
+
+    return indexes;
+}
+
 const PropertyList& Buffer::properties ()
 {
     return properties_;
@@ -574,34 +628,34 @@ std::shared_ptr<Buffer> Buffer::getPartialCopy (const PropertyList& partial_prop
         switch (prop.dataType())
         {
         case PropertyDataType::BOOL:
-            tmp_buffer->get<bool>(prop.name()).copyData(get<bool>(prop.name()));
+            tmp_buffer->get<bool>(prop.name()).shareData(get<bool>(prop.name()));
             break;
         case PropertyDataType::CHAR:
-            tmp_buffer->get<char>(prop.name()).copyData(get<char>(prop.name()));
+            tmp_buffer->get<char>(prop.name()).shareData(get<char>(prop.name()));
             break;
         case PropertyDataType::UCHAR:
-            tmp_buffer->get<unsigned char>(prop.name()).copyData(get<unsigned char>(prop.name()));
+            tmp_buffer->get<unsigned char>(prop.name()).shareData(get<unsigned char>(prop.name()));
             break;
         case PropertyDataType::INT:
-            tmp_buffer->get<int>(prop.name()).copyData(get<int>(prop.name()));
+            tmp_buffer->get<int>(prop.name()).shareData(get<int>(prop.name()));
             break;
         case PropertyDataType::UINT:
-            tmp_buffer->get<unsigned int>(prop.name()).copyData(get<unsigned int>(prop.name()));
+            tmp_buffer->get<unsigned int>(prop.name()).shareData(get<unsigned int>(prop.name()));
             break;
         case PropertyDataType::LONGINT:
-            tmp_buffer->get<long int>(prop.name()).copyData(get<long int>(prop.name()));
+            tmp_buffer->get<long int>(prop.name()).shareData(get<long int>(prop.name()));
             break;
         case PropertyDataType::ULONGINT:
-            tmp_buffer->get<unsigned long int>(prop.name()).copyData(get<unsigned long int>(prop.name()));
+            tmp_buffer->get<unsigned long int>(prop.name()).shareData(get<unsigned long int>(prop.name()));
             break;
         case PropertyDataType::FLOAT:
-            tmp_buffer->get<float>(prop.name()).copyData(get<float>(prop.name()));
+            tmp_buffer->get<float>(prop.name()).shareData(get<float>(prop.name()));
             break;
         case PropertyDataType::DOUBLE:
-            tmp_buffer->get<double>(prop.name()).copyData(get<double>(prop.name()));
+            tmp_buffer->get<double>(prop.name()).shareData(get<double>(prop.name()));
             break;
         case PropertyDataType::STRING:
-            tmp_buffer->get<std::string>(prop.name()).copyData(get<std::string>(prop.name()));
+            tmp_buffer->get<std::string>(prop.name()).shareData(get<std::string>(prop.name()));
             break;
         default:
             logerr  <<  "Buffer: getPartialCopy: unknown property type "
@@ -614,6 +668,66 @@ std::shared_ptr<Buffer> Buffer::getPartialCopy (const PropertyList& partial_prop
     return tmp_buffer;
 }
 
+std::shared_ptr<Buffer> Buffer::getView (size_t offset, size_t length)
+{
+    logdbg << "Buffer: getView: offset " << offset << " length " << length;
+
+    std::shared_ptr<Buffer> tmp_buffer {new Buffer()};
+    tmp_buffer->dbo_name_ = dbo_name_;
+
+    for (unsigned int cnt=0; cnt < properties_.size(); ++cnt)
+    {
+        Property prop = properties_.at(cnt);
+        tmp_buffer->addProperty(prop);
+
+        switch (prop.dataType())
+        {
+        case PropertyDataType::BOOL:
+            tmp_buffer->get<bool>(prop.name()).shareData(get<bool>(prop.name()), offset, length);
+            break;
+        case PropertyDataType::CHAR:
+            tmp_buffer->get<char>(prop.name()).shareData(get<char>(prop.name()), offset, length);
+            break;
+        case PropertyDataType::UCHAR:
+            tmp_buffer->get<unsigned char>(prop.name()).shareData(get<unsigned char>(prop.name()), offset, length);
+            break;
+        case PropertyDataType::INT:
+            tmp_buffer->get<int>(prop.name()).shareData(get<int>(prop.name()), offset, length);
+            break;
+        case PropertyDataType::UINT:
+            tmp_buffer->get<unsigned int>(prop.name()).shareData(get<unsigned int>(prop.name()), offset, length);
+            break;
+        case PropertyDataType::LONGINT:
+            tmp_buffer->get<long int>(prop.name()).shareData(get<long int>(prop.name()), offset, length);
+            break;
+        case PropertyDataType::ULONGINT:
+            tmp_buffer->get<unsigned long int>(prop.name()).shareData(get<unsigned long int>(prop.name()),
+                                                                      offset, length);
+            break;
+        case PropertyDataType::FLOAT:
+            tmp_buffer->get<float>(prop.name()).shareData(get<float>(prop.name()), offset, length);
+            break;
+        case PropertyDataType::DOUBLE:
+            tmp_buffer->get<double>(prop.name()).shareData(get<double>(prop.name()), offset, length);
+            break;
+        case PropertyDataType::STRING:
+            tmp_buffer->get<std::string>(prop.name()).shareData(get<std::string>(prop.name()), offset, length);
+            break;
+        default:
+            logerr  <<  "Buffer: getView: unknown property type "
+                     << Property::asString(prop.dataType());
+            throw std::runtime_error ("Buffer: getView: unknown property type "
+                                      + Property::asString(prop.dataType()));
+        }
+    }
+
+    // rows with only lazy nulls in all containers
+    if (offset < data_size_)
+        tmp_buffer->data_size_ = std::min(length, data_size_ - offset);
+
+    return tmp_buffer;
+}
+
 
 
 
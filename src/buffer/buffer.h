@@ -22,11 +22,18 @@
 #include <tuple>
 #include <vector>
 #include <memory>
+#include <limits>
+#include <type_traits>
+#include <atomic>
 
 #include "propertylist.h"
+#include "bufferpool.h"
 
 class DBOVariableSet;
 
+/// Enables additional bounds assertions, defined here for the inline accessors before nullablevector.h
+const bool BUFFER_PEDANTIC_CHECKING=false;
+
 template <class T> class NullableVector;
 
 typedef std::tuple< std::map <std::string, std::shared_ptr<NullableVector<bool>>>,
@@ -40,6 +47,17 @@ std::map <std::string, std::shared_ptr<NullableVector<float>>>,
 std::map <std::string, std::shared_ptr<NullableVector<double>>>,
 std::map <std::string, std::shared_ptr<NullableVector<std::string>>> > ArrayListMapTupel;
 
+typedef std::tuple< std::vector <std::shared_ptr<NullableVector<bool>>>,
+std::vector <std::shared_ptr<NullableVector<char>>>,
+std::vector <std::shared_ptr<NullableVector<unsigned char>>>,
+std::vector <std::shared_ptr<NullableVector<int>>>,
+std::vector <std::shared_ptr<NullableVector<unsigned int>>>,
+std::vector <std::shared_ptr<NullableVector<long int>>> ,
+std::vector <std::shared_ptr<NullableVector<unsigned long int>>>,
+std::vector <std::shared_ptr<NullableVector<float>>>,
+std::vector <std::shared_ptr<NullableVector<double>>>,
+std::vector <std::shared_ptr<NullableVector<std::string>>> > ArrayListVectorTupel;
+
 template <class T, class Tuple>
 struct Index;
 
@@ -53,6 +71,26 @@ struct Index<T, std::tuple<U, Types...>> {
     static const std::size_t value = 1 + Index<T, std::tuple<Types...>>::value;
 };
 
+/**
+ * @brief Resolved column of a Buffer
+ *
+ * Obtained once by name through Buffer::handle, gives O(1) access through Buffer::get. Stays valid for all
+ * buffers created from the same PropertyList, e.g. all chunks of one prepared read.
+ */
+template <class T>
+class ColumnHandle
+{
+public:
+    ColumnHandle () {}
+    explicit ColumnHandle (size_t index) : index_(index) {}
+
+    bool valid () const { return index_ != std::numeric_limits<size_t>::max(); }
+    size_t index () const { return index_; }
+
+private:
+    size_t index_ {std::numeric_limits<size_t>::max()};
+};
+
 /**
  * @brief Fast, dynamic data container
  *
@@ -63,12 +101,13 @@ struct Index<T, std::tuple<U, Types...>> {
 class Buffer
 {
     template<class T> friend class NullableVector;
+    friend class BufferCache;
 
 public:
     /// @brief Default constructor.
     Buffer ();
-    /// @brief Constructor.
-    Buffer(PropertyList properties, const std::string &dbo_name="");
+    /// @brief Constructor, containers are taken from pool while it exists.
+    Buffer(PropertyList properties, const std::string &dbo_name="", std::shared_ptr<BufferPool> pool=nullptr);
     /// @brief Desctructor.
     virtual ~Buffer();
 
@@ -94,11 +133,23 @@ public:
 
     template<typename T> NullableVector<T>& get (const std::string &id);
 
+    /// @brief Returns resolved handle for container, throws if not existing
+    template<typename T> ColumnHandle<T> handle (const std::string &id);
+    /// @brief Returns container for handle without name lookup
+    template<typename T> NullableVector<T>& get (const ColumnHandle<T>& handle);
+    /// @brief Returns ColumnHandle indexes of all properties, in order of properties()
+    std::vector<size_t> handleIndexes ();
+
     template<typename T> void rename (const std::string &id, const std::string &id_new);
 
+    /// @brief Calls functor(name, NullableVector<T>&) for all containers, dispatched on the container types
+    template<typename F> void forEachArrayList (F& functor) { forEachArrayListFrom<0>(functor); }
+
     /// @brief  Returns current size
     const size_t size ();
     void cutToSize (size_t size);
+    /// @brief Reserves storage for size rows in all containers, does not change size
+    void reserve (size_t size);
 
     /// @brief Returns PropertyList
     const PropertyList& properties ();
@@ -113,7 +164,10 @@ public:
 
     void transformVariables (DBOVariableSet& list, bool tc2dbovar); // tc2dbovar true for db->dbo, false dbo->db
 
+    /// @brief Returns buffer with given properties, sharing data with this one until either is written
     std::shared_ptr<Buffer> getPartialCopy (const PropertyList& partial_properties);
+    /// @brief Returns buffer of rows [offset, offset+length), sharing data with this one until either is written
+    std::shared_ptr<Buffer> getView (size_t offset, size_t length);
 
 protected:
     /// Unique buffer id, copied when getting shallow copies
@@ -124,17 +178,35 @@ protected:
     std::string dbo_name_;
 
     ArrayListMapTupel array_list_tuple_;
+    /// Containers in order of addition, indexed by ColumnHandle
+    ArrayListVectorTupel array_list_vector_tuple_;
     size_t data_size_ {0};
+    /// Storage pool of the creating run, not owned
+    std::weak_ptr<BufferPool> pool_;
 
     /// Flag indicating if buffer is the last of a DB operation
     bool last_one_;
 
-    static unsigned int ids_;
+    /// Next buffer id, buffers are also created in reading threads
+    static std::atomic<unsigned int> ids_;
 
 private:
     template<typename T> inline std::map <std::string, std::shared_ptr<NullableVector<T>>>& getArrayListMap ();
+    template<typename T> inline std::vector <std::shared_ptr<NullableVector<T>>>& getArrayListVector ();
+    template<typename T> void addArrayList (Property& property);
     template<typename T> void renameArrayListMapEntry (const std::string &id, const std::string &id_new);
     template<typename T> void seizeArrayListMap (Buffer &org_buffer);
+
+    template<size_t I, typename F>
+    typename std::enable_if<I == std::tuple_size<ArrayListMapTupel>::value>::type forEachArrayListFrom (F&) {}
+    template<size_t I, typename F>
+    typename std::enable_if<I < std::tuple_size<ArrayListMapTupel>::value>::type forEachArrayListFrom (F& functor)
+    {
+        for (auto& it : std::get<I>(array_list_tuple_))
+            functor(it.first, *it.second);
+
+        forEachArrayListFrom<I+1>(functor);
+    }
 };
 
 #include "nullablevector.h"
@@ -150,6 +222,26 @@ template<typename T> NullableVector<T>& Buffer::get (const std::string &id)
             ArrayListMapTupel>::value > (array_list_tuple_)).at(id);
 }
 
+template<typename T> ColumnHandle<T> Buffer::handle (const std::string &id)
+{
+    NullableVector<T>* array_list = getArrayListMap<T>().at(id).get();
+    std::vector <std::shared_ptr<NullableVector<T>>>& array_lists = getArrayListVector<T>();
+
+    for (size_t cnt=0; cnt < array_lists.size(); ++cnt)
+        if (array_lists[cnt].get() == array_list)
+            return ColumnHandle<T> (cnt);
+
+    throw std::runtime_error ("Buffer: handle: container "+id+" not indexed");
+}
+
+template<typename T> inline NullableVector<T>& Buffer::get (const ColumnHandle<T>& handle)
+{
+    if (BUFFER_PEDANTIC_CHECKING)
+        assert (handle.index() < getArrayListVector<T>().size());
+
+    return *getArrayListVector<T>()[handle.index()];
+}
+
 template<typename T> void Buffer::rename (const std::string &id, const std::string &id_new)
 {
     renameArrayListMapEntry<T>(id, id_new);
@@ -167,6 +259,20 @@ template<typename T> std::map <std::string, std::shared_ptr<NullableVector<T>>>&
     return std::get< Index<std::map <std::string, std::shared_ptr<NullableVector<T>>>,
             ArrayListMapTupel>::value > (array_list_tuple_);
 }
+template<typename T> std::vector <std::shared_ptr<NullableVector<T>>>& Buffer::getArrayListVector ()
+{
+    return std::get< Index<std::vector <std::shared_ptr<NullableVector<T>>>,
+            ArrayListVectorTupel>::value > (array_list_vector_tuple_);
+}
+
+template<typename T> void Buffer::addArrayList (Property& property)
+{
+    assert (getArrayListMap<T>().count(property.name()) == 0);
+    std::shared_ptr<NullableVector<T>> array_list (new NullableVector<T>(property, *this));
+    getArrayListMap<T>()[property.name()] = array_list;
+    getArrayListVector<T>().push_back(array_list);
+}
+
 template<typename T> void Buffer::renameArrayListMapEntry (const std::string &id, const std::string &id_new)
 {
     assert (getArrayListMap<T>().count(id) == 1);
@@ -184,6 +290,7 @@ template<typename T> void Buffer::seizeArrayListMap (Buffer &org_buffer)
         it.second->addData(*org_buffer.getArrayListMap<T>().at(it.first));
 
     org_buffer.getArrayListMap<T>().clear();
+    org_buffer.getArrayListVector<T>().clear();
 }
 
 #endif /* BUFFER_H_ */
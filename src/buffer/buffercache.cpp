@@ -0,0 +1,475 @@
+/*
+ * This file is part of ATSDB.
+ *
+ * ATSDB is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * ATSDB is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with ATSDB.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <cstdio>
+
+#include <unistd.h>
+#include <utime.h>
+
+#include <QDir>
+#include <QFileInfo>
+
+#include <boost/interprocess/file_mapping.hpp>
+#include <boost/interprocess/mapped_region.hpp>
+
+#include "buffercache.h"
+#include "buffer.h"
+#include "logger.h"
+
+static const char BUFFER_CACHE_MAGIC[8] = {'A', 'T', 'S', 'D', 'B', 'B', 'C', 'F'};
+static const uint32_t BUFFER_CACHE_VERSION = 1;
+/// Alignment of container sections
+static const size_t BUFFER_CACHE_ALIGNMENT = 8;
+/// Counter making temporary file names unique within the process
+static std::atomic<unsigned int> buffer_cache_tmp_count {0};
+
+template <typename V> static void writeValue (std::ofstream& file, V value)
+{
+    file.write(reinterpret_cast<const char*>(&value), sizeof(V));
+}
+
+static void writeString (std::ofstream& file, const std::string& value)
+{
+    writeValue<uint64_t>(file, value.size());
+    file.write(value.data(), value.size());
+}
+
+static void writeAlignment (std::ofstream& file)
+{
+    static const char zeros[BUFFER_CACHE_ALIGNMENT] = {};
+    size_t position = file.tellp();
+
+    if (position % BUFFER_CACHE_ALIGNMENT)
+        file.write(zeros, BUFFER_CACHE_ALIGNMENT - position % BUFFER_CACHE_ALIGNMENT);
+}
+
+template <typename S> static void writeData (std::ofstream& file, const std::vector<S>& data, size_t offset,
+                                             size_t length)
+{
+    file.write(reinterpret_cast<const char*>(data.data() + offset), length * sizeof(S));
+}
+
+static void writeData (std::ofstream& file, const std::vector<bool>& data, size_t offset, size_t length)
+{
+    for (size_t cnt=0; cnt < length; ++cnt)
+        writeValue<uint8_t>(file, data[offset+cnt]);
+}
+
+template <typename V> static bool readValue (const char*& pos, const char* end, V& value)
+{
+    if (end - pos < (ptrdiff_t) sizeof(V))
+        return false;
+
+    memcpy(&value, pos, sizeof(V));
+    pos += sizeof(V);
+    return true;
+}
+
+static bool readString (const char*& pos, const char* end, std::string& value)
+{
+    uint64_t size;
+
+    if (!readValue(pos, end, size) || (uint64_t) (end - pos) < size)
+        return false;
+
+    value.assign(pos, size);
+    pos += size;
+    return true;
+}
+
+/// @brief Skips to next aligned position, mapped file start is page-aligned
+static bool readAlignment (const char*& pos, const char* end)
+{
+    size_t position = reinterpret_cast<uintptr_t>(pos);
+
+    if (position % BUFFER_CACHE_ALIGNMENT)
+        pos += BUFFER_CACHE_ALIGNMENT - position % BUFFER_CACHE_ALIGNMENT;
+
+    return pos <= end;
+}
+
+template <typename S> static bool readData (const char*& pos, const char* end, std::vector<S>& data, size_t length)
+{
+    if ((uint64_t) (end - pos) / sizeof(S) < length)
+        return false;
+
+    data.resize(length);
+
+    if (length)
+        memcpy(data.data(), pos, length * sizeof(S));
+
+    pos += length * sizeof(S);
+    return true;
+}
+
+static bool readData (const char*& pos, const char* end, std::vector<bool>& data, size_t length)
+{
+    if ((uint64_t) (end - pos) < length)
+        return false;
+
+    data.resize(length);
+
+    for (size_t cnt=0; cnt < length; ++cnt)
+        data[cnt] = pos[cnt];
+
+    pos += length;
+    return true;
+}
+
+/// @brief Returns if all codes are in dictionary, only called for dictionary-encoded containers
+template <typename S> static bool validCodes (const std::vector<S>& data, size_t dictionary_size)
+{
+    return true;
+}
+
+static bool validCodes (const std::vector<uint32_t>& data, size_t dictionary_size)
+{
+    for (auto code : data)
+        if (code >= dictionary_size)
+            return false;
+
+    return true;
+}
+
+BufferCache::BufferCache (const std::string& file_name, const std::string& key, long long source_time)
+    : file_name_(file_name), key_(key), source_time_(source_time)
+{
+}
+
+BufferCache::~BufferCache ()
+{
+}
+
+bool BufferCache::valid ()
+{
+    std::ifstream file (file_name_, std::ios::binary);
+
+    if (!file)
+        return false;
+
+    // header is magic, version, source time, key
+    std::vector<char> header (sizeof(BUFFER_CACHE_MAGIC) + sizeof(uint32_t) + sizeof(int64_t) + sizeof(uint64_t)
+                              + key_.size());
+    file.read(header.data(), header.size());
+
+    if (file.gcount() != (std::streamsize) header.size())
+        return false;
+
+    const char* pos = header.data();
+    return readHeader(pos, pos + header.size());
+}
+
+std::shared_ptr<Buffer> BufferCache::read (const std::string& dbo_name)
+{
+    loginf << "BufferCache: read: file " << file_name_;
+
+    try
+    {
+        boost::interprocess::file_mapping mapping (file_name_.c_str(), boost::interprocess::read_only);
+        boost::interprocess::mapped_region region (mapping, boost::interprocess::read_only);
+        region.advise(boost::interprocess::mapped_region::advice_sequential);
+
+        const char* begin = static_cast<const char*> (region.get_address());
+        const char* end = begin + region.get_size();
+        const char* pos = begin;
+
+        if (!readHeader(pos, end))
+        {
+            logwrn << "BufferCache: read: file " << file_name_ << " does not match";
+            return nullptr;
+        }
+
+        uint64_t size;
+        uint64_t num_properties;
+
+        if (!readValue(pos, end, size) || !readValue(pos, end, num_properties))
+            return nullptr;
+
+        std::shared_ptr<Buffer> buffer {new Buffer (PropertyList(), dbo_name)};
+
+        for (uint64_t cnt=0; cnt < num_properties; ++cnt)
+        {
+            std::string name;
+            uint32_t data_type;
+
+            if (!readString(pos, end, name) || !readValue(pos, end, data_type)
+                    || data_type > static_cast<uint32_t>(PropertyDataType::STRING))
+            {
+                logerr << "BufferCache: read: file " << file_name_ << " corrupt property";
+                return nullptr;
+            }
+
+            buffer->addProperty(name, static_cast<PropertyDataType>(data_type));
+
+            bool ok=false;
+
+            switch (static_cast<PropertyDataType>(data_type))
+            {
+            case PropertyDataType::BOOL:
+                ok = readColumn(pos, end, size, buffer->get<bool>(name));
+                break;
+            case PropertyDataType::CHAR:
+                ok = readColumn(pos, end, size, buffer->get<char>(name));
+                break;
+            case PropertyDataType::UCHAR:
+                ok = readColumn(pos, end, size, buffer->get<unsigned char>(name));
+                break;
+            case PropertyDataType::INT:
+                ok = readColumn(pos, end, size, buffer->get<int>(name));
+                break;
+            case PropertyDataType::UINT:
+                ok = readColumn(pos, end, size, buffer->get<unsigned int>(name));
+                break;
+            case PropertyDataType::LONGINT:
+                ok = readColumn(pos, end, size, buffer->get<long int>(name));
+                break;
+            case PropertyDataType::ULONGINT:
+                ok = readColumn(pos, end, size, buffer->get<unsigned long int>(name));
+                break;
+            case PropertyDataType::FLOAT:
+                ok = readColumn(pos, end, size, buffer->get<float>(name));
+                break;
+            case PropertyDataType::DOUBLE:
+                ok = readColumn(pos, end, size, buffer->get<double>(name));
+                break;
+            case PropertyDataType::STRING:
+                ok = readColumn(pos, end, size, buffer->get<std::string>(name));
+                break;
+            }
+
+            if (!ok || !readAlignment(pos, end))
+            {
+                logerr << "BufferCache: read: file " << file_name_ << " corrupt container " << name;
+                return nullptr;
+            }
+        }
+
+        buffer->data_size_ = size;
+
+        utime(file_name_.c_str(), nullptr); // used, evicted last
+
+        loginf << "BufferCache: read: file " << file_name_ << " done with " << size << " rows";
+        return buffer;
+    }
+    catch (boost::interprocess::interprocess_exception& e)
+    {
+        logerr << "BufferCache: read: mapping file " << file_name_ << " failed: " << e.what();
+        return nullptr;
+    }
+}
+
+bool BufferCache::write (Buffer& buffer)
+{
+    loginf << "BufferCache: write: file " << file_name_ << " with " << buffer.size() << " rows";
+
+    // concurrent writes of the same key each use their own file, last rename wins
+    std::string tmp_file_name = file_name_+"."+std::to_string(getpid())+"_"+std::to_string(buffer_cache_tmp_count++)
+            +".tmp";
+    std::ofstream file (tmp_file_name, std::ios::binary | std::ios::trunc);
+
+    if (!file)
+    {
+        logerr << "BufferCache: write: unable to open file " << tmp_file_name;
+        return false;
+    }
+
+    file.write(BUFFER_CACHE_MAGIC, sizeof(BUFFER_CACHE_MAGIC));
+    writeValue<uint32_t>(file, BUFFER_CACHE_VERSION);
+    writeValue<int64_t>(file, source_time_);
+    writeString(file, key_);
+
+    const PropertyList& properties = buffer.properties();
+
+    writeValue<uint64_t>(file, buffer.size());
+    writeValue<uint64_t>(file, properties.size());
+
+    for (unsigned int cnt=0; cnt < properties.size(); ++cnt)
+    {
+        const Property& property = properties.at(cnt);
+        const std::string& name = property.name();
+
+        writeString(file, name);
+        writeValue<uint32_t>(file, static_cast<uint32_t>(property.dataType()));
+
+        switch (property.dataType())
+        {
+        case PropertyDataType::BOOL:
+            writeColumn(file, buffer.get<bool>(name));
+            break;
+        case PropertyDataType::CHAR:
+            writeColumn(file, buffer.get<char>(name));
+            break;
+        case PropertyDataType::UCHAR:
+            writeColumn(file, buffer.get<unsigned char>(name));
+            break;
+        case PropertyDataType::INT:
+            writeColumn(file, buffer.get<int>(name));
+            break;
+        case PropertyDataType::UINT:
+            writeColumn(file, buffer.get<unsigned int>(name));
+            break;
+        case PropertyDataType::LONGINT:
+            writeColumn(file, buffer.get<long int>(name));
+            break;
+        case PropertyDataType::ULONGINT:
+            writeColumn(file, buffer.get<unsigned long int>(name));
+            break;
+        case PropertyDataType::FLOAT:
+            writeColumn(file, buffer.get<float>(name));
+            break;
+        case PropertyDataType::DOUBLE:
+            writeColumn(file, buffer.get<double>(name));
+            break;
+        case PropertyDataType::STRING:
+            writeColumn(file, buffer.get<std::string>(name));
+            break;
+        default:
+            logerr  <<  "BufferCache: write: unknown property type " << Property::asString(property.dataType());
+            throw std::runtime_error ("BufferCache: write: unknown property type "
+                                      + Property::asString(property.dataType()));
+        }
+
+        writeAlignment(file);
+    }
+
+    file.close();
+
+    if (!file || std::rename(tmp_file_name.c_str(), file_name_.c_str()))
+    {
+        logerr << "BufferCache: write: writing file " << file_name_ << " failed";
+        std::remove(tmp_file_name.c_str());
+        return false;
+    }
+
+    loginf << "BufferCache: write: file " << file_name_ << " done";
+    return true;
+}
+
+void BufferCache::limitDirectory (size_t max_bytes)
+{
+    QDir directory = QFileInfo (QString::fromStdString(file_name_)).absoluteDir();
+    QFileInfoList files = directory.entryInfoList(QStringList() << "*.cache", QDir::Files, QDir::Time);
+
+    size_t used = 0;
+
+    for (auto& file_it : files) // most recently used first
+    {
+        used += file_it.size();
+
+        if (used <= max_bytes)
+            continue;
+
+        loginf << "BufferCache: limitDirectory: removing " << file_it.fileName().toStdString();
+
+        if (!directory.remove(file_it.fileName()))
+            logwrn << "BufferCache: limitDirectory: unable to remove " << file_it.fileName().toStdString();
+    }
+}
+
+bool BufferCache::readHeader (const char*& pos, const char* end)
+{
+    if (end - pos < (ptrdiff_t) sizeof(BUFFER_CACHE_MAGIC) || memcmp(pos, BUFFER_CACHE_MAGIC,
+                                                                     sizeof(BUFFER_CACHE_MAGIC)))
+        return false;
+
+    pos += sizeof(BUFFER_CACHE_MAGIC);
+
+    uint32_t version;
+    int64_t source_time;
+    std::string key;
+
+    return readValue(pos, end, version) && version == BUFFER_CACHE_VERSION
+            && readValue(pos, end, source_time) && source_time == source_time_
+            && readString(pos, end, key) && key == key_;
+}
+
+template <typename T> bool BufferCache::readColumn (const char*& pos, const char* end, uint64_t size,
+                                                    NullableVector<T>& column)
+{
+    uint64_t data_length;
+    uint64_t validity_size;
+    uint64_t dictionary_size;
+
+    if (!readValue(pos, end, data_length) || !readValue(pos, end, validity_size)
+            || !readValue(pos, end, dictionary_size))
+        return false;
+
+    if (data_length > size || validity_size > data_length) // flags must not cover rows without data
+        return false;
+
+    if (dictionary_size) // codes in order
+    {
+        std::shared_ptr<StringDictionary> dictionary = std::make_shared<StringDictionary>();
+        std::string value;
+
+        for (uint64_t code=0; code < dictionary_size; ++code)
+        {
+            if (!readString(pos, end, value) || dictionary->add(value) != code)
+                return false;
+        }
+
+        column.dictionary_ = dictionary;
+    }
+
+    if (!readAlignment(pos, end) || !readData(pos, end, *column.data_, data_length))
+        return false;
+
+    if (column.dictionary_ && !validCodes(*column.data_, column.dictionary_->size()))
+        return false;
+
+    if (!readAlignment(pos, end)
+            || !readData(pos, end, *column.validity_, (validity_size + NullableVector<T>::VALIDITY_WORD_BITS - 1)
+                         / NullableVector<T>::VALIDITY_WORD_BITS))
+        return false;
+
+    column.data_offset_ = 0;
+    column.data_length_ = data_length;
+    column.validity_size_ = validity_size;
+
+    return true;
+}
+
+template <typename T> void BufferCache::writeColumn (std::ofstream& file, NullableVector<T>& column)
+{
+    column.compact(); // no-op for partial copies, compacted when created
+
+    // flags beyond the stored data are Null, as are rows without flags beyond it
+    size_t validity_size = std::min(column.validity_size_, column.data_length_);
+    size_t validity_words = (validity_size + NullableVector<T>::VALIDITY_WORD_BITS - 1)
+            / NullableVector<T>::VALIDITY_WORD_BITS;
+    assert (column.validity_->size() >= validity_words);
+
+    writeValue<uint64_t>(file, column.data_length_);
+    writeValue<uint64_t>(file, validity_size);
+    writeValue<uint64_t>(file, column.dictionary_ ? column.dictionary_->size() : 0);
+
+    if (column.dictionary_)
+    {
+        for (uint32_t code=0; code < column.dictionary_->size(); ++code)
+            writeString(file, column.dictionary_->value(code));
+    }
+
+    writeAlignment(file);
+    writeData(file, *column.data_, column.data_offset_, column.data_length_);
+    writeAlignment(file);
+    writeData(file, *column.validity_, 0, validity_words);
+}
+
@@ -0,0 +1,74 @@
+/*
+ * This file is part of ATSDB.
+ *
+ * ATSDB is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * ATSDB is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with ATSDB.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef BUFFERCACHE_H_
+#define BUFFERCACHE_H_
+
+#include <fstream>
+#include <memory>
+#include <string>
+
+class Buffer;
+template <class T> class NullableVector;
+
+/**
+ * @brief Columnar cache file of a Buffer
+ *
+ * Stores the properties and raw containers of a buffer in one file, together with a key identifying the source
+ * and read set and the modification time of the source. Reading maps the file into memory and copies each
+ * container in bulk, so no per-element parsing is done. Host byte order, not intended to be exchanged.
+ *
+ * The modification time of a file is its last use, cache files of a directory are removed least recently used
+ * first by limitDirectory.
+ */
+class BufferCache
+{
+public:
+    /// @brief Constructor, key identifies source and read set, source_time is the source modification time
+    BufferCache (const std::string& file_name, const std::string& key, long long source_time);
+    /// @brief Destructor
+    virtual ~BufferCache ();
+
+    /// @brief Returns if file exists and matches key and source time
+    bool valid ();
+    /// @brief Returns buffer read from file, nullptr if not valid or corrupt
+    std::shared_ptr<Buffer> read (const std::string& dbo_name);
+    /// @brief Writes buffer to file through a unique temporary file, returns success
+    ///
+    /// Buffer must not be accessed concurrently, e.g. a partial copy owned by the writing thread.
+    bool write (Buffer& buffer);
+    /// @brief Removes least recently used cache files of the file's directory until at most max_bytes are used
+    void limitDirectory (size_t max_bytes);
+
+    const std::string& fileName () const { return file_name_; }
+
+private:
+    std::string file_name_;
+    std::string key_;
+    long long source_time_;
+
+    /// @brief Checks header at pos, advances pos, returns if matching
+    bool readHeader (const char*& pos, const char* end);
+
+    /// @brief Reads column of a buffer with size rows, returns false if corrupt
+    template <typename T> bool readColumn (const char*& pos, const char* end, uint64_t size,
+                                           NullableVector<T>& column);
+    template <typename T> void writeColumn (std::ofstream& file, NullableVector<T>& column);
+};
+
+#endif /* BUFFERCACHE_H_ */
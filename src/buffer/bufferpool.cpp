@@ -0,0 +1,59 @@
+/*
+ * This file is part of ATSDB.
+ *
+ * ATSDB is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * ATSDB is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with ATSDB.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include "bufferpool.h"
+#include "logger.h"
+
+BufferPool::BufferPool ()
+{
+}
+
+BufferPool::~BufferPool ()
+{
+    logdbg << "BufferPool: destructor: " << num_reuses_ << " of " << num_gets_ << " containers reused";
+}
+
+void BufferPool::clear ()
+{
+    std::lock_guard<std::mutex> lock (mutex_);
+    containers_.clear();
+}
+
+std::shared_ptr<void> BufferPool::take (std::type_index type)
+{
+    std::lock_guard<std::mutex> lock (mutex_);
+
+    ++num_gets_;
+
+    auto it = containers_.find(type);
+
+    if (it == containers_.end() || !it->second.size())
+        return nullptr;
+
+    ++num_reuses_;
+
+    std::shared_ptr<void> container = it->second.back();
+    it->second.pop_back();
+    return container;
+}
+
+void BufferPool::put (std::type_index type, std::shared_ptr<void> container)
+{
+    std::lock_guard<std::mutex> lock (mutex_);
+    containers_[type].push_back(container);
+}
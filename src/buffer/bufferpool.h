@@ -0,0 +1,91 @@
+/*
+ * This file is part of ATSDB.
+ *
+ * ATSDB is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * ATSDB is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with ATSDB.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef BUFFERPOOL_H_
+#define BUFFERPOOL_H_
+
+#include <map>
+#include <memory>
+#include <mutex>
+#include <typeindex>
+#include <vector>
+
+/**
+ * @brief Recycled column storage, scoped to one load or import run
+ *
+ * NullableVectors of Buffers created with a pool take their containers from it. Released containers are
+ * cleared and returned with their capacity, so consecutive chunks of a run reuse the same allocations instead
+ * of contending on the global allocator. Thread-safe, containers outliving the pool are freed normally.
+ */
+class BufferPool : public std::enable_shared_from_this<BufferPool>
+{
+public:
+    /// @brief Constructor
+    BufferPool ();
+    /// @brief Destructor
+    virtual ~BufferPool ();
+
+    /// @brief Returns empty container, recycled if available
+    template <typename T> std::shared_ptr<std::vector<T>> get ();
+
+    /// @brief Frees all recycled containers
+    void clear ();
+
+    /// @brief Returns number of containers handed out
+    size_t numGets () const { return num_gets_; }
+    /// @brief Returns number of containers handed out which were recycled
+    size_t numReuses () const { return num_reuses_; }
+
+private:
+    std::mutex mutex_;
+    /// Recycled containers per element type
+    std::map<std::type_index, std::vector<std::shared_ptr<void>>> containers_;
+
+    size_t num_gets_ {0};
+    size_t num_reuses_ {0};
+
+    /// @brief Returns recycled container of type, nullptr if none
+    std::shared_ptr<void> take (std::type_index type);
+    /// @brief Stores released container for reuse
+    void put (std::type_index type, std::shared_ptr<void> container);
+};
+
+template <typename T> std::shared_ptr<std::vector<T>> BufferPool::get ()
+{
+    std::shared_ptr<std::vector<T>> container =
+            std::static_pointer_cast<std::vector<T>> (take (typeid(std::vector<T>)));
+
+    if (!container)
+        container = std::make_shared<std::vector<T>>();
+
+    std::weak_ptr<BufferPool> pool = shared_from_this();
+
+    // handed out container returns its storage to the pool when released
+    return std::shared_ptr<std::vector<T>> (container.get(), [pool, container] (std::vector<T>* released)
+    {
+        std::shared_ptr<BufferPool> locked_pool = pool.lock();
+
+        if (locked_pool)
+        {
+            released->clear();
+            locked_pool->put(typeid(std::vector<T>), container);
+        }
+    });
+}
+
+#endif /* BUFFERPOOL_H_ */
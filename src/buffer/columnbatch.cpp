@@ -0,0 +1,153 @@
+/*
+ * This file is part of ATSDB.
+ *
+ * ATSDB is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * ATSDB is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with ATSDB.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include "columnbatch.h"
+
+namespace ColumnBatch
+{
+
+Selection select (const Bitmap& bitmap)
+{
+    Selection selection;
+
+    for (size_t word=0; word < bitmap.size(); ++word)
+    {
+        for (uint64_t bits = bitmap[word]; bits; bits &= bits - 1) // lowest set bit first
+            selection.push_back(word * 64 + __builtin_ctzll(bits));
+    }
+
+    return selection;
+}
+
+void intersect (Bitmap& bitmap, const Bitmap& other)
+{
+    if (bitmap.size() > other.size())
+        bitmap.resize(other.size());
+
+    for (size_t word=0; word < bitmap.size(); ++word)
+        bitmap[word] &= other[word];
+}
+
+void unite (Bitmap& bitmap, const Bitmap& other)
+{
+    if (bitmap.size() < other.size())
+        bitmap.resize(other.size(), 0);
+
+    for (size_t word=0; word < other.size(); ++word)
+        bitmap[word] |= other[word];
+}
+
+Bitmap compare (NullableVector<std::string>& column, size_t size, CompareOp op, const std::string& value)
+{
+    if (op != CompareOp::EQUAL && op != CompareOp::NOT_EQUAL) // codes are not ordered
+        return compare<std::string> (column, size, op, value);
+
+    Bitmap bitmap ((size + 63) / 64, 0);
+    size_t data_size = std::min(size, column.size());
+
+    if (!data_size)
+        return bitmap;
+
+    const uint32_t* codes = column.data();
+    const uint64_t* validity = column.validity();
+    uint32_t code;
+    bool exists = column.dictionary().find(value, code);
+    bool equal = op == CompareOp::EQUAL;
+
+    for (size_t index=0; index < data_size; ++index)
+    {
+        bool result = (exists && codes[index] == code) == equal;
+        bitmap[index / 64] |= uint64_t(result) << (index % 64);
+    }
+
+    if (validity) // mask out nulls, bitmap beyond data_size is clear
+    {
+        for (size_t word=0; word < (data_size + 63) / 64; ++word)
+            bitmap[word] &= validity[word];
+    }
+
+    return bitmap;
+}
+
+Selection sortPermutation (NullableVector<std::string>& column, size_t size, bool ascending)
+{
+    size_t data_size = column.size();
+    const uint32_t* codes = column.data();
+    const uint64_t* validity = column.validity();
+    const StringDictionary& dictionary = column.dictionary();
+
+    // rank of each code in value order
+    std::vector<uint32_t> sorted_codes (dictionary.size());
+
+    for (uint32_t code=0; code < sorted_codes.size(); ++code)
+        sorted_codes[code] = code;
+
+    std::sort(sorted_codes.begin(), sorted_codes.end(), [&dictionary] (uint32_t a, uint32_t b)
+    { return dictionary.value(a) < dictionary.value(b); });
+
+    std::vector<uint32_t> ranks (dictionary.size());
+
+    for (uint32_t rank=0; rank < sorted_codes.size(); ++rank)
+        ranks[sorted_codes[rank]] = ascending ? rank : sorted_codes.size() - 1 - rank;
+
+    Selection selection;
+    Selection nulls;
+    selection.reserve(size);
+
+    for (size_t index=0; index < size; ++index)
+    {
+        if (isValid(validity, data_size, index))
+            selection.push_back(index);
+        else
+            nulls.push_back(index);
+    }
+
+    std::stable_sort(selection.begin(), selection.end(), [&ranks, codes] (size_t a, size_t b)
+    { return ranks[codes[a]] < ranks[codes[b]]; });
+
+    selection.insert(selection.end(), nulls.begin(), nulls.end());
+    return selection;
+}
+
+/// @brief Gathers each container into the same-named container of a target buffer
+class GatherFunctor
+{
+public:
+    GatherFunctor (const Selection& selection, Buffer& target) : selection_(selection), target_(target) {}
+
+    template <typename T> void operator() (const std::string& name, NullableVector<T>& column)
+    {
+        gather (column, selection_, target_.get<T>(name));
+    }
+
+private:
+    const Selection& selection_;
+    Buffer& target_;
+};
+
+std::shared_ptr<Buffer> gather (Buffer& buffer, const Selection& selection)
+{
+    std::shared_ptr<Buffer> target {new Buffer (buffer.properties(), buffer.dboName())};
+
+    GatherFunctor functor (selection, *target);
+    buffer.forEachArrayList(functor);
+
+    return target;
+}
+
+}
@@ -0,0 +1,308 @@
+/*
+ * This file is part of ATSDB.
+ *
+ * ATSDB is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * ATSDB is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with ATSDB.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef COLUMNBATCH_H_
+#define COLUMNBATCH_H_
+
+#include <vector>
+#include <memory>
+#include <algorithm>
+#include <type_traits>
+
+#include "buffer.h"
+
+/**
+ * @brief Kernels over whole NullableVector columns
+ *
+ * Bitmaps use the packing of NullableVector::validity (bit set = selected), selections are ascending or
+ * permuted row indexes. Null elements never match a comparison, are skipped by aggregates and sorted last.
+ * Kernels producing one entry per row take the row count of the owning Buffer, rows beyond the stored data of a
+ * column (never set) are Null.
+ */
+namespace ColumnBatch
+{
+
+typedef std::vector<size_t> Selection;
+typedef std::vector<uint64_t> Bitmap;
+
+enum class CompareOp { EQUAL, NOT_EQUAL, LESS, LESS_EQUAL, GREATER, GREATER_EQUAL };
+
+/// @brief Element access by row, direct on contiguous storage where possible
+template <typename T> class ColumnValues
+{
+public:
+    ColumnValues (NullableVector<T>& column) : data_(column.data()) {}
+    T operator[] (size_t index) const { return data_[index]; }
+
+private:
+    const T* data_;
+};
+
+template <> class ColumnValues<bool>
+{
+public:
+    ColumnValues (NullableVector<bool>& column) : column_(column) {}
+    bool operator[] (size_t index) const { return column_.get(index); }
+
+private:
+    NullableVector<bool>& column_;
+};
+
+template <> class ColumnValues<std::string>
+{
+public:
+    ColumnValues (NullableVector<std::string>& column) : data_(column.data()), dictionary_(column.dictionary()) {}
+    const std::string& operator[] (size_t index) const { return dictionary_.value(data_[index]); }
+
+private:
+    const uint32_t* data_;
+    const StringDictionary& dictionary_;
+};
+
+/// @brief Returns if bit is set, false beyond bitmap
+inline bool isSet (const Bitmap& bitmap, size_t index)
+{
+    return index / 64 < bitmap.size() && (bitmap[index / 64] >> (index % 64)) & 1;
+}
+
+/// @brief Returns if row index is stored in a column of data_size elements and not Null
+inline bool isValid (const uint64_t* validity, size_t data_size, size_t index)
+{
+    return index < data_size && (!validity || (validity[index / 64] >> (index % 64)) & 1);
+}
+
+/// @brief Returns indexes of all set bits, ascending
+Selection select (const Bitmap& bitmap);
+/// @brief Sets bitmap to bitmap AND other
+void intersect (Bitmap& bitmap, const Bitmap& other);
+/// @brief Sets bitmap to bitmap OR other
+void unite (Bitmap& bitmap, const Bitmap& other);
+
+/// @brief Returns bitmap of size rows where element compared with value by op is true
+template <typename T> Bitmap compare (NullableVector<T>& column, size_t size, CompareOp op, const T& value)
+{
+    Bitmap bitmap ((size + 63) / 64, 0);
+    size_t data_size = std::min(size, column.size());
+
+    if (!data_size)
+        return bitmap;
+
+    ColumnValues<T> values (column);
+    const uint64_t* validity = column.validity();
+
+    for (size_t index=0; index < data_size; ++index)
+    {
+        if (!NullableVector<T>::isValid(validity, index)) // value undefined, get of Null throws for bool
+            continue;
+
+        bool result;
+
+        switch (op)
+        {
+        case CompareOp::EQUAL:
+            result = values[index] == value;
+            break;
+        case CompareOp::NOT_EQUAL:
+            result = values[index] != value;
+            break;
+        case CompareOp::LESS:
+            result = values[index] < value;
+            break;
+        case CompareOp::LESS_EQUAL:
+            result = values[index] <= value;
+            break;
+        case CompareOp::GREATER:
+            result = values[index] > value;
+            break;
+        default:
+            result = values[index] >= value;
+            break;
+        }
+
+        bitmap[index / 64] |= uint64_t(result) << (index % 64);
+    }
+
+    return bitmap;
+}
+
+/// @brief Equality on dictionary codes, other operations on values
+Bitmap compare (NullableVector<std::string>& column, size_t size, CompareOp op, const std::string& value);
+
+/// @brief Returns bitmap of size rows which are not Null
+template <typename T> Bitmap notNull (NullableVector<T>& column, size_t size)
+{
+    Bitmap bitmap ((size + 63) / 64, 0);
+    size_t data_size = std::min(size, column.size());
+    const uint64_t* validity = column.validity();
+
+    size_t words = data_size / 64;
+
+    if (validity)
+        std::copy (validity, validity + words, bitmap.begin());
+    else
+        std::fill (bitmap.begin(), bitmap.begin() + words, ~uint64_t(0));
+
+    if (data_size % 64) // stored rows of last word
+    {
+        uint64_t mask = (uint64_t(1) << (data_size % 64)) - 1;
+        bitmap[words] = (validity ? validity[words] : ~uint64_t(0)) & mask;
+    }
+
+    return bitmap;
+}
+
+/// @brief Appends rows of selection from source to target
+template <typename T> void gather (NullableVector<T>& source, const Selection& selection, NullableVector<T>& target)
+{
+    size_t count = selection.size();
+
+    if (!count)
+        return;
+
+    size_t data_size = source.size(); // selected rows beyond are Null
+    const uint64_t* source_validity = source.validity();
+    ColumnValues<T> source_values (source);
+
+    std::unique_ptr<T[]> values (new T[count]());
+    Bitmap validity ((count + 63) / 64, 0);
+    bool has_null = false;
+
+    for (size_t cnt=0; cnt < count; ++cnt)
+    {
+        size_t index = selection[cnt];
+
+        if (isValid(source_validity, data_size, index))
+        {
+            values[cnt] = source_values[index];
+            validity[cnt / 64] |= uint64_t(1) << (cnt % 64);
+        }
+        else
+            has_null = true;
+    }
+
+    target.append(values.get(), has_null ? validity.data() : nullptr, count);
+}
+
+/// @brief Sets target rows of selection to consecutive source rows
+template <typename T> void scatter (NullableVector<T>& source, const Selection& selection, NullableVector<T>& target)
+{
+    size_t size = source.size();
+    const uint64_t* source_validity = source.validity();
+    ColumnValues<T> source_values (source);
+
+    for (size_t cnt=0; cnt < selection.size(); ++cnt)
+    {
+        if (cnt < size && NullableVector<T>::isValid(source_validity, cnt))
+            target.set(selection[cnt], source_values[cnt]);
+        else
+            target.setNull(selection[cnt]);
+    }
+}
+
+/// @brief Sets min and max of not Null elements, returns false if there are none
+template <typename T> bool minMax (NullableVector<T>& column, T& min, T& max)
+{
+    size_t size = column.size();
+    const uint64_t* validity = column.validity();
+    ColumnValues<T> values (column);
+    bool found = false;
+
+    for (size_t index=0; index < size; ++index)
+    {
+        if (!NullableVector<T>::isValid(validity, index))
+            continue;
+
+        if (!found)
+        {
+            min = values[index];
+            max = values[index];
+            found = true;
+        }
+        else if (values[index] < min)
+            min = values[index];
+        else if (max < values[index])
+            max = values[index];
+    }
+
+    return found;
+}
+
+/// @brief Returns sum of not Null elements
+template <typename T> double sum (NullableVector<T>& column)
+{
+    static_assert (std::is_arithmetic<T>::value, "only defined for numbers");
+
+    size_t size = column.size();
+    const uint64_t* validity = column.validity();
+    ColumnValues<T> values (column);
+    double sum = 0;
+
+    if (!validity) // branch-free
+    {
+        for (size_t index=0; index < size; ++index)
+            sum += values[index];
+    }
+    else
+    {
+        for (size_t index=0; index < size; ++index)
+            if (NullableVector<T>::isValid(validity, index))
+                sum += values[index];
+    }
+
+    return sum;
+}
+
+/// @brief Returns stable permutation of size rows sorting the column, Null rows last
+template <typename T> Selection sortPermutation (NullableVector<T>& column, size_t size, bool ascending=true)
+{
+    size_t data_size = column.size();
+    const uint64_t* validity = column.validity();
+    ColumnValues<T> values (column);
+
+    Selection selection;
+    Selection nulls;
+    selection.reserve(size);
+
+    for (size_t index=0; index < size; ++index)
+    {
+        if (isValid(validity, data_size, index))
+            selection.push_back(index);
+        else
+            nulls.push_back(index);
+    }
+
+    if (ascending)
+        std::stable_sort(selection.begin(), selection.end(),
+                         [&values] (size_t a, size_t b) { return values[a] < values[b]; });
+    else
+        std::stable_sort(selection.begin(), selection.end(),
+                         [&values] (size_t a, size_t b) { return values[b] < values[a]; });
+
+    selection.insert(selection.end(), nulls.begin(), nulls.end());
+    return selection;
+}
+
+/// @brief Sorts strings on dictionary ranks, each distinct value compared once
+Selection sortPermutation (NullableVector<std::string>& column, size_t size, bool ascending=true);
+
+/// @brief Returns new buffer with rows of selection of all containers
+std::shared_ptr<Buffer> gather (Buffer& buffer, const Selection& selection);
+
+}
+
+#endif /* COLUMNBATCH_H_ */
@@ -15,6 +15,8 @@
  * along with ATSDB.  If not, see <http://www.gnu.org/licenses/>.
  */
 
+#include <limits>
+
 #include "nullablevector.h"
 
 template <>
@@ -22,7 +24,7 @@ NullableVector<bool>& NullableVector<bool>::operator*=(double factor)
 {
     bool tmp_factor = static_cast<bool> (factor);
 
-    for (auto data_it : data_)
+    for (auto data_it : mutableData())
         data_it = data_it && tmp_factor;
 
     return *this;
@@ -30,3 +32,87 @@ NullableVector<bool>& NullableVector<bool>::operator*=(double factor)
 
 
 
+template <>
+uint32_t NullableVector<std::string>::encode (const std::string& value)
+{
+    uint32_t code;
+
+    if (dictionary_->find(value, code))
+        return code;
+
+    return mutableDictionary().add(value);
+}
+
+template <>
+std::string NullableVector<std::string>::decode (uint32_t value) const
+{
+    return dictionary_->value(value);
+}
+
+template <>
+void NullableVector<std::string>::appendValues (std::vector<uint32_t>& data, const std::string* values, size_t count)
+{
+    for (size_t cnt=0; cnt < count; ++cnt)
+        data.push_back(encode(values[cnt]));
+}
+
+template <>
+void NullableVector<std::string>::appendData (const DataChunk& chunk)
+{
+    std::vector<uint32_t>& data = mutableData();
+    std::vector<uint32_t>::const_iterator chunk_begin = chunk.data_->begin() + chunk.data_offset_;
+
+    if (chunk.dictionary_ == dictionary_) // same codes
+    {
+        data.insert(data.end(), chunk_begin, chunk_begin + chunk.data_length_);
+    }
+    else // remap codes of chunk dictionary to mine
+    {
+        const uint32_t unmapped = std::numeric_limits<uint32_t>::max();
+        std::vector<uint32_t> codes (chunk.dictionary_->size(), unmapped);
+
+        for (std::vector<uint32_t>::const_iterator it = chunk_begin; it != chunk_begin + chunk.data_length_; ++it)
+        {
+            if (codes[*it] == unmapped)
+                codes[*it] = encode(chunk.dictionary_->value(*it));
+
+            data.push_back(codes[*it]);
+        }
+    }
+
+    data_length_ = data.size();
+}
+
+template <>
+std::map<std::string, std::vector<size_t>> NullableVector<std::string>::distinctValuesWithIndexes (size_t from_index,
+                                                                                                   size_t to_index)
+{
+    logdbg << "ArrayListTemplate " << property_.name() << ": distinctValuesWithIndexes";
+
+    compact();
+
+    std::map<std::string, std::vector<size_t>> values;
+
+    assert (from_index < to_index);
+
+    if (from_index+1 > data_length_) // no data
+        return values;
+
+    // group on codes, decode once per distinct value
+    std::vector<std::vector<size_t>> code_indexes (dictionary_->size());
+
+    for (size_t index = from_index; index <= to_index; ++index)
+    {
+        if (!isNull(index)) // not for null
+            code_indexes[(*data_)[data_offset_+index]].push_back(index);
+    }
+
+    for (uint32_t code=0; code < code_indexes.size(); ++code)
+    {
+        if (code_indexes[code].size())
+            values[dictionary_->value(code)] = std::move(code_indexes[code]);
+    }
+
+    logdbg << "ArrayListTemplate " << property_.name() << ": distinctValuesWithIndexes: done with " << values.size();
+    return values;
+}
@@ -26,14 +26,22 @@
 #include <array>
 #include <set>
 #include <map>
+#include <cstdint>
+#include <algorithm>
+#include <type_traits>
+#include <stdexcept>
 
 #include <QDateTime>
 
 #include "stringconv.h"
 #include "buffer.h"
 #include "property.h"
+#include "stringdictionary.h"
+#include "nullablevectorkernels.h"
 
-const bool BUFFER_PEDANTIC_CHECKING=false;
+/// @brief Stored element type of NullableVector, strings are stored as StringDictionary codes
+template <class T> struct NullableVectorStorage { typedef T type; };
+template <> struct NullableVectorStorage<std::string> { typedef uint32_t type; };
 
 /**
  * @brief Template List of fixed-size arrays to be used in Buffer classes.
@@ -44,8 +52,11 @@ template <class T>
 class NullableVector
 {
     friend class Buffer;
+    friend class BufferCache;
 
 public:
+    typedef typename NullableVectorStorage<T>::type StorageType;
+
     /// @brief Destructor
     virtual ~NullableVector () {}
 
@@ -66,12 +77,23 @@ public:
     /// @brief Sets specific element to Null value
     void setNull(size_t index);
 
+    /// @brief Reserves storage for size elements without changing the size
+    void reserve (size_t size);
+
+    /// @brief Appends count values after the last stored element, validity bitmap as in validity(), nullptr if all set
+    void append (const T* values, const uint64_t* validity, size_t count);
+
+    /// @brief Scales all not Null elements, runs of not all-Null validity words at once in NullableVectorKernels
     NullableVector<T>& operator*=(double factor);
 
     std::set<T> distinctValues (size_t index=0);
 
     std::map<T, std::vector<size_t>> distinctValuesWithIndexes (size_t from_index, size_t to_index);
 
+    /// @brief Converts all not Null elements from given format, e.g. "octal" digits stored as decimal number
+    ///
+    /// Octal digits are read as by std::stoi, std::invalid_argument is thrown if an element starts with a non-octal
+    /// digit. Elements before it may already be converted.
     void convertToStandardFormat(const std::string& from_format);
 
     size_t size();
@@ -81,22 +103,108 @@ public:
 
     void checkNotNull ();
 
+    /// @brief Returns pointer to contiguous data of size() elements, values of Null elements are undefined
+    ///
+    /// For strings these are the codes of dictionary(), usable for comparisons and grouping.
+    const StorageType* data ();
+
+    /// @brief Returns dictionary of string codes, only for strings
+    const StringDictionary& dictionary ();
+
+    /// @brief Returns packed validity bitmap (bit set = not Null) covering size() elements, nullptr if none is Null
+    const uint64_t* validity ();
+
+    /// @brief Returns if element is not Null in a bitmap returned by validity()
+    static bool isValid (const uint64_t* validity, size_t index)
+    {
+        return !validity || (validity[index / VALIDITY_WORD_BITS] >> (index % VALIDITY_WORD_BITS)) & 1;
+    }
+
+    static const size_t VALIDITY_WORD_BITS = 64;
 
 private:
     Property property_;
     Buffer& buffer_;
-    /// Data container
-    std::vector<T> data_;
-    // Null flags container
-    std::vector <bool> null_flags_;
+    /// Data container, shared copy-on-write with partial copies, views and seizing buffers
+    std::shared_ptr<std::vector<StorageType>> data_;
+    /// Index of first element in data_
+    size_t data_offset_ {0};
+    /// Number of stored elements
+    size_t data_length_ {0};
+    /// Packed validity bitmap, bit set = not Null, shared copy-on-write
+    std::shared_ptr<std::vector<uint64_t>> validity_;
+    /// Number of stored validity flags, elements beyond are not Null if data was set
+    size_t validity_size_ {0};
+    /// Codes of stored strings, shared copy-on-write, nullptr for other types
+    std::shared_ptr<StringDictionary> dictionary_;
+
+    /// Storage of a seized vector
+    struct DataChunk
+    {
+        std::shared_ptr<std::vector<StorageType>> data_;
+        size_t data_offset_;
+        size_t data_length_;
+        std::shared_ptr<std::vector<uint64_t>> validity_;
+        size_t validity_size_;
+        /// Buffer row of first element
+        size_t row_offset_;
+        std::shared_ptr<StringDictionary> dictionary_;
+    };
+
+    /// Seized chunks not yet appended to data_ and validity_
+    std::vector<DataChunk> pending_chunks_;
 
     /// @brief Sets specific element to not Null value
     void unsetNull (size_t index);
 
+    bool validBit (size_t index) const
+    {
+        return ((*validity_)[index / VALIDITY_WORD_BITS] >> (index % VALIDITY_WORD_BITS)) & 1;
+    }
+    void setValidBit (size_t index)
+    {
+        mutableValidity()[index / VALIDITY_WORD_BITS] |= uint64_t(1) << (index % VALIDITY_WORD_BITS);
+    }
+    void clearValidBit (size_t index)
+    {
+        mutableValidity()[index / VALIDITY_WORD_BITS] &= ~(uint64_t(1) << (index % VALIDITY_WORD_BITS));
+    }
+    /// @brief Returns if all elements of the validity word starting at block are Null
+    bool nullBlock (size_t block) const
+    {
+        return block + VALIDITY_WORD_BITS <= validity_size_ && !(*validity_)[block / VALIDITY_WORD_BITS];
+    }
+    /// @brief Sets validity flags in [from, to) to value, word-wise
+    void setValidityRange (size_t from, size_t to, bool valid);
+    /// @brief Appends count validity flags from packed words, starting at bit_offset, at validity_size_
+    void appendValidity (const uint64_t* words, size_t bit_offset, size_t count);
+
+    /// @brief Returns unshared data container holding exactly the stored elements, copies if shared or a view
+    std::vector<StorageType>& mutableData ();
+    /// @brief Returns unshared validity container, copies if shared
+    std::vector<uint64_t>& mutableValidity ();
+    /// @brief Returns unshared dictionary, copies if shared
+    StringDictionary& mutableDictionary ();
+    /// @brief Returns new empty container, from the buffer's pool if existing
+    template <typename S> std::shared_ptr<std::vector<S>> newStorage () const;
+
+    StorageType encode (const T& value) { return value; }
+    T decode (StorageType value) const { return value; }
+    /// @brief Appends encoded values to data
+    void appendValues (std::vector<StorageType>& data, const T* values, size_t count);
+
     void resizeDataTo (size_t size);
     void resizeNullTo (size_t size);
+    /// @brief Links storage of other as chunk to be appended, O(1)
     void addData (NullableVector<T>& other);
-    void copyData (NullableVector<T>& other);
+    /// @brief Appends all linked chunks into own storage, called before any access
+    void compact ();
+    void addChunk (const DataChunk& chunk);
+    void appendData (const DataChunk& chunk);
+    /// @brief Shares storage of other without copying, until either is written
+    void shareData (NullableVector<T>& other);
+    /// @brief Shares storage of rows [offset, offset+length) of other without copying
+    void shareData (NullableVector<T>& other, size_t offset, size_t length);
     void cutToSize (size_t size);
 
     /// @brief Constructor, only for friend Buffer
@@ -104,26 +212,47 @@ private:
 
 };
 
+template <>
+uint32_t NullableVector<std::string>::encode (const std::string& value);
+template <>
+std::string NullableVector<std::string>::decode (uint32_t value) const;
+template <>
+void NullableVector<std::string>::appendValues (std::vector<uint32_t>& data, const std::string* values, size_t count);
+template <>
+void NullableVector<std::string>::appendData (const DataChunk& chunk);
+template <>
+std::map<std::string, std::vector<size_t>> NullableVector<std::string>::distinctValuesWithIndexes (size_t from_index,
+                                                                                                   size_t to_index);
+
 
 template <class T> NullableVector<T>::NullableVector (Property& property, Buffer& buffer)
-    : property_(property), buffer_(buffer) {}
+    : property_(property), buffer_(buffer), data_(newStorage<StorageType>()), validity_(newStorage<uint64_t>()),
+      dictionary_(std::is_same<T, std::string>::value ? std::make_shared<StringDictionary>() : nullptr)
+{}
 
 template <class T> void NullableVector<T>::clear()
 {
     logdbg << "ArrayListTemplate " << property_.name() << ": clear";
-    std::fill (data_.begin(),data_.end(), T());
-    std::fill (null_flags_.begin(), null_flags_.end(), true);
+
+    compact();
+
+    std::vector<StorageType>& data = mutableData();
+    std::fill (data.begin(),data.end(), StorageType());
+    setValidityRange (0, validity_size_, false);
 }
 
 template <class T> const T NullableVector<T>::get (size_t index)
 {
     logdbg << "ArrayListTemplate " << property_.name() << ": get: index " << index;
+
+    compact();
+
     if (BUFFER_PEDANTIC_CHECKING)
     {
-        assert (data_.size() <= buffer_.data_size_);
-        assert (null_flags_.size() <= buffer_.data_size_);
-        assert (index < data_.size());
-        assert (index < data_.size());
+        assert (data_length_ <= buffer_.data_size_);
+        assert (validity_size_ <= buffer_.data_size_);
+        assert (index < data_length_);
+        assert (index < data_length_);
     }
 
     if (isNull(index))
@@ -137,7 +266,7 @@ template <class T> const T NullableVector<T>::get (size_t index)
         throw std::runtime_error ("ArrayListTemplate: get of Null value "+std::to_string(index));
     }
 
-    return data_.at(index);
+    return decode((*data_)[data_offset_+index]); // not null, so index < data_length_
 }
 
 template <class T> const std::string NullableVector<T>::getAsString (size_t index)
@@ -150,24 +279,27 @@ template <class T> void NullableVector<T>::set (size_t index, T value)
 {
     logdbg << "ArrayListTemplate " << property_.name() << ": set: index " << index << " value '" << value << "'";
 
+    compact();
+
     if (BUFFER_PEDANTIC_CHECKING)
     {
-        assert (data_.size() <= buffer_.data_size_);
-        assert (null_flags_.size() <= buffer_.data_size_);
+        assert (data_length_ <= buffer_.data_size_);
+        assert (validity_size_ <= buffer_.data_size_);
     }
 
-    if (index >= data_.size()) // allocate new stuff, fill all new with not null
+    if (index >= data_length_) // allocate new stuff, fill all new with not null
     {
-        if (index != data_.size()) // some where left out
+        if (index != data_length_) // some where left out
             resizeNullTo(index+1);
 
         resizeDataTo (index+1);
     }
 
     if (BUFFER_PEDANTIC_CHECKING)
-        assert (index < data_.size());
+        assert (index < data_length_);
 
-    data_.at(index) = value;
+    StorageType stored = encode(value);
+    mutableData()[index] = stored;
     unsetNull(index);
 
     //logdbg << "ArrayListTemplate: set: size " << size_ << " max_size " << max_size_;
@@ -212,19 +344,61 @@ template <class T> void NullableVector<T>::setNull(size_t index)
 {
     logdbg << "ArrayListTemplate " << property_.name() << ": setNull: index " << index;
 
+    compact();
+
     if (BUFFER_PEDANTIC_CHECKING)
     {
-        assert (data_.size() <= buffer_.data_size_);
-        assert (null_flags_.size() <= buffer_.data_size_);
+        assert (data_length_ <= buffer_.data_size_);
+        assert (validity_size_ <= buffer_.data_size_);
     }
 
-    if (index >= null_flags_.size()) // null flags to small
+    if (index >= validity_size_) // null flags to small
         resizeNullTo (index+1);
 
     if (BUFFER_PEDANTIC_CHECKING)
-        assert (index < null_flags_.size());
+        assert (index < validity_size_);
 
-    null_flags_.at(index) = true;
+    clearValidBit(index);
+}
+
+template <class T> void NullableVector<T>::reserve (size_t size)
+{
+    logdbg << "ArrayListTemplate " << property_.name() << ": reserve: size " << size;
+
+    compact();
+
+    mutableData().reserve(size);
+    mutableValidity().reserve((size + VALIDITY_WORD_BITS - 1) / VALIDITY_WORD_BITS);
+}
+
+template <class T> void NullableVector<T>::append (const T* values, const uint64_t* validity, size_t count)
+{
+    logdbg << "ArrayListTemplate " << property_.name() << ": append: count " << count;
+
+    compact();
+
+    if (!count)
+        return;
+
+    size_t offset = std::max(data_length_, validity_size_);
+
+    if (validity) // nulls given, store flags up to offset, then append
+    {
+        resizeNullTo(offset);
+        appendValidity(validity, 0, count);
+    }
+    // else all set, not null since data will be larger than stored flags
+
+    std::vector<StorageType>& data = mutableData();
+
+    if (data.size() < offset)
+        data.resize(offset, StorageType());
+
+    appendValues(data, values, count);
+    data_length_ = data.size();
+
+    if (buffer_.data_size_ < data_length_) // set new data size
+        buffer_.data_size_ = data_length_;
 }
 
 /// @brief Checks if specific element is Null
@@ -232,19 +406,21 @@ template <class T> bool NullableVector<T>::isNull(size_t index)
 {
     logdbg << "ArrayListTemplate " << property_.name() << ": isNull: index " << index;
 
+    compact();
+
     if (BUFFER_PEDANTIC_CHECKING)
     {
-        assert (data_.size() <= buffer_.data_size_);
-        assert (null_flags_.size() <= buffer_.data_size_);
+        assert (data_length_ <= buffer_.data_size_);
+        assert (validity_size_ <= buffer_.data_size_);
         assert (index < buffer_.data_size_);
     }
 
-    if (index < null_flags_.size()) // if stored, return value
-        return null_flags_.at(index);
+    if (index < validity_size_) // if stored, return value
+        return !validBit(index);
 
     // null not stored, so all set are not null
 
-    if (index >= data_.size()) // not yet set
+    if (index >= data_length_) // not yet set
         return true;
 
     // must be set
@@ -257,14 +433,15 @@ template <class T> void NullableVector<T>::resizeDataTo (size_t size)
 
     if (BUFFER_PEDANTIC_CHECKING)
     {
-        assert (data_.size() <= buffer_.data_size_);
-        assert (data_.size() < size); // only to be called if needed
+        assert (data_length_ <= buffer_.data_size_);
+        assert (data_length_ < size); // only to be called if needed
     }
 
-    data_.resize(size, T());
+    mutableData().resize(size, StorageType());
+    data_length_ = size;
 
-    if (buffer_.data_size_ < data_.size()) // set new data size
-        buffer_.data_size_ = data_.size();
+    if (buffer_.data_size_ < data_length_) // set new data size
+        buffer_.data_size_ = data_length_;
 }
 
 template <class T> void NullableVector<T>::resizeNullTo (size_t size)
@@ -272,104 +449,343 @@ template <class T> void NullableVector<T>::resizeNullTo (size_t size)
     logdbg << "ArrayListTemplate " << property_.name() << ": resizeNullTo: size " << size;
 
     if (BUFFER_PEDANTIC_CHECKING)
-        assert (null_flags_.size() <= buffer_.data_size_);
+        assert (validity_size_ <= buffer_.data_size_);
 
-    if (data_.size() > null_flags_.size()) // data was set w/o null, adjust & fill with set values
-        null_flags_.resize(data_.size(), false);
+    if (data_length_ > validity_size_) // data was set w/o null, adjust & fill with set values
+    {
+        setValidityRange(validity_size_, data_length_, true);
+        validity_size_ = data_length_;
+    }
 
-    if (null_flags_.size() < size) // adjust to new size, fill with null values
-        null_flags_.resize(size, true);
+    if (validity_size_ < size) // adjust to new size, fill with null values
+    {
+        setValidityRange(validity_size_, size, false);
+        validity_size_ = size;
+    }
 
-    if (buffer_.data_size_ < null_flags_.size()) // set new data size
-        buffer_.data_size_ = null_flags_.size();
+    if (buffer_.data_size_ < validity_size_) // set new data size
+        buffer_.data_size_ = validity_size_;
 
     if (BUFFER_PEDANTIC_CHECKING)
-        assert (size == null_flags_.size());
+        assert (size == validity_size_);
+}
+
+template <class T> void NullableVector<T>::setValidityRange (size_t from, size_t to, bool valid)
+{
+    if (from >= to)
+        return;
+
+    size_t num_words = (to + VALIDITY_WORD_BITS - 1) / VALIDITY_WORD_BITS;
+    std::vector<uint64_t>& validity = mutableValidity();
+
+    if (validity.size() < num_words)
+        validity.resize(num_words, 0);
+
+    size_t first_word = from / VALIDITY_WORD_BITS;
+    size_t last_word = (to - 1) / VALIDITY_WORD_BITS;
+    uint64_t first_mask = ~uint64_t(0) << (from % VALIDITY_WORD_BITS);
+    uint64_t last_mask = ~uint64_t(0) >> (VALIDITY_WORD_BITS - 1 - (to - 1) % VALIDITY_WORD_BITS);
+
+    if (first_word == last_word)
+        first_mask &= last_mask;
+
+    if (valid)
+        validity[first_word] |= first_mask;
+    else
+        validity[first_word] &= ~first_mask;
+
+    if (first_word == last_word)
+        return;
+
+    std::fill (validity.begin() + first_word + 1, validity.begin() + last_word, valid ? ~uint64_t(0) : 0);
+
+    if (valid)
+        validity[last_word] |= last_mask;
+    else
+        validity[last_word] &= ~last_mask;
+}
+
+template <class T> void NullableVector<T>::appendValidity (const uint64_t* words, size_t bit_offset, size_t count)
+{
+    size_t offset = validity_size_;
+
+    if (!count)
+        return;
+
+    setValidityRange(offset, offset + count, false); // allocates and clears target bits
+    std::vector<uint64_t>& validity = mutableValidity();
+
+    const uint64_t* src = words + bit_offset / VALIDITY_WORD_BITS;
+    size_t src_shift = bit_offset % VALIDITY_WORD_BITS;
+    size_t src_words_stored = (src_shift + count + VALIDITY_WORD_BITS - 1) / VALIDITY_WORD_BITS;
+
+    size_t shift = offset % VALIDITY_WORD_BITS;
+    size_t dst_word = offset / VALIDITY_WORD_BITS;
+    size_t src_words = (count + VALIDITY_WORD_BITS - 1) / VALIDITY_WORD_BITS;
+    uint64_t word;
+
+    for (size_t cnt=0; cnt < src_words; ++cnt)
+    {
+        word = src[cnt] >> src_shift;
+
+        if (src_shift && cnt+1 < src_words_stored)
+            word |= src[cnt+1] << (VALIDITY_WORD_BITS - src_shift);
+
+        if (cnt == src_words-1 && count % VALIDITY_WORD_BITS) // mask unused trailing bits
+            word &= ~uint64_t(0) >> (VALIDITY_WORD_BITS - count % VALIDITY_WORD_BITS);
+
+        validity[dst_word+cnt] |= word << shift;
+
+        if (shift && dst_word+cnt+1 < validity.size())
+            validity[dst_word+cnt+1] |= word >> (VALIDITY_WORD_BITS - shift);
+    }
+
+    validity_size_ = offset + count;
 }
 
 template <class T> void NullableVector<T>::addData (NullableVector<T>& other)
 {
     logdbg << "ArrayListTemplate " << property_.name() << ": addData";
 
+    other.compact();
+
+    if (pending_chunks_.empty() && !buffer_.data_size_ && !data_length_ && !validity_size_) // nothing here yet
+    {
+        logdbg << "ArrayListTemplate " << property_.name() << ": addData: sharing data";
+        data_ = other.data_;
+        data_offset_ = other.data_offset_;
+        data_length_ = other.data_length_;
+        validity_ = other.validity_;
+        validity_size_ = other.validity_size_;
+        dictionary_ = other.dictionary_;
+        return; // size is adjusted in Buffer::seizeBuffer
+    }
+
+    // linked in only, copied in compact when accessed, row offset is size before Buffer::seizeBuffer adjusts it
+    pending_chunks_.push_back(DataChunk {other.data_, other.data_offset_, other.data_length_, other.validity_,
+                                         other.validity_size_, buffer_.data_size_, other.dictionary_});
+}
+
+template <class T> void NullableVector<T>::compact ()
+{
+    if (pending_chunks_.empty())
+        return;
+
+    logdbg << "ArrayListTemplate " << property_.name() << ": compact: " << pending_chunks_.size() << " chunks";
+
+    // grow geometrically, compaction after each seized chunk must not copy the whole column again
+    const DataChunk& last_chunk = pending_chunks_.back();
+    size_t rows = last_chunk.row_offset_ + std::max(last_chunk.data_length_, last_chunk.validity_size_);
+    size_t words = (rows + VALIDITY_WORD_BITS - 1) / VALIDITY_WORD_BITS;
+
+    if (mutableData().capacity() < rows)
+        mutableData().reserve(std::max(rows, 2*mutableData().capacity()));
+
+    if (mutableValidity().capacity() < words)
+        mutableValidity().reserve(std::max(words, 2*mutableValidity().capacity()));
+
+    for (auto& chunk_it : pending_chunks_)
+        addChunk(chunk_it);
+
+    pending_chunks_.clear();
+}
+
+template <class T> void NullableVector<T>::addChunk (const DataChunk& chunk)
+{
+    logdbg << "ArrayListTemplate " << property_.name() << ": addChunk";
+
     if (BUFFER_PEDANTIC_CHECKING)
     {
-        assert (data_.size() <= buffer_.data_size_);
-        assert (null_flags_.size() <= buffer_.data_size_);
+        assert (data_length_ <= chunk.row_offset_);
+        assert (validity_size_ <= chunk.row_offset_);
     }
 
-    if (!other.data_.size() && other.null_flags_.size()) // if other has null flags set, need to fill my nulls
+    if (!chunk.data_length_ && chunk.validity_size_) // if chunk has null flags set, need to fill my nulls
     {
-        logdbg << "ArrayListTemplate " << property_.name() << ": addData: 1: other no data resizing null";
-        resizeNullTo (buffer_.data_size_);
-        logdbg << "ArrayListTemplate " << property_.name() << ": addData: 1: inserting null";
-        null_flags_.insert(null_flags_.end(), other.null_flags_.begin(), other.null_flags_.end());
+        logdbg << "ArrayListTemplate " << property_.name() << ": addChunk: 1: chunk no data resizing null";
+        resizeNullTo (chunk.row_offset_);
+        logdbg << "ArrayListTemplate " << property_.name() << ": addChunk: 1: inserting null";
+        appendValidity(chunk.validity_->data(), 0, chunk.validity_size_);
         goto DONE;
     }
 
-    if (other.data_.size() && !other.null_flags_.size()) // if other has everything set
+    if (chunk.data_length_ && !chunk.validity_size_) // if chunk has everything set
     {
-        logdbg << "ArrayListTemplate " << property_.name() << ": addData: 2: other has everything set";
+        logdbg << "ArrayListTemplate " << property_.name() << ": addChunk: 2: chunk has everything set";
 
-        if (data_.size() < buffer_.data_size_) // need to size data up
+        if (data_length_ < chunk.row_offset_) // need to size data up
         {
-            logdbg << "ArrayListTemplate " << property_.name() << ": addData: 2: data not full, setting null";
-            resizeNullTo (buffer_.data_size_);
+            logdbg << "ArrayListTemplate " << property_.name() << ": addChunk: 2: data not full, setting null";
+            resizeNullTo (chunk.row_offset_);
 
-            logdbg << "ArrayListTemplate " << property_.name() << ": addData: 2: resizing data";
-            resizeDataTo (buffer_.data_size_);
+            logdbg << "ArrayListTemplate " << property_.name() << ": addChunk: 2: resizing data";
+            resizeDataTo (chunk.row_offset_);
         }
 
-        logdbg << "ArrayListTemplate " << property_.name() << ": addData: 2: inserting data";
-        data_.insert(data_.end(), other.data_.begin(), other.data_.end());
+        logdbg << "ArrayListTemplate " << property_.name() << ": addChunk: 2: inserting data";
+        appendData(chunk);
         goto DONE;
     }
 
-    logdbg << "ArrayListTemplate " << property_.name() << ": addData: 3: mixture, both have data & nulls";
+    logdbg << "ArrayListTemplate " << property_.name() << ": addChunk: 3: mixture, both have data & nulls";
 
-    logdbg << "ArrayListTemplate " << property_.name() << ": addData: 3: resizing null to " << buffer_.data_size_;
-    resizeNullTo (buffer_.data_size_);
-    logdbg << "ArrayListTemplate " << property_.name() << ": addData: 3: inserting nulls";
-    null_flags_.insert(null_flags_.end(), other.null_flags_.begin(), other.null_flags_.end());
+    logdbg << "ArrayListTemplate " << property_.name() << ": addChunk: 3: resizing null to " << chunk.row_offset_;
+    resizeNullTo (chunk.row_offset_);
+    logdbg << "ArrayListTemplate " << property_.name() << ": addChunk: 3: inserting nulls";
+    appendValidity(chunk.validity_->data(), 0, chunk.validity_size_);
 
-    if (data_.size() < buffer_.data_size_) // need to size data up
+    if (data_length_ < chunk.row_offset_) // need to size data up
     {
-        logdbg << "ArrayListTemplate " << property_.name() << ": addData: 3: resizing data";
-        resizeDataTo (buffer_.data_size_);
+        logdbg << "ArrayListTemplate " << property_.name() << ": addChunk: 3: resizing data";
+        resizeDataTo (chunk.row_offset_);
     }
 
-    logdbg << "ArrayListTemplate " << property_.name() << ": addData: 3: inserting data";
-    data_.insert(data_.end(), other.data_.begin(), other.data_.end());
+    logdbg << "ArrayListTemplate " << property_.name() << ": addChunk: 3: inserting data";
+    appendData(chunk);
 
 DONE:
-    // size is adjusted in Buffer::seizeBuffer
+    logdbg << "ArrayListTemplate " << property_.name() << ": addChunk: end";
+}
 
-    logdbg << "ArrayListTemplate " << property_.name() << ": addData: end";
+template <class T> void NullableVector<T>::appendData (const DataChunk& chunk)
+{
+    std::vector<StorageType>& data = mutableData();
+    typename std::vector<StorageType>::const_iterator chunk_begin = chunk.data_->begin() + chunk.data_offset_;
+
+    data.insert(data.end(), chunk_begin, chunk_begin + chunk.data_length_);
+    data_length_ = data.size();
 }
 
-template <class T> void NullableVector<T>::copyData (NullableVector<T>& other)
+template <class T> void NullableVector<T>::shareData (NullableVector<T>& other)
 {
-    logdbg << "ArrayListTemplate " << property_.name() << ": copyData";
+    logdbg << "ArrayListTemplate " << property_.name() << ": shareData";
+
+    other.compact();
 
     data_ = other.data_;
-    null_flags_ = other.null_flags_;
+    data_offset_ = other.data_offset_;
+    data_length_ = other.data_length_;
+    validity_ = other.validity_;
+    validity_size_ = other.validity_size_;
+    dictionary_ = other.dictionary_;
 
     // is only done for new buffers in Buffer::getPartialCopy, so no size-too-big isse
 
-    if (buffer_.data_size_ < data_.size())
-        buffer_.data_size_ = data_.size();
+    if (buffer_.data_size_ < data_length_)
+        buffer_.data_size_ = data_length_;
+
+    if (buffer_.data_size_ < validity_size_)
+        buffer_.data_size_ = validity_size_;
+
+    logdbg << "ArrayListTemplate " << property_.name() << ": shareData: end";
+}
+
+template <class T> void NullableVector<T>::shareData (NullableVector<T>& other, size_t offset, size_t length)
+{
+    logdbg << "ArrayListTemplate " << property_.name() << ": shareData: offset " << offset << " length " << length;
+
+    other.compact();
+
+    data_ = other.data_;
+    data_offset_ = other.data_offset_ + std::min(offset, other.data_length_);
+    data_length_ = offset < other.data_length_ ? std::min(length, other.data_length_ - offset) : 0;
+    dictionary_ = other.dictionary_;
+
+    validity_ = newStorage<uint64_t>(); // only copy of bitmap range, to be word-aligned
+    validity_size_ = 0;
+
+    if (offset < other.validity_size_)
+        appendValidity(other.validity_->data(), offset, std::min(length, other.validity_size_ - offset));
+
+    // is only done for new buffers in Buffer::getView, so no size-too-big isse
+
+    if (buffer_.data_size_ < data_length_)
+        buffer_.data_size_ = data_length_;
+
+    if (buffer_.data_size_ < validity_size_)
+        buffer_.data_size_ = validity_size_;
+}
+
+template <class T> std::vector<typename NullableVector<T>::StorageType>& NullableVector<T>::mutableData ()
+{
+    if (data_.use_count() > 1 || data_offset_) // shared or view, copy own range
+    {
+        logdbg << "ArrayListTemplate " << property_.name() << ": mutableData: copying " << data_length_;
+
+        typename std::vector<StorageType>::const_iterator begin = data_->begin() + data_offset_;
+        std::shared_ptr<std::vector<StorageType>> data = newStorage<StorageType>();
+        data->assign (begin, begin + data_length_);
+        data_ = data;
+        data_offset_ = 0;
+    }
+    else if (data_->size() != data_length_) // was cut, drop remainder
+        data_->resize(data_length_);
+
+    return *data_;
+}
+
+template <class T> std::vector<uint64_t>& NullableVector<T>::mutableValidity ()
+{
+    if (validity_.use_count() > 1) // shared, copy
+    {
+        std::shared_ptr<std::vector<uint64_t>> validity = newStorage<uint64_t>();
+        *validity = *validity_;
+        validity_ = validity;
+    }
+
+    return *validity_;
+}
+
+template <class T> template <typename S> std::shared_ptr<std::vector<S>> NullableVector<T>::newStorage () const
+{
+    std::shared_ptr<BufferPool> pool = buffer_.pool_.lock();
+
+    if (pool)
+        return pool->get<S>();
+
+    return std::make_shared<std::vector<S>>();
+}
+
+template <class T> StringDictionary& NullableVector<T>::mutableDictionary ()
+{
+    assert (dictionary_);
+
+    if (dictionary_.use_count() > 1) // shared, copy
+        dictionary_ = std::make_shared<StringDictionary> (*dictionary_);
 
-    if (buffer_.data_size_ < null_flags_.size())
-        buffer_.data_size_ = null_flags_.size();
+    return *dictionary_;
+}
 
-    logdbg << "ArrayListTemplate " << property_.name() << ": copyData: end";
+template <class T> void NullableVector<T>::appendValues (std::vector<StorageType>& data, const T* values,
+                                                         size_t count)
+{
+    data.insert(data.end(), values, values+count);
 }
 
 template <class T> NullableVector<T>& NullableVector<T>::operator*=(double factor)
 {
     logdbg << "ArrayListTemplate " << property_.name() << ": operator*=";
 
-    for (auto &data_it : data_)
-        data_it *= factor;
+    compact();
+
+    std::vector<StorageType>& data = mutableData();
+    StorageType* values = data.data();
+    size_t data_size = data.size();
+
+    for (size_t block=0; block < data_size; block += VALIDITY_WORD_BITS)
+    {
+        if (nullBlock(block))
+            continue;
+
+        size_t run_begin = block; // Null values inside are undefined
+
+        while (block + VALIDITY_WORD_BITS < data_size && !nullBlock(block + VALIDITY_WORD_BITS))
+            block += VALIDITY_WORD_BITS;
+
+        size_t run_end = std::min(block + VALIDITY_WORD_BITS, data_size);
+
+        NullableVectorKernels::scale(values + run_begin, run_end - run_begin, factor);
+    }
 
     return *this;
 }
@@ -378,15 +794,17 @@ template <class T> std::set<T> NullableVector<T>::distinctValues (size_t index)
 {
     logdbg << "ArrayListTemplate " << property_.name() << ": distinctValues";
 
+    compact();
+
     std::set<T> values;
 
     T value;
 
-    for (; index < data_.size(); ++index)
+    for (; index < data_length_; ++index)
     {
         if (!isNull(index)) // not for null
         {
-            value = data_.at(index);
+            value = decode((*data_)[data_offset_+index]);
             if (values.count(value) == 0)
                 values.insert(value);
         }
@@ -400,6 +818,8 @@ template <class T> std::map<T, std::vector<size_t>> NullableVector<T>::distinctV
 {
     logdbg << "ArrayListTemplate " << property_.name() << ": distinctValuesWithIndexes";
 
+    compact();
+
     std::map<T, std::vector<size_t>> values;
 
     assert (from_index < to_index);
@@ -409,11 +829,11 @@ template <class T> std::map<T, std::vector<size_t>> NullableVector<T>::distinctV
         assert (to_index);
         assert (from_index < buffer_.data_size_);
         assert (to_index < buffer_.data_size_);
-        assert (data_.size() <= buffer_.data_size_);
-        assert (null_flags_.size() <= buffer_.data_size_);
+        assert (data_length_ <= buffer_.data_size_);
+        assert (validity_size_ <= buffer_.data_size_);
     }
 
-    if (from_index+1 > data_.size()) // no data
+    if (from_index+1 > data_length_) // no data
         return values;
 
     for (size_t index = from_index; index <= to_index; ++index)
@@ -421,9 +841,9 @@ template <class T> std::map<T, std::vector<size_t>> NullableVector<T>::distinctV
         if (!isNull(index)) // not for null
         {
             if (BUFFER_PEDANTIC_CHECKING)
-                assert (index < data_.size());
+                assert (index < data_length_);
 
-            values[data_.at(index)].push_back(index);
+            values[decode((*data_)[data_offset_+index])].push_back(index);
         }
     }
 
@@ -435,48 +855,68 @@ template <class T> void NullableVector<T>::convertToStandardFormat(const std::st
 {
     logdbg << "ArrayListTemplate " << property_.name() << ": convertToStandardFormat";
 
+    compact();
+
     static_assert (std::is_integral<T>::value, "only defined for integer types");
 
-    std::string value_str;
-    //T value;
+    if (from_format != "octal")
+    {
+        logerr << "ArrayListTemplate: convertToStandardFormat: unknown format '" << from_format << "'";
+        assert (false);
+        return;
+    }
+
+    std::vector<StorageType>& data = mutableData();
+    StorageType* values = data.data();
+    size_t data_size = data.size();
 
-    size_t data_size = data_.size();
-    for (size_t cnt=0; cnt < data_size; cnt++)
+    for (size_t block=0; block < data_size; block += VALIDITY_WORD_BITS)
     {
-        if (isNull(cnt))
+        if (nullBlock(block))
             continue;
 
-        value_str = std::to_string(data_.at(cnt));
+        size_t block_end = std::min(block + VALIDITY_WORD_BITS, data_size);
 
-        if (from_format == "octal")
-        {
-            data_.at(cnt) = std::stoi(value_str, 0, 8);
-        }
-        else
+        uint64_t invalid = NullableVectorKernels::decodeOctal(values + block, block_end - block);
+
+        if (!invalid)
+            continue;
+
+        for (size_t index=block; index < block_end; ++index) // only not Null elements are errors
         {
-            logerr << "ArrayListTemplate: convertToStandardFormat: unknown format '" << from_format << "'";
-            assert (false);
+            if ((invalid >> (index - block)) & 1 && !isNull(index))
+            {
+                logerr << "ArrayListTemplate " << property_.name() << ": convertToStandardFormat: index " << index
+                       << " has no octal digits";
+                throw std::invalid_argument ("ArrayListTemplate: convertToStandardFormat: no octal digits");
+            }
         }
     }
 }
 
-template <class T> size_t NullableVector<T>::size() { return data_.size(); }
+template <class T> size_t NullableVector<T>::size()
+{
+    compact();
+    return data_length_;
+}
 
 template <class T> void NullableVector<T>::cutToSize (size_t size)
 {
     logdbg << "ArrayListTemplate " << property_.name() << ": cutToSize: size " << size;
 
+    compact();
+
     if (BUFFER_PEDANTIC_CHECKING)
     {
-        assert (data_.size() <= buffer_.data_size_);
-        assert (null_flags_.size() <= buffer_.data_size_);
+        assert (data_length_ <= buffer_.data_size_);
+        assert (validity_size_ <= buffer_.data_size_);
     }
 
-    while (null_flags_.size() > size)
-        null_flags_.pop_back();
+    if (validity_size_ > size) // remaining flags are overwritten when growing again
+        validity_size_ = size;
 
-    while (data_.size() > size)
-        data_.pop_back();
+    if (data_length_ > size) // remainder dropped on next write
+        data_length_ = size;
 
     // size set in Buffer::cutToSize
 }
@@ -485,9 +925,11 @@ template <class T> void NullableVector<T>::checkNotNull ()
 {
     logdbg << "ArrayListTemplate " << property_.name() << ": checkNotNull";
 
-    for (size_t cnt=0; cnt < null_flags_.size(); cnt++)
+    compact();
+
+    for (size_t cnt=0; cnt < validity_size_; cnt++)
     {
-       if (null_flags_.at(cnt))
+       if (!validBit(cnt))
        {
            logerr << "cnt " << cnt << " null";
            assert (false);
@@ -504,14 +946,45 @@ template <class T> void NullableVector<T>::unsetNull (size_t index)
 
     if (BUFFER_PEDANTIC_CHECKING)
     {
-        assert (data_.size() <= buffer_.data_size_);
-        assert (null_flags_.size() <= buffer_.data_size_);
+        assert (data_length_ <= buffer_.data_size_);
+        assert (validity_size_ <= buffer_.data_size_);
         assert (index < buffer_.data_size_);
-        assert (index < data_.size());
+        assert (index < data_length_);
     }
 
-    if (index < null_flags_.size()) // if was already set
-        null_flags_.at(index) = false;
+    if (index < validity_size_) // if was already set
+        setValidBit(index);
+}
+
+template <class T> const typename NullableVector<T>::StorageType* NullableVector<T>::data ()
+{
+    static_assert (!std::is_same<T, bool>::value, "not defined for packed bool data");
+
+    compact();
+    return data_->data() + data_offset_;
+}
+
+template <class T> const StringDictionary& NullableVector<T>::dictionary ()
+{
+    static_assert (std::is_same<T, std::string>::value, "only defined for strings");
+
+    compact();
+    return *dictionary_;
+}
+
+template <class T> const uint64_t* NullableVector<T>::validity ()
+{
+    logdbg << "ArrayListTemplate " << property_.name() << ": validity";
+
+    compact();
+
+    if (!validity_size_) // nothing set null
+        return nullptr;
+
+    if (validity_size_ < data_length_) // set flags for data set w/o null
+        resizeNullTo(data_length_);
+
+    return validity_->data();
 }
 
 template <>
@@ -0,0 +1,160 @@
+/*
+ * This file is part of ATSDB.
+ *
+ * ATSDB is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * ATSDB is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with ATSDB.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include <cassert>
+#include <limits>
+#include <type_traits>
+
+#include "nullablevectorkernels.h"
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define NULLABLEVECTORKERNELS_AVX2
+#define KERNEL_INLINE inline __attribute__((always_inline))
+#else
+#define KERNEL_INLINE inline
+#endif
+
+namespace
+{
+
+template <typename T> KERNEL_INLINE void scaleLoop (T* values, size_t size, double factor)
+{
+    for (size_t index=0; index < size; ++index)
+        values[index] *= factor;
+}
+
+/// Quotient by 10 as multiply and shift, which vectorizes where a division does not
+KERNEL_INLINE uint32_t divide10 (uint32_t value)
+{
+    return (uint64_t(value) * 0xCCCCCCCDu) >> 35;
+}
+
+/// 64 bit quotient, not vectorized for lack of a wide multiply
+KERNEL_INLINE uint64_t divide10 (uint64_t value)
+{
+    return value / 10;
+}
+
+template <typename T> KERNEL_INLINE uint64_t decodeOctalLoop (T* values, size_t size)
+{
+    // digits are processed at least as 32 bit unsigned
+    typedef typename std::conditional<sizeof(T) <= sizeof(uint32_t), uint32_t, uint64_t>::type U;
+    const unsigned int digits = std::numeric_limits<T>::digits10 + 1;
+
+    uint8_t invalid[64];
+    uint8_t any_invalid = 0;
+
+    for (size_t index=0; index < size; ++index) // fixed digit count and selects, no branches
+    {
+        T value = values[index];
+        bool negative = value < T(0);
+        U decimal = negative ? U(0) - U(value) : U(value);
+        U octal = 0;
+        U scale = 1;
+        U reset = 0;
+
+#pragma GCC unroll 20
+        for (unsigned int digit_cnt=0; digit_cnt < digits; ++digit_cnt)
+        {
+            U quotient = divide10(decimal);
+            U digit = decimal - quotient * 10;
+            decimal = quotient;
+
+            U octal_digit = digit < 8; // less significant digits are not parsed
+            octal = octal_digit ? U(octal + digit * scale) : U(0);
+            scale = octal_digit ? U(scale * 8) : U(1);
+            reset |= octal_digit ^ 1;
+        }
+
+    values[index] = negative ? T(U(0) - octal) : T(octal);
+
+        invalid[index] = reset & (octal == 0); // no octal digit before the first non-octal one
+        any_invalid |= invalid[index];
+    }
+
+    if (!any_invalid)
+        return 0;
+
+    uint64_t mask = 0;
+
+    for (size_t index=0; index < size; ++index)
+        mask |= uint64_t(invalid[index]) << index;
+
+    return mask;
+}
+
+#ifdef NULLABLEVECTORKERNELS_AVX2
+template <typename T> __attribute__((target("avx2"))) void scaleAVX2 (T* values, size_t size, double factor)
+{
+    scaleLoop(values, size, factor);
+}
+
+template <typename T> __attribute__((target("avx2"))) uint64_t decodeOctalAVX2 (T* values, size_t size)
+{
+    return decodeOctalLoop(values, size);
+}
+
+bool hasAVX2 ()
+{
+    static const bool avx2 = __builtin_cpu_supports("avx2");
+    return avx2;
+}
+#endif
+
+}
+
+namespace NullableVectorKernels
+{
+
+template <typename T> void scale (T* values, size_t size, double factor)
+{
+#ifdef NULLABLEVECTORKERNELS_AVX2
+    if (hasAVX2())
+        return scaleAVX2(values, size, factor);
+#endif
+    scaleLoop(values, size, factor);
+}
+
+template <typename T> uint64_t decodeOctal (T* values, size_t size)
+{
+    assert (size <= 64);
+
+#ifdef NULLABLEVECTORKERNELS_AVX2
+    if (hasAVX2())
+        return decodeOctalAVX2(values, size);
+#endif
+    return decodeOctalLoop(values, size);
+}
+
+template void scale<char> (char*, size_t, double);
+template void scale<unsigned char> (unsigned char*, size_t, double);
+template void scale<int> (int*, size_t, double);
+template void scale<unsigned int> (unsigned int*, size_t, double);
+template void scale<long int> (long int*, size_t, double);
+template void scale<unsigned long> (unsigned long*, size_t, double);
+template void scale<float> (float*, size_t, double);
+template void scale<double> (double*, size_t, double);
+
+template uint64_t decodeOctal<char> (char*, size_t);
+template uint64_t decodeOctal<unsigned char> (unsigned char*, size_t);
+template uint64_t decodeOctal<int> (int*, size_t);
+template uint64_t decodeOctal<unsigned int> (unsigned int*, size_t);
+template uint64_t decodeOctal<long int> (long int*, size_t);
+template uint64_t decodeOctal<unsigned long> (unsigned long*, size_t);
+
+}
@@ -0,0 +1,44 @@
+/*
+ * This file is part of ATSDB.
+ *
+ * ATSDB is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * ATSDB is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with ATSDB.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef NULLABLEVECTORKERNELS_H_
+#define NULLABLEVECTORKERNELS_H_
+
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * @brief Element loops of NullableVector over contiguous storage
+ *
+ * Built optimised in all build types, with an AVX2 variant selected at runtime on x86 and a generic fallback.
+ * Defined for the numeric column types, Null elements are processed as well since their values are undefined.
+ */
+namespace NullableVectorKernels
+{
+
+/// @brief Multiplies size values by factor, converted back as by *=
+template <typename T> void scale (T* values, size_t size, double factor);
+
+/// @brief Replaces at most 64 values by their decimal digits read as octal, up to the first non-octal digit
+///
+/// Returns bitmask of values without a leading octal digit, which std::stoi rejects, these are set to 0.
+template <typename T> uint64_t decodeOctal (T* values, size_t size);
+
+}
+
+#endif /* NULLABLEVECTORKERNELS_H_ */
@@ -0,0 +1,53 @@
+/*
+ * This file is part of ATSDB.
+ *
+ * ATSDB is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * ATSDB is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with ATSDB.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <cassert>
+#include <limits>
+
+#include "stringdictionary.h"
+
+StringDictionary::StringDictionary ()
+{
+    add ("");
+}
+
+bool StringDictionary::find (const std::string& value, uint32_t& code) const
+{
+    auto it = codes_.find(value);
+
+    if (it == codes_.end())
+        return false;
+
+    code = it->second;
+    return true;
+}
+
+uint32_t StringDictionary::add (const std::string& value)
+{
+    auto it = codes_.find(value);
+
+    if (it != codes_.end())
+        return it->second;
+
+    assert (values_.size() < std::numeric_limits<uint32_t>::max());
+
+    uint32_t code = values_.size();
+    values_.push_back(value);
+    codes_[value] = code;
+
+    return code;
+}
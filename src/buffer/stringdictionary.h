@@ -0,0 +1,56 @@
+/*
+ * This file is part of ATSDB.
+ *
+ * ATSDB is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * ATSDB is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with ATSDB.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef STRINGDICTIONARY_H_
+#define STRINGDICTIONARY_H_
+
+#include <string>
+#include <vector>
+#include <unordered_map>
+#include <cstdint>
+
+/**
+ * @brief Pool of distinct strings with uint32 codes, used for dictionary-encoded string NullableVectors
+ *
+ * Code 0 is always the empty string, so default constructed codes decode to a default constructed string.
+ */
+class StringDictionary
+{
+public:
+    /// @brief Constructor, adds empty string as code 0
+    StringDictionary ();
+
+    /// @brief Returns if value is stored, sets code if so
+    bool find (const std::string& value, uint32_t& code) const;
+
+    /// @brief Returns code of value, adds it if not existing
+    uint32_t add (const std::string& value);
+
+    /// @brief Returns value of code
+    const std::string& value (uint32_t code) const { return values_[code]; }
+
+    /// @brief Returns number of distinct values
+    size_t size () const { return values_.size(); }
+
+private:
+    /// Values in order of code
+    std::vector<std::string> values_;
+    /// Value to code mapping
+    std::unordered_map<std::string, uint32_t> codes_;
+};
+
+#endif /* STRINGDICTIONARY_H_ */
@@ -18,8 +18,26 @@
 #ifndef DBCOMMAND_H_
 #define DBCOMMAND_H_
 
+#include <vector>
+
 #include "propertylist.h"
 
+/**
+ * @brief Value bound to a '?' placeholder of a DBCommand
+ *
+ * Data type is LONGINT, DOUBLE or STRING, value is held as string and converted when bound.
+ */
+struct DBCommandParameter
+{
+    DBCommandParameter (PropertyDataType data_type, const std::string &value)
+        : data_type_(data_type), value_(value) {}
+
+    PropertyDataType data_type_;
+    std::string value_;
+};
+
+using DBCommandParameters = std::vector<DBCommandParameter>;
+
 /**
  * @brief Encapsulation of a database SQL command
  *
@@ -47,6 +65,11 @@ public:
 	/// @brief Returns PropertyList of expected data.
     const PropertyList &resultList () const { return result_list_; }
 
+    /// @brief Sets values bound to the placeholders of the command string, in order
+    void parameters (const DBCommandParameters &parameters) { parameters_=parameters; }
+    /// @brief Returns values bound to the placeholders of the command string
+    const DBCommandParameters &parameters () const { return parameters_; }
+
 protected:
 	/// SQL Command
 	std::string command_;
@@ -54,6 +77,8 @@ protected:
 	bool expect_data_result_;
 	/// PropertyList of expected data
 	PropertyList result_list_;
+	/// Values bound to placeholders
+	DBCommandParameters parameters_;
 };
 
 using DBCommandVector = std::vector<DBCommand>;
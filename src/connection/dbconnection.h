@@ -19,6 +19,8 @@
 #define DBCONNECTION_H_
 
 #include <memory>
+#include <vector>
+#include <stdexcept>
 #include "configurable.h"
 
 #include <qobject.h>
@@ -27,7 +29,9 @@ class DBCommand;
 class DBCommandList;
 class DBResult;
 class DBConnectionInfo;
+class DBReader;
 class Buffer;
+class BufferPool;
 class DBTableInfo;
 class QWidget;
 
@@ -79,6 +83,16 @@ public:
   virtual void bindVariable (unsigned int index, const std::string &value)=0;
   /// @brief Bind a variable to the NULL value
   virtual void bindVariableNull (unsigned int index)=0;
+  /// @brief Returns maximum number of variables in one bound statement
+  virtual unsigned int maxBindVariables () const { return 999; }
+
+  /// @brief Returns if bulkLoad is supported
+  virtual bool supportsBulkLoad () const { return false; }
+  /// @brief Inserts all rows of buffer into existing table in one bulk operation, columns as buffer properties
+  virtual void bulkLoad (const std::string& table_name, Buffer& buffer)
+  {
+      throw std::runtime_error ("DBConnection: bulkLoad: not supported");
+  }
 
   /// @brief Executes a database query where data can be returned
   virtual std::shared_ptr <DBResult> execute (const DBCommand &command)=0;
@@ -87,13 +101,27 @@ public:
 
   /// @brief Prepare a database query for incremental data retrieval of the result
   virtual void prepareCommand (std::shared_ptr<DBCommand> command)=0;
-  /// @brief Step through a prepared query and return a number of results
-  virtual std::shared_ptr <DBResult> stepPreparedCommand (unsigned int max_results=0)=0;
+  /// @brief Step through a prepared query and return a number of results, buffer storage from pool if given
+  virtual std::shared_ptr <DBResult> stepPreparedCommand (unsigned int max_results=0,
+                                                          std::shared_ptr<BufferPool> buffer_pool=nullptr)=0;
   /// @brief Finalize the prepared query
   virtual void finalizeCommand ()=0;
   /// @brief Returns if all data from the prepared command was read
   virtual bool getPreparedCommandDone ()=0;
 
+  /// @brief Returns if prepared and concurrently read commands bind their parameters to '?' placeholders
+  virtual bool supportsParameters () const { return false; }
+
+  /// @brief Returns if createReader is supported
+  virtual bool supportsConcurrentRead () const { return false; }
+  /// @brief Returns reader of the commands on own read-only connections, concurrent to other readers
+  ///
+  /// Commands are read concurrently, results returned in their order. Commands must have the same result list.
+  virtual std::unique_ptr<DBReader> createReader (const std::vector<std::shared_ptr<DBCommand>>& commands)
+  {
+      throw std::runtime_error ("DBConnection: createReader: not supported");
+  }
+
   virtual std::map <std::string, DBTableInfo> getTableInfo ()=0;
   virtual std::vector <std::string> getDatabases()=0;
 
@@ -105,6 +133,10 @@ public:
   virtual std::string status () const=0;
   virtual std::string identifier () const=0;
   virtual std::string type () const=0;
+  /// @brief Returns last modification time of the database in ms since epoch, 0 if unknown
+  virtual long long modificationTime () const { return 0; }
+  /// @brief Switches to settings for bulk inserts (e.g. during imports) or back, nothing done by default
+  virtual void bulkMode (bool bulk) {}
 
   bool ready () { return connection_ready_; }
 
@@ -0,0 +1,42 @@
+/*
+ * This file is part of ATSDB.
+ *
+ * ATSDB is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * ATSDB is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with ATSDB.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef DBREADER_H_
+#define DBREADER_H_
+
+#include <memory>
+
+class Buffer;
+class BufferPool;
+
+/**
+ * @brief Incremental read of one or more commands on connections of its own
+ *
+ * Created by DBConnection::createReader, independent of the prepared command of the connection, so several
+ * readers can be used concurrently. Deleting the reader finalizes the read.
+ */
+class DBReader
+{
+public:
+    virtual ~DBReader() {}
+
+    /// @brief Returns next buffer of at most chunk_size rows, storage from buffer_pool if given, last one is flagged
+    virtual std::shared_ptr<Buffer> next (unsigned int chunk_size, std::shared_ptr<BufferPool> buffer_pool)=0;
+};
+
+#endif /* DBREADER_H_ */
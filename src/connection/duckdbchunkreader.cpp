@@ -0,0 +1,229 @@
+/*
+ * This file is part of ATSDB.
+ *
+ * ATSDB is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * ATSDB is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with ATSDB.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "duckdbchunkreader.h"
+#include "property.h"
+#include "logger.h"
+
+namespace
+{
+
+/// @brief Returns validity of rows [offset, offset+count) of vector starting at bit 0, nullptr if none is Null
+///
+/// Points into the vector if offset is word aligned, otherwise the flags are shifted into staging.
+const uint64_t* chunkValidity (duckdb_vector vector, size_t offset, size_t count, std::vector<uint64_t>& staging)
+{
+    const size_t word_bits = NullableVector<int>::VALIDITY_WORD_BITS;
+
+    uint64_t* validity = duckdb_vector_get_validity(vector);
+
+    if (!validity)
+        return nullptr;
+
+    if (offset % word_bits == 0)
+        return validity + offset / word_bits;
+
+    staging.assign((count + word_bits - 1) / word_bits, 0);
+
+    for (size_t row=0; row < count; ++row)
+        if (duckdb_validity_row_is_valid(validity, offset+row))
+            staging[row / word_bits] |= uint64_t(1) << (row % word_bits);
+
+    return staging.data();
+}
+
+/// @brief Reads vectors of storage type S into containers of type T
+template <typename T, typename S> class TypedColumnReader : public DuckDBChunkReader::ColumnReader
+{
+public:
+    TypedColumnReader (ColumnHandle<T> handle)
+        : handle_(handle), values_(new T[duckdb_vector_size()]()) {}
+
+    virtual void read (duckdb_vector vector, size_t offset, size_t count, Buffer& buffer)
+    {
+        const S* data = static_cast<const S*> (duckdb_vector_get_data(vector)) + offset;
+
+        buffer.get<T>(handle_).append(values(data, count), chunkValidity(vector, offset, count, validity_), count);
+    }
+
+private:
+    ColumnHandle<T> handle_;
+    /// Converted values of one chunk
+    std::unique_ptr<T[]> values_;
+    std::vector<uint64_t> validity_;
+
+    /// @brief Same type, appended from the vector
+    const T* values (const T* data, size_t count) { return data; }
+
+    template <typename U> const T* values (const U* data, size_t count)
+    {
+        for (size_t cnt=0; cnt < count; ++cnt)
+            values_[cnt] = static_cast<T> (data[cnt]);
+
+        return values_.get();
+    }
+};
+
+/// @brief Reads VARCHAR vectors into string containers
+class StringColumnReader : public DuckDBChunkReader::ColumnReader
+{
+public:
+    StringColumnReader (ColumnHandle<std::string> handle)
+        : handle_(handle), values_(duckdb_vector_size()) {}
+
+    virtual void read (duckdb_vector vector, size_t offset, size_t count, Buffer& buffer)
+    {
+        duckdb_string_t* data = static_cast<duckdb_string_t*> (duckdb_vector_get_data(vector)) + offset;
+        const uint64_t* validity = chunkValidity(vector, offset, count, validity_);
+
+        for (size_t cnt=0; cnt < count; ++cnt)
+        {
+            if (NullableVector<std::string>::isValid(validity, cnt)) // Null entries are undefined
+                values_[cnt].assign(duckdb_string_t_data(&data[cnt]), duckdb_string_t_length(data[cnt]));
+            else
+                values_[cnt].clear();
+        }
+
+        buffer.get<std::string>(handle_).append(values_.data(), validity, count);
+    }
+
+private:
+    ColumnHandle<std::string> handle_;
+    /// Staged strings of one chunk, keep their capacity
+    std::vector<std::string> values_;
+    std::vector<uint64_t> validity_;
+};
+
+template <typename T, typename S> std::unique_ptr<DuckDBChunkReader::ColumnReader> typedReader (ColumnHandle<T> handle)
+{
+    return std::unique_ptr<DuckDBChunkReader::ColumnReader> (new TypedColumnReader<T, S> (handle));
+}
+
+template <typename T> std::unique_ptr<DuckDBChunkReader::ColumnReader> createReader (
+        Buffer& buffer, const std::string& name, duckdb_type type)
+{
+    ColumnHandle<T> handle = buffer.handle<T>(name);
+
+    switch (type)
+    {
+    case DUCKDB_TYPE_BOOLEAN:
+        return typedReader<T, bool>(handle);
+    case DUCKDB_TYPE_TINYINT:
+        return typedReader<T, int8_t>(handle);
+    case DUCKDB_TYPE_SMALLINT:
+        return typedReader<T, int16_t>(handle);
+    case DUCKDB_TYPE_INTEGER:
+        return typedReader<T, int32_t>(handle);
+    case DUCKDB_TYPE_BIGINT:
+        return typedReader<T, int64_t>(handle);
+    case DUCKDB_TYPE_UTINYINT:
+        return typedReader<T, uint8_t>(handle);
+    case DUCKDB_TYPE_USMALLINT:
+        return typedReader<T, uint16_t>(handle);
+    case DUCKDB_TYPE_UINTEGER:
+        return typedReader<T, uint32_t>(handle);
+    case DUCKDB_TYPE_UBIGINT:
+        return typedReader<T, uint64_t>(handle);
+    case DUCKDB_TYPE_FLOAT:
+        return typedReader<T, float>(handle);
+    case DUCKDB_TYPE_DOUBLE:
+        return typedReader<T, double>(handle);
+    default:
+        logerr << "DuckDBChunkReader: createReader: unsupported column type " << type << " for " << name;
+        throw std::runtime_error ("DuckDBChunkReader: createReader: unsupported column type for "+name);
+    }
+}
+
+template <> std::unique_ptr<DuckDBChunkReader::ColumnReader> createReader<std::string> (
+        Buffer& buffer, const std::string& name, duckdb_type type)
+{
+    if (type != DUCKDB_TYPE_VARCHAR)
+    {
+        logerr << "DuckDBChunkReader: createReader: unsupported column type " << type << " for string " << name;
+        throw std::runtime_error ("DuckDBChunkReader: createReader: unsupported column type for string "+name);
+    }
+
+    return std::unique_ptr<DuckDBChunkReader::ColumnReader> (
+                new StringColumnReader (buffer.handle<std::string>(name)));
+}
+
+}
+
+DuckDBChunkReader::DuckDBChunkReader (duckdb_result* result, Buffer& buffer)
+{
+    assert (result);
+
+    const PropertyList& list = buffer.properties();
+    assert (duckdb_column_count(result) >= list.size());
+
+    for (unsigned int cnt=0; cnt < list.size(); ++cnt)
+    {
+        const Property& property = list.at(cnt);
+        duckdb_type type = duckdb_column_type(result, cnt);
+
+        switch (property.dataType())
+        {
+        case PropertyDataType::BOOL:
+            readers_.push_back(createReader<bool>(buffer, property.name(), type));
+            break;
+        case PropertyDataType::CHAR:
+            readers_.push_back(createReader<char>(buffer, property.name(), type));
+            break;
+        case PropertyDataType::UCHAR:
+            readers_.push_back(createReader<unsigned char>(buffer, property.name(), type));
+            break;
+        case PropertyDataType::INT:
+            readers_.push_back(createReader<int>(buffer, property.name(), type));
+            break;
+        case PropertyDataType::UINT:
+            readers_.push_back(createReader<unsigned int>(buffer, property.name(), type));
+            break;
+        case PropertyDataType::LONGINT:
+            readers_.push_back(createReader<long int>(buffer, property.name(), type));
+            break;
+        case PropertyDataType::ULONGINT:
+            readers_.push_back(createReader<unsigned long int>(buffer, property.name(), type));
+            break;
+        case PropertyDataType::FLOAT:
+            readers_.push_back(createReader<float>(buffer, property.name(), type));
+            break;
+        case PropertyDataType::DOUBLE:
+            readers_.push_back(createReader<double>(buffer, property.name(), type));
+            break;
+        case PropertyDataType::STRING:
+            readers_.push_back(createReader<std::string>(buffer, property.name(), type));
+            break;
+        default:
+            logerr  <<  "DuckDBChunkReader: constructor: unknown property type "
+                     << Property::asString(property.dataType());
+            throw std::runtime_error ("DuckDBChunkReader: constructor: unknown property type "
+                                      +Property::asString(property.dataType()));
+        }
+    }
+}
+
+void DuckDBChunkReader::read (duckdb_data_chunk chunk, size_t offset, size_t count, Buffer& buffer)
+{
+    assert (chunk);
+    assert (offset+count <= duckdb_data_chunk_get_size(chunk));
+
+    if (!count)
+        return;
+
+    for (unsigned int cnt=0; cnt < readers_.size(); ++cnt)
+        readers_[cnt]->read(duckdb_data_chunk_get_vector(chunk, cnt), offset, count, buffer);
+}
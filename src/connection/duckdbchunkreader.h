@@ -0,0 +1,57 @@
+/*
+ * This file is part of ATSDB.
+ *
+ * ATSDB is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * ATSDB is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with ATSDB.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef DUCKDBCHUNKREADER_H_
+#define DUCKDBCHUNKREADER_H_
+
+#include <duckdb.h>
+#include <memory>
+#include <vector>
+
+#include "buffer.h"
+
+/**
+ * @brief Appends data chunks of a DuckDB result to a Buffer column by column
+ *
+ * Resolves a ColumnHandle and a typed reader per result column once. Column vectors of the same type as the
+ * container are appended directly together with their validity bitmap, which has the layout of
+ * NullableVector::validity(), others are converted in one pass per chunk. Usable for all buffers created from
+ * the PropertyList of the first one.
+ */
+class DuckDBChunkReader
+{
+public:
+    /// @brief Constructor, result column types are matched to the buffer properties by position
+    DuckDBChunkReader (duckdb_result* result, Buffer& buffer);
+
+    /// @brief Appends rows [offset, offset+count) of chunk to buffer
+    void read (duckdb_data_chunk chunk, size_t offset, size_t count, Buffer& buffer);
+
+    /// @brief Reader of one result column
+    class ColumnReader
+    {
+    public:
+        virtual ~ColumnReader() {}
+
+        virtual void read (duckdb_vector vector, size_t offset, size_t count, Buffer& buffer) = 0;
+    };
+
+private:
+    std::vector<std::unique_ptr<ColumnReader>> readers_;
+};
+
+#endif /* DUCKDBCHUNKREADER_H_ */
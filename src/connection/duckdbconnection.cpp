@@ -0,0 +1,858 @@
+/*
+ * This file is part of ATSDB.
+ *
+ * ATSDB is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * ATSDB is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with ATSDB.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <algorithm>
+#include <limits>
+
+#include <QFileInfo>
+#include <QDateTime>
+
+#include "property.h"
+#include "buffer.h"
+#include "dbcommand.h"
+#include "dbcommandlist.h"
+#include "dbresult.h"
+#include "logger.h"
+#include "sqlitefile.h"
+#include "duckdbconnection.h"
+#include "duckdbchunkreader.h"
+#include "duckdbconnectionwidget.h"
+#include "duckdbconnectioninfowidget.h"
+#include "dbinterface.h"
+#include "dbtableinfo.h"
+
+namespace
+{
+
+/// Table the rows of a bulk load are appended to before being inserted with their column list
+const std::string BULK_LOAD_TABLE = "atsdb_bulk_load";
+
+inline duckdb_state appendValue (duckdb_appender appender, bool value) { return duckdb_append_bool(appender, value); }
+inline duckdb_state appendValue (duckdb_appender appender, char value) { return duckdb_append_int8(appender, value); }
+inline duckdb_state appendValue (duckdb_appender appender, unsigned char value)
+{
+    return duckdb_append_uint8(appender, value);
+}
+inline duckdb_state appendValue (duckdb_appender appender, int value) { return duckdb_append_int32(appender, value); }
+inline duckdb_state appendValue (duckdb_appender appender, unsigned int value)
+{
+    return duckdb_append_uint32(appender, value);
+}
+inline duckdb_state appendValue (duckdb_appender appender, long int value)
+{
+    return duckdb_append_int64(appender, value);
+}
+inline duckdb_state appendValue (duckdb_appender appender, unsigned long int value)
+{
+    return duckdb_append_uint64(appender, value);
+}
+inline duckdb_state appendValue (duckdb_appender appender, float value) { return duckdb_append_float(appender, value); }
+inline duckdb_state appendValue (duckdb_appender appender, double value)
+{
+    return duckdb_append_double(appender, value);
+}
+inline duckdb_state appendValue (duckdb_appender appender, const std::string& value)
+{
+    return duckdb_append_varchar_length(appender, value.c_str(), value.size());
+}
+
+/// @brief Appends the cells of one buffer column to the current appender row
+class ColumnAppender
+{
+public:
+    virtual ~ColumnAppender() {}
+
+    virtual duckdb_state append (duckdb_appender appender, size_t row) = 0;
+};
+
+template <typename T> class TypedColumnAppender : public ColumnAppender
+{
+public:
+    TypedColumnAppender (NullableVector<T>& values) : values_(values) {}
+
+    virtual duckdb_state append (duckdb_appender appender, size_t row)
+    {
+        if (values_.isNull(row))
+            return duckdb_append_null(appender);
+
+        return appendValue(appender, values_.get(row));
+    }
+
+private:
+    NullableVector<T>& values_;
+};
+
+template <typename T> std::unique_ptr<ColumnAppender> createAppender (Buffer& buffer, const std::string& name)
+{
+    return std::unique_ptr<ColumnAppender> (new TypedColumnAppender<T> (buffer.get<T>(name)));
+}
+
+/// @brief Returns data type as used by the schema for a DuckDB type name, unknown names unchanged
+std::string schemaDataType (const std::string& duckdb_type)
+{
+    static const std::map<std::string, std::string> data_types {
+        {"BOOLEAN", "BOOL"}, {"TINYINT", "CHAR"}, {"UTINYINT", "UCHAR"}, {"SMALLINT", "INT"}, {"INTEGER", "INT"},
+        {"UINTEGER", "UINT"}, {"BIGINT", "LONGINT"}, {"UBIGINT", "ULONGINT"}, {"FLOAT", "FLOAT"},
+        {"DOUBLE", "DOUBLE"}, {"VARCHAR", "STRING"}};
+
+    auto it = data_types.find(duckdb_type);
+
+    return it != data_types.end() ? it->second : duckdb_type;
+}
+
+}
+
+DuckDBConnection::DuckDBConnection(const std::string &class_id, const std::string &instance_id,
+                                   DBInterface *interface)
+: DBConnection (class_id, instance_id, interface), interface_(*interface)
+{
+    registerParameter("last_filename", &last_filename_, "");
+
+    registerParameter("threads", &threads_, 0);
+    registerParameter("memory_limit_mb", &memory_limit_mb_, 0);
+
+    createSubConfigurables();
+}
+
+DuckDBConnection::~DuckDBConnection()
+{
+    assert (!db_handle_);
+
+    for (auto it : file_list_)
+        delete it.second;
+
+    file_list_.clear();
+}
+
+void DuckDBConnection::openFile (const std::string &file_name)
+{
+    loginf << "DuckDBConnection: openFile: " << file_name << " threads " << threads_
+           << " memory limit " << memory_limit_mb_ << " MiB";
+
+    last_filename_=file_name;
+    assert (last_filename_.size() > 0);
+
+    duckdb_config config;
+
+    if (duckdb_create_config(&config) != DuckDBSuccess)
+        throw std::runtime_error ("DuckDBConnection: openFile: unable to create config");
+
+    if (threads_)
+        duckdb_set_config(config, "threads", std::to_string(threads_).c_str());
+
+    if (memory_limit_mb_)
+        duckdb_set_config(config, "memory_limit", (std::to_string(memory_limit_mb_)+"MB").c_str());
+
+    char* error = nullptr;
+    duckdb_state state = duckdb_open_ext(last_filename_.c_str(), &db_handle_, config, &error);
+    duckdb_destroy_config(&config);
+
+    if (state != DuckDBSuccess)
+    {
+        std::string message = error ? error : "";
+        duckdb_free(error);
+        db_handle_ = nullptr;
+
+        logerr  <<  "DuckDBConnection: openFile: error " << message;
+        throw std::runtime_error ("DuckDBConnection: openFile: error "+message);
+    }
+
+    if (duckdb_connect(db_handle_, &connection_handle_) != DuckDBSuccess)
+    {
+        duckdb_close(&db_handle_);
+        db_handle_ = nullptr;
+
+        logerr  <<  "DuckDBConnection: openFile: connect failed";
+        throw std::runtime_error ("DuckDBConnection: openFile: connect failed");
+    }
+
+    connection_ready_ = true;
+
+    interface_.databaseContentChanged();
+
+    emit connectedSignal();
+}
+
+void DuckDBConnection::disconnect()
+{
+    loginf << "DuckDBConnection: disconnect";
+
+    connection_ready_ = false;
+
+    if (widget_)
+    {
+        delete widget_;
+        widget_ = nullptr;
+    }
+
+    if (info_widget_)
+    {
+        delete info_widget_;
+        info_widget_ = nullptr;
+    }
+
+    if (prepared_command_)
+        finalizeCommand();
+
+    if (db_handle_)
+    {
+        clearBindStatements();
+        duckdb_disconnect(&connection_handle_);
+        duckdb_close(&db_handle_);
+        connection_handle_ = nullptr;
+        db_handle_ = nullptr;
+    }
+}
+
+void DuckDBConnection::query (const std::string &sql, duckdb_result &result)
+{
+    if (duckdb_query(connection_handle_, sql.c_str(), &result) != DuckDBSuccess)
+    {
+        std::string error = duckdb_result_error(&result) ? duckdb_result_error(&result) : "";
+        duckdb_destroy_result(&result);
+
+        logerr  << "DuckDBConnection: query: '" << sql << "' failed: " << error;
+        throw std::runtime_error ("DuckDBConnection: query: failed: "+error);
+    }
+}
+
+void DuckDBConnection::executeSQL(const std::string &sql)
+{
+    logdbg  << "DuckDBConnection: executeSQL: sql statement execute: '" <<sql << "'";
+
+    duckdb_result result;
+    query (sql, result); // several statements allowed
+    duckdb_destroy_result(&result);
+}
+
+void DuckDBConnection::prepareBindStatement (const std::string &statement)
+{
+    auto it = bind_statements_.find(statement);
+
+    if (it != bind_statements_.end()) // cleared by finalizeBindStatement
+    {
+        statement_ = it->second;
+        return;
+    }
+
+    if (bind_statements_.size() >= MAX_BIND_STATEMENTS)
+        clearBindStatements();
+
+    if (duckdb_prepare(connection_handle_, statement.c_str(), &statement_) != DuckDBSuccess)
+    {
+        logerr  << "DuckDBConnection: prepareBindStatement: error preparing bind: "
+                << duckdb_prepare_error(statement_);
+        duckdb_destroy_prepare(&statement_);
+        statement_ = nullptr;
+        return;
+    }
+
+    bind_statements_[statement] = statement_;
+}
+
+void DuckDBConnection::beginBindTransaction ()
+{
+    executeSQL("BEGIN TRANSACTION");
+}
+
+void DuckDBConnection::stepAndClearBindings ()
+{
+    logdbg  << "DuckDBConnection: stepAndClearBindings: executing statement";
+    assert (statement_);
+
+    duckdb_result result;
+
+    if (duckdb_execute_prepared(statement_, &result) != DuckDBSuccess)
+    {
+        std::string error = duckdb_result_error(&result) ? duckdb_result_error(&result) : "";
+        duckdb_destroy_result(&result);
+
+        logerr  << "DuckDBConnection: stepAndClearBindings: error while bind: " << error;
+        throw std::runtime_error ("DuckDBConnection: stepAndClearBindings: error while bind: "+error);
+    }
+
+    duckdb_destroy_result(&result);
+    duckdb_clear_bindings(statement_);
+}
+
+void DuckDBConnection::endBindTransaction ()
+{
+    executeSQL("COMMIT");
+}
+
+void DuckDBConnection::finalizeBindStatement ()
+{
+    // kept in bind_statements_
+    if (statement_)
+        duckdb_clear_bindings(statement_);
+}
+
+void DuckDBConnection::clearBindStatements ()
+{
+    logdbg  << "DuckDBConnection: clearBindStatements: " << bind_statements_.size();
+
+    for (auto& it : bind_statements_)
+        duckdb_destroy_prepare(&it.second);
+
+    bind_statements_.clear();
+    statement_ = nullptr;
+}
+
+void DuckDBConnection::bindVariable (unsigned int index, int value)
+{
+    logdbg  << "DuckDBConnection: bindVariable: index " << index << " value '" << value << "'";
+    duckdb_bind_int32(statement_, index, value);
+}
+void DuckDBConnection::bindVariable (unsigned int index, double value)
+{
+    logdbg  << "DuckDBConnection: bindVariable: index " << index << " value '" << value << "'";
+    duckdb_bind_double(statement_, index, value);
+}
+void DuckDBConnection::bindVariable (unsigned int index, const std::string &value)
+{
+    logdbg  << "DuckDBConnection: bindVariable: index " << index << " value '" << value << "'";
+    duckdb_bind_varchar_length(statement_, index, value.c_str(), value.size());
+}
+
+void DuckDBConnection::bindVariableNull (unsigned int index)
+{
+    duckdb_bind_null(statement_, index);
+}
+
+void DuckDBConnection::bulkLoad (const std::string& table_name, Buffer& buffer)
+{
+    const PropertyList& list = buffer.properties();
+    size_t size = buffer.size();
+
+    loginf << "DuckDBConnection: bulkLoad: table " << table_name << " rows " << size;
+
+    std::string columns;
+    std::vector<std::unique_ptr<ColumnAppender>> appenders;
+
+    for (unsigned int cnt=0; cnt < list.size(); ++cnt)
+    {
+        const Property& property = list.at(cnt);
+
+        columns += (cnt ? ", " : "") + property.name();
+
+        switch (property.dataType())
+        {
+        case PropertyDataType::BOOL:
+            appenders.push_back(createAppender<bool>(buffer, property.name()));
+            break;
+        case PropertyDataType::CHAR:
+            appenders.push_back(createAppender<char>(buffer, property.name()));
+            break;
+        case PropertyDataType::UCHAR:
+            appenders.push_back(createAppender<unsigned char>(buffer, property.name()));
+            break;
+        case PropertyDataType::INT:
+            appenders.push_back(createAppender<int>(buffer, property.name()));
+            break;
+        case PropertyDataType::UINT:
+            appenders.push_back(createAppender<unsigned int>(buffer, property.name()));
+            break;
+        case PropertyDataType::LONGINT:
+            appenders.push_back(createAppender<long int>(buffer, property.name()));
+            break;
+        case PropertyDataType::ULONGINT:
+            appenders.push_back(createAppender<unsigned long int>(buffer, property.name()));
+            break;
+        case PropertyDataType::FLOAT:
+            appenders.push_back(createAppender<float>(buffer, property.name()));
+            break;
+        case PropertyDataType::DOUBLE:
+            appenders.push_back(createAppender<double>(buffer, property.name()));
+            break;
+        case PropertyDataType::STRING:
+            appenders.push_back(createAppender<std::string>(buffer, property.name()));
+            break;
+        default:
+            logerr  <<  "DuckDBConnection: bulkLoad: unknown property type "
+                     << Property::asString(property.dataType());
+            throw std::runtime_error ("DuckDBConnection: bulkLoad: unknown property type "
+                                      +Property::asString(property.dataType()));
+        }
+    }
+
+    // appender fills all columns of a table, so rows are staged in a table with the buffer columns only
+    executeSQL("DROP TABLE IF EXISTS "+BULK_LOAD_TABLE+"; CREATE TABLE "+BULK_LOAD_TABLE+" AS SELECT "+columns
+               +" FROM "+table_name+" LIMIT 0;");
+
+    duckdb_appender appender;
+
+    if (duckdb_appender_create(connection_handle_, nullptr, BULK_LOAD_TABLE.c_str(), &appender) != DuckDBSuccess)
+    {
+        std::string error = duckdb_appender_error(appender) ? duckdb_appender_error(appender) : "";
+        duckdb_appender_destroy(&appender);
+        executeSQL("DROP TABLE "+BULK_LOAD_TABLE);
+
+        logerr << "DuckDBConnection: bulkLoad: unable to create appender: " << error;
+        throw std::runtime_error ("DuckDBConnection: bulkLoad: unable to create appender: "+error);
+    }
+
+    bool ok = true;
+
+    for (size_t row=0; ok && row < size; ++row)
+    {
+        for (auto& column : appenders)
+            ok = ok && column->append(appender, row) == DuckDBSuccess;
+
+        ok = ok && duckdb_appender_end_row(appender) == DuckDBSuccess;
+    }
+
+    ok = ok && duckdb_appender_flush(appender) == DuckDBSuccess;
+
+    std::string error = !ok && duckdb_appender_error(appender) ? duckdb_appender_error(appender) : "";
+    duckdb_appender_destroy(&appender);
+
+    if (!ok)
+    {
+        executeSQL("DROP TABLE "+BULK_LOAD_TABLE);
+
+        logerr << "DuckDBConnection: bulkLoad: append failed: " << error;
+        throw std::runtime_error ("DuckDBConnection: bulkLoad: append failed: "+error);
+    }
+
+    executeSQL("INSERT INTO "+table_name+" ("+columns+") SELECT "+columns+" FROM "+BULK_LOAD_TABLE+"; DROP TABLE "
+               +BULK_LOAD_TABLE+";");
+}
+
+std::shared_ptr <DBResult> DuckDBConnection::execute (const DBCommand &command)
+{
+    std::shared_ptr <DBResult> dbresult (new DBResult ());
+    std::string sql = command.get();
+
+    if (command.resultList().size() > 0) // data should be returned
+    {
+        std::shared_ptr <Buffer> buffer (new Buffer (command.resultList()));
+        dbresult->buffer(buffer);
+        logdbg  << "DuckDBConnection: execute: executing";
+        execute (sql, buffer);
+    }
+    else
+    {
+        logdbg  << "DuckDBConnection: execute: executing";
+        execute (sql);
+    }
+
+    logdbg  << "DuckDBConnection: execute: end";
+
+    return dbresult;
+}
+
+std::shared_ptr <DBResult> DuckDBConnection::execute (const DBCommandList &command_list)
+{
+    std::shared_ptr <DBResult> dbresult (new DBResult ());
+
+    unsigned int num_commands = command_list.getNumCommands();
+
+    if (command_list.getResultList().size() > 0) // data should be returned
+    {
+        std::shared_ptr <Buffer> buffer (new Buffer (command_list.getResultList()));
+        dbresult->buffer(buffer);
+
+        for (unsigned int cnt=0; cnt < num_commands; cnt++)
+            execute (command_list.getCommandString(cnt), buffer);
+    }
+    else
+    {
+        for (unsigned int cnt=0; cnt < num_commands; cnt++)
+            execute (command_list.getCommandString(cnt));
+    }
+    logdbg  << "DuckDBConnection: execute: end";
+
+    return dbresult;
+}
+
+void DuckDBConnection::execute (const std::string &command)
+{
+    logdbg  << "DuckDBConnection: execute";
+
+    executeSQL(command);
+}
+
+void DuckDBConnection::execute (const std::string &command, std::shared_ptr <Buffer> buffer)
+{
+    logdbg  << "DuckDBConnection: execute";
+
+    assert (buffer);
+
+    duckdb_result result;
+    query (command, result);
+
+    DuckDBChunkReader reader (&result, *buffer);
+
+    for (duckdb_data_chunk chunk = duckdb_fetch_chunk(result); chunk; chunk = duckdb_fetch_chunk(result))
+    {
+        reader.read(chunk, 0, duckdb_data_chunk_get_size(chunk), *buffer);
+        duckdb_destroy_data_chunk(&chunk);
+    }
+
+    duckdb_destroy_result(&result);
+}
+
+void DuckDBConnection::prepareStatement (const std::string &sql)
+{
+    logdbg  << "DuckDBConnection: prepareStatement: sql '" << sql << "'";
+
+    if (duckdb_prepare(connection_handle_, sql.c_str(), &statement_) != DuckDBSuccess)
+    {
+        std::string error = duckdb_prepare_error(statement_) ? duckdb_prepare_error(statement_) : "";
+        duckdb_destroy_prepare(&statement_);
+        statement_ = nullptr;
+
+        logerr <<  "DuckDBConnection: prepareStatement: error " << error;
+        throw std::runtime_error ("DuckDBConnection: prepareStatement: error "+error);
+    }
+}
+
+void DuckDBConnection::finalizeStatement ()
+{
+    duckdb_destroy_prepare(&statement_);
+    statement_ = nullptr;
+}
+
+void DuckDBConnection::prepareCommand (const std::shared_ptr<DBCommand> command)
+{
+    assert (prepared_command_==0);
+    assert (command);
+
+    prepareStatement (command->get());
+
+    idx_t index = 1;
+
+    for (auto& parameter : command->parameters())
+    {
+        duckdb_state state;
+
+        if (parameter.data_type_ == PropertyDataType::LONGINT)
+            state = duckdb_bind_int64(statement_, index, std::stoll(parameter.value_));
+        else if (parameter.data_type_ == PropertyDataType::DOUBLE)
+            state = duckdb_bind_double(statement_, index, std::stod(parameter.value_));
+        else
+        {
+            assert (parameter.data_type_ == PropertyDataType::STRING);
+            state = duckdb_bind_varchar_length(statement_, index, parameter.value_.c_str(), parameter.value_.size());
+        }
+
+        if (state != DuckDBSuccess)
+        {
+            finalizeStatement();
+
+            logerr << "DuckDBConnection: prepareCommand: binding parameter " << index << " failed";
+            throw std::runtime_error ("DuckDBConnection: prepareCommand: binding parameter failed");
+        }
+
+        ++index;
+    }
+
+    // streamed, chunks are produced as they are fetched
+    if (duckdb_execute_prepared_streaming(statement_, &prepared_result_) != DuckDBSuccess)
+    {
+        std::string error = duckdb_result_error(&prepared_result_) ? duckdb_result_error(&prepared_result_) : "";
+        duckdb_destroy_result(&prepared_result_);
+        finalizeStatement();
+
+        logerr << "DuckDBConnection: prepareCommand: error " << error;
+        throw std::runtime_error ("DuckDBConnection: prepareCommand: error "+error);
+    }
+
+    prepared_command_=command;
+    prepared_command_done_=false;
+    chunk_ = nullptr;
+    chunk_offset_ = 0;
+}
+
+std::shared_ptr <DBResult> DuckDBConnection::stepPreparedCommand (unsigned int max_results,
+                                                                  std::shared_ptr<BufferPool> buffer_pool)
+{
+    assert (prepared_command_);
+    assert (!prepared_command_done_);
+    assert (prepared_command_->resultList().size() > 0); // data should be returned
+
+    std::shared_ptr <Buffer> buffer (new Buffer (prepared_command_->resultList(), "", buffer_pool));
+    assert (buffer->size() == 0);
+    std::shared_ptr <DBResult> dbresult (new DBResult(buffer));
+
+    if (!chunk_reader_) // handles stay valid for all buffers of the result list
+        chunk_reader_.reset(new DuckDBChunkReader (&prepared_result_, *buffer));
+
+    if (max_results) // size once instead of growing per chunk
+        buffer->reserve(max_results);
+
+    size_t remaining = max_results ? max_results : std::numeric_limits<size_t>::max();
+    bool done = false;
+
+    while (remaining)
+    {
+        if (!chunk_)
+        {
+            chunk_ = duckdb_fetch_chunk(prepared_result_);
+            chunk_offset_ = 0;
+
+            if (!chunk_) // exhausted or failed
+            {
+                const char* error = duckdb_result_error(&prepared_result_);
+
+                if (error)
+                {
+                    logerr <<  "DuckDBConnection: stepPreparedCommand: problem while fetching the result: " << error;
+                    throw std::runtime_error (
+                                std::string("DuckDBConnection: stepPreparedCommand: problem while fetching: ")+error);
+                }
+
+                done = true;
+                break;
+            }
+        }
+
+        size_t chunk_size = duckdb_data_chunk_get_size(chunk_);
+        size_t count = std::min(remaining, chunk_size - chunk_offset_);
+
+        chunk_reader_->read(chunk_, chunk_offset_, count, *buffer);
+
+        chunk_offset_ += count;
+        remaining -= count;
+
+        if (chunk_offset_ == chunk_size)
+        {
+            duckdb_destroy_data_chunk(&chunk_);
+            chunk_ = nullptr;
+        }
+    }
+
+    if (done)
+    {
+        logdbg  << "DuckDBConnection: stepPreparedCommand: reading done";
+        prepared_command_done_=true;
+
+        buffer->lastOne(true);
+    }
+
+    return dbresult;
+}
+
+void DuckDBConnection::finalizeCommand ()
+{
+    assert (prepared_command_ != nullptr);
+
+    if (chunk_)
+    {
+        duckdb_destroy_data_chunk(&chunk_);
+        chunk_ = nullptr;
+    }
+
+    duckdb_destroy_result(&prepared_result_);
+    finalizeStatement();
+
+    chunk_reader_=nullptr;
+    prepared_command_=nullptr; // should be deleted by caller
+    prepared_command_done_=true;
+}
+
+std::map <std::string, DBTableInfo> DuckDBConnection::getTableInfo ()
+{
+    loginf << "DuckDBConnection: getTableInfo";
+
+    std::map <std::string, DBTableInfo> info;
+
+    for (auto it : getTableList())
+    {
+        loginf << "DuckDBConnection: getTableInfo: table " << it;
+        info.insert (std::pair<std::string, DBTableInfo> (it, getColumnList(it)));
+    }
+
+    return info;
+}
+
+std::vector <std::string> DuckDBConnection::getDatabases()
+{
+    return std::vector <std::string>(); //no databases
+}
+
+std::vector <std::string> DuckDBConnection::getTableList()  // buffer of table name strings
+{
+    std::vector <std::string> tables;
+
+    DBCommand command;
+    command.set ("SELECT table_name FROM information_schema.tables WHERE table_schema = 'main' AND table_name != '"
+                 +BULK_LOAD_TABLE+"' ORDER BY table_name DESC;");
+    PropertyList list;
+    list.addProperty ("table_name", PropertyDataType::STRING);
+    command.list (list);
+
+    std::shared_ptr <DBResult> result = execute(command);
+    assert (result->containsData());
+    std::shared_ptr <Buffer> buffer = result->buffer();
+
+    unsigned int size = buffer->size();
+
+    for (unsigned int cnt=0; cnt < size; cnt++)
+        tables.push_back(buffer->get<std::string>("table_name").get(cnt));
+
+    return tables;
+}
+
+DBTableInfo DuckDBConnection::getColumnList(const std::string &table) // buffer of column name string, data type
+{
+    logdbg << "DuckDBConnection: getColumnList: table " << table;
+
+    DBTableInfo table_info (table);
+
+    DBCommand command;
+    command.set ("PRAGMA table_info('"+table+"')");
+
+    //int cid, string name, string type, bool notnull, string dflt_value, bool pk
+
+    PropertyList list;
+    list.addProperty ("cid", PropertyDataType::INT);
+    list.addProperty ("name", PropertyDataType::STRING);
+    list.addProperty ("type", PropertyDataType::STRING);
+    list.addProperty ("notnull", PropertyDataType::INT);
+    list.addProperty ("dfltvalue", PropertyDataType::STRING);
+    list.addProperty ("pk", PropertyDataType::INT);
+
+    command.list (list);
+
+    std::shared_ptr <DBResult> result = execute(command);
+    assert (result->containsData());
+    std::shared_ptr <Buffer> buffer = result->buffer();
+
+    for (unsigned int cnt=0; cnt < buffer->size(); cnt++)
+    {
+        assert (buffer->has<std::string>("type"));
+        assert (buffer->has<std::string>("name"));
+        assert (buffer->has<int>("pk"));
+        assert (buffer->has<int>("notnull"));
+
+        table_info.addColumn (buffer->get<std::string>("name").get(cnt),
+                              schemaDataType(buffer->get<std::string>("type").get(cnt)),
+                              buffer->get<int>("pk").get(cnt) > 0, !buffer->get<int>("notnull").get(cnt), "");
+    }
+
+    DBCommand index_command;
+    index_command.set ("SELECT index_name FROM duckdb_indexes() WHERE table_name = '"+table+"';");
+    PropertyList index_list;
+    index_list.addProperty ("index_name", PropertyDataType::STRING);
+    index_command.list (index_list);
+
+    std::shared_ptr <DBResult> index_result = execute(index_command);
+    assert (index_result->containsData());
+    std::shared_ptr <Buffer> index_buffer = index_result->buffer();
+
+    for (unsigned int cnt=0; cnt < index_buffer->size(); cnt++)
+        table_info.addIndex (index_buffer->get<std::string>("index_name").get(cnt));
+
+    return table_info;
+}
+
+void DuckDBConnection::generateSubConfigurable (const std::string &class_id, const std::string &instance_id)
+{
+    if (class_id == "DuckDBFile")
+    {
+      SavedFile *file = new SavedFile (class_id, instance_id, this);
+      assert (file_list_.count (file->name()) == 0);
+      file_list_.insert (std::pair <std::string, SavedFile*> (file->name(), file));
+    }
+    else
+        throw std::runtime_error ("DuckDBConnection: generateSubConfigurable: unknown class_id "+class_id );
+}
+
+QWidget *DuckDBConnection::widget ()
+{
+    if (!widget_)
+    {
+        widget_ = new DuckDBConnectionWidget(*this);
+    }
+
+    assert (widget_);
+    return widget_;
+}
+
+QWidget *DuckDBConnection::infoWidget ()
+{
+    if (!info_widget_)
+    {
+        info_widget_ = new DuckDBConnectionInfoWidget(*this);
+    }
+
+    assert (info_widget_);
+    return info_widget_;
+}
+
+std::string DuckDBConnection::status () const
+{
+    if (connection_ready_)
+    {
+        if (!prepared_command_done_)
+            return "Working";
+        else
+            return "Idle";
+    }
+    else
+        return "Not connected";
+}
+
+std::string DuckDBConnection::identifier () const
+{
+    assert (connection_ready_);
+
+    return "DuckDB: "+last_filename_;
+}
+
+long long DuckDBConnection::modificationTime () const
+{
+    assert (connection_ready_);
+
+    long long time = QFileInfo (QString::fromStdString(last_filename_)).lastModified().toMSecsSinceEpoch();
+
+    QFileInfo wal_file (QString::fromStdString(last_filename_+".wal")); // changes not yet checkpointed
+
+    if (wal_file.exists())
+        time = std::max(time, (long long) wal_file.lastModified().toMSecsSinceEpoch());
+
+    return time;
+}
+
+void DuckDBConnection::addFile (const std::string &filename)
+{
+    if (file_list_.count (filename) != 0)
+        throw std::invalid_argument ("DuckDBConnection: addFile: name '"+filename+"' already in use");
+
+    std::string instancename = filename;
+    instancename.erase (std::remove(instancename.begin(), instancename.end(), '/'), instancename.end());
+
+    Configuration &config = addNewSubConfiguration ("DuckDBFile", "DuckDBFile"+instancename);
+    config.addParameterString("name", filename);
+    generateSubConfigurable ("DuckDBFile", "DuckDBFile"+instancename);
+
+    if (widget_)
+        widget_->updateFileListSlot();
+}
+
+void DuckDBConnection::removeFile (const std::string &filename)
+{
+    if (file_list_.count (filename) != 1)
+        throw std::invalid_argument ("DuckDBConnection: removeFile: name '"+filename+"' not in use");
+
+    delete file_list_.at(filename);
+    file_list_.erase(filename);
+
+    if (widget_)
+        widget_->updateFileListSlot();
+}
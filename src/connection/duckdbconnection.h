@@ -0,0 +1,146 @@
+/*
+ * This file is part of ATSDB.
+ *
+ * ATSDB is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * ATSDB is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with ATSDB.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef DUCKDBCONNECTION_H_
+#define DUCKDBCONNECTION_H_
+
+#include <duckdb.h>
+#include <string>
+#include <memory>
+#include <vector>
+
+#include "dbconnection.h"
+#include "global.h"
+
+class Buffer;
+class DBInterface;
+class DuckDBConnectionWidget;
+class DuckDBConnectionInfoWidget;
+class DuckDBChunkReader;
+class SavedFile;
+
+/**
+ * @brief Interface for an embedded DuckDB database file
+ *
+ * Columnar store for analytic reads, a query only scans the columns it selects. Results are fetched as data chunks
+ * and appended to the Buffer containers column by column, without row conversion. Bound statements use $n
+ * placeholders, bulk loads use the DuckDB appender.
+ */
+class DuckDBConnection : public DBConnection
+{
+public:
+    DuckDBConnection(const std::string &class_id, const std::string &instance_id, DBInterface *interface);
+    virtual ~DuckDBConnection();
+
+    void openFile (const std::string &file_name);
+
+    virtual void disconnect ();
+
+    void executeSQL(const std::string &sql);
+
+    void prepareBindStatement (const std::string &statement);
+    void beginBindTransaction ();
+    void stepAndClearBindings ();
+    void endBindTransaction ();
+    void finalizeBindStatement ();
+
+    void bindVariable (unsigned int index, int value);
+    void bindVariable (unsigned int index, double value);
+    void bindVariable (unsigned int index, const std::string &value);
+    void bindVariableNull (unsigned int index);
+
+    bool supportsBulkLoad () const override { return connection_ready_; }
+    void bulkLoad (const std::string& table_name, Buffer& buffer) override;
+
+    std::shared_ptr <DBResult> execute (const DBCommand &command);
+    std::shared_ptr <DBResult> execute (const DBCommandList &command_list);
+
+    void prepareCommand (const std::shared_ptr<DBCommand> command);
+    std::shared_ptr <DBResult> stepPreparedCommand (unsigned int max_results=0,
+                                                    std::shared_ptr<BufferPool> buffer_pool=nullptr);
+    void finalizeCommand ();
+    bool getPreparedCommandDone () { return prepared_command_done_; }
+
+    bool supportsParameters () const override { return true; }
+
+    std::map <std::string, DBTableInfo> getTableInfo ();
+    virtual std::vector <std::string> getDatabases();
+
+    virtual void generateSubConfigurable (const std::string &class_id, const std::string &instance_id);
+
+    QWidget *widget ();
+    QWidget *infoWidget ();
+    std::string status () const;
+    std::string identifier () const;
+    std::string type () const override { return DUCKDB_IDENTIFIER; }
+    long long modificationTime () const override;
+
+    const std::map <std::string, SavedFile*> &fileList () { return file_list_; }
+    bool hasFile (const std::string &filename) { return file_list_.count (filename) > 0; }
+    void addFile (const std::string &filename);
+    void removeFile (const std::string &filename);
+
+    const std::string &lastFilename () { return last_filename_; }
+
+protected:
+    DBInterface &interface_;
+    std::string last_filename_;
+
+    duckdb_database db_handle_ {nullptr};
+    duckdb_connection connection_handle_ {nullptr};
+
+    /// Statement for binding variables to
+    duckdb_prepared_statement statement_ {nullptr};
+    /// Prepared bind statements by SQL, bindings cleared instead of destroyed for reuse
+    std::map <std::string, duckdb_prepared_statement> bind_statements_;
+    static const size_t MAX_BIND_STATEMENTS = 64;
+
+    std::shared_ptr<DBCommand> prepared_command_;
+    bool prepared_command_done_ {true};
+    /// Streaming result of the prepared command, valid while prepared_command_ is set
+    duckdb_result prepared_result_;
+    /// Partially read chunk of the prepared result, rows before chunk_offset_ were read
+    duckdb_data_chunk chunk_ {nullptr};
+    size_t chunk_offset_ {0};
+    /// Reader of the prepared command, created with its first result buffer
+    std::unique_ptr<DuckDBChunkReader> chunk_reader_;
+
+    DuckDBConnectionWidget *widget_ {nullptr};
+    DuckDBConnectionInfoWidget *info_widget_ {nullptr};
+
+    std::map <std::string, SavedFile*> file_list_;
+
+    /// Number of threads used per query, 0 for DuckDB default (all cores)
+    unsigned int threads_;
+    /// Memory limit in MiB, 0 for DuckDB default
+    unsigned int memory_limit_mb_;
+
+    void execute (const std::string &command);
+    void execute (const std::string &command, std::shared_ptr <Buffer> buffer);
+
+    void prepareStatement (const std::string &sql);
+    void finalizeStatement ();
+    /// @brief Destroys all cached bind statements
+    void clearBindStatements ();
+    /// @brief Executes query into result, throws with DuckDB error message if failed
+    void query (const std::string &sql, duckdb_result &result);
+
+    std::vector<std::string> getTableList();
+    DBTableInfo getColumnList(const std::string &table);
+};
+
+#endif /* DUCKDBCONNECTION_H_ */
@@ -0,0 +1,57 @@
+/*
+ * This file is part of ATSDB.
+ *
+ * ATSDB is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * ATSDB is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with ATSDB.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef DUCKDBCONNECTIONWIDGET_H
+#define DUCKDBCONNECTIONWIDGET_H
+
+#include <QWidget>
+
+class DuckDBConnection;
+class QPushButton;
+class QListWidget;
+
+class DuckDBConnectionWidget : public QWidget
+{
+    Q_OBJECT
+
+signals:
+    void databaseOpenedSignal ();
+
+public slots:
+    void newFileSlot ();
+    void addFileSlot ();
+    void deleteFileSlot ();
+    void openFileSlot ();
+
+    void updateFileListSlot ();
+
+public:
+    explicit DuckDBConnectionWidget(DuckDBConnection& connection, QWidget* parent=0);
+
+protected:
+    DuckDBConnection& connection_;
+
+    QListWidget* file_list_ {nullptr};
+
+    QPushButton* new_button_ {nullptr};
+    QPushButton* add_button_ {nullptr};
+    QPushButton* delete_button_ {nullptr};
+
+    QPushButton* open_button_ {nullptr};
+};
+
+#endif // DUCKDBCONNECTIONWIDGET_H
@@ -0,0 +1,257 @@
+/*
+ * This file is part of ATSDB.
+ *
+ * ATSDB is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * ATSDB is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with ATSDB.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include "mysqlloaddatawriter.h"
+#include "property.h"
+#include "logger.h"
+
+#include <cmath>
+#include <cstdio>
+
+namespace
+{
+
+const char* NULL_FIELD = "\\N";
+
+template <typename T> inline void appendInteger (std::string& text, T value)
+{
+    char digits[24];
+    char* end = digits + sizeof(digits);
+    char* pos = end;
+
+    bool negative = value < 0;
+    // unsigned magnitude, also valid for the minimum of signed types
+    unsigned long long magnitude = negative ? 0ull - static_cast<unsigned long long> (value)
+                                            : static_cast<unsigned long long> (value);
+    do
+    {
+        *--pos = static_cast<char> ('0' + magnitude % 10);
+        magnitude /= 10;
+    } while (magnitude);
+
+    if (negative)
+        *--pos = '-';
+
+    text.append (pos, end - pos);
+}
+
+inline void appendFloating (std::string& text, double value, int precision)
+{
+    if (!std::isfinite(value)) // not storable in MySQL
+    {
+        text += NULL_FIELD;
+        return;
+    }
+
+    char digits[32];
+    int length = std::snprintf (digits, sizeof(digits), "%.*g", precision, value);
+    assert (length > 0 && (size_t) length < sizeof(digits));
+    text.append (digits, length);
+}
+
+inline void appendEscaped (std::string& text, const std::string& value)
+{
+    for (char c : value)
+    {
+        switch (c)
+        {
+        case '\\': text += "\\\\"; break;
+        case '\t': text += "\\t"; break;
+        case '\n': text += "\\n"; break;
+        case '\r': text += "\\r"; break;
+        case '\0': text += "\\0"; break;
+        default: text += c;
+        }
+    }
+}
+
+template <typename T> class TypedColumnFormatter : public MySQLLoadDataWriter::ColumnFormatter
+{
+public:
+    TypedColumnFormatter (NullableVector<T>& values)
+        : size_(values.size()), data_(size_ ? values.data() : nullptr), validity_(values.validity()) {}
+
+    virtual void format (std::string& text, size_t row)
+    {
+        if (row >= size_ || !NullableVector<T>::isValid(validity_, row))
+            text += NULL_FIELD;
+        else
+            append (text, data_[row]);
+    }
+
+private:
+    size_t size_;
+    const T* data_;
+    const uint64_t* validity_;
+
+    void append (std::string& text, T value) { appendInteger (text, value); }
+};
+
+template <> void TypedColumnFormatter<float>::append (std::string& text, float value)
+{
+    appendFloating (text, value, 9); // round-trip precision
+}
+
+template <> void TypedColumnFormatter<double>::append (std::string& text, double value)
+{
+    appendFloating (text, value, 17);
+}
+
+/// Bool data is packed, read by element
+class BoolColumnFormatter : public MySQLLoadDataWriter::ColumnFormatter
+{
+public:
+    BoolColumnFormatter (NullableVector<bool>& values) : values_(values), size_(values.size()) {}
+
+    virtual void format (std::string& text, size_t row)
+    {
+        if (row >= size_ || values_.isNull(row))
+            text += NULL_FIELD;
+        else
+            text += values_.get(row) ? '1' : '0';
+    }
+
+private:
+    NullableVector<bool>& values_;
+    size_t size_;
+};
+
+/// Escapes all dictionary values once, writes them by code
+class StringColumnFormatter : public MySQLLoadDataWriter::ColumnFormatter
+{
+public:
+    StringColumnFormatter (NullableVector<std::string>& values)
+        : size_(values.size()), codes_(size_ ? values.data() : nullptr), validity_(values.validity())
+    {
+        const StringDictionary& dictionary = values.dictionary();
+        escaped_.resize(dictionary.size());
+
+        for (uint32_t code=0; code < dictionary.size(); ++code)
+            appendEscaped (escaped_[code], dictionary.value(code));
+    }
+
+    virtual void format (std::string& text, size_t row)
+    {
+        if (row >= size_ || !NullableVector<std::string>::isValid(validity_, row))
+            text += NULL_FIELD;
+        else
+            text += escaped_[codes_[row]];
+    }
+
+private:
+    size_t size_;
+    const uint32_t* codes_;
+    const uint64_t* validity_;
+    std::vector<std::string> escaped_;
+};
+
+template <typename T> std::unique_ptr<MySQLLoadDataWriter::ColumnFormatter> createFormatter (
+        Buffer& buffer, const std::string& name)
+{
+    return std::unique_ptr<MySQLLoadDataWriter::ColumnFormatter> (
+                new TypedColumnFormatter<T> (buffer.get<T>(buffer.handle<T>(name))));
+}
+
+}
+
+MySQLLoadDataWriter::MySQLLoadDataWriter (Buffer& buffer)
+{
+    const PropertyList& list = buffer.properties();
+
+    for (unsigned int cnt=0; cnt < list.size(); ++cnt)
+    {
+        const Property& property = list.at(cnt);
+        names_.push_back(property.name());
+
+        switch (property.dataType())
+        {
+        case PropertyDataType::BOOL:
+            formatters_.push_back(std::unique_ptr<ColumnFormatter> (
+                                      new BoolColumnFormatter (buffer.get<bool>(property.name()))));
+            break;
+        case PropertyDataType::CHAR:
+            formatters_.push_back(createFormatter<char>(buffer, property.name()));
+            break;
+        case PropertyDataType::UCHAR:
+            formatters_.push_back(createFormatter<unsigned char>(buffer, property.name()));
+            break;
+        case PropertyDataType::INT:
+            formatters_.push_back(createFormatter<int>(buffer, property.name()));
+            break;
+        case PropertyDataType::UINT:
+            formatters_.push_back(createFormatter<unsigned int>(buffer, property.name()));
+            break;
+        case PropertyDataType::LONGINT:
+            formatters_.push_back(createFormatter<long int>(buffer, property.name()));
+            break;
+        case PropertyDataType::ULONGINT:
+            formatters_.push_back(createFormatter<unsigned long int>(buffer, property.name()));
+            break;
+        case PropertyDataType::FLOAT:
+            formatters_.push_back(createFormatter<float>(buffer, property.name()));
+            break;
+        case PropertyDataType::DOUBLE:
+            formatters_.push_back(createFormatter<double>(buffer, property.name()));
+            break;
+        case PropertyDataType::STRING:
+            formatters_.push_back(std::unique_ptr<ColumnFormatter> (
+                                      new StringColumnFormatter (buffer.get<std::string>(property.name()))));
+            break;
+        default:
+            logerr  <<  "MySQLLoadDataWriter: constructor: unknown property type "
+                     << Property::asString(property.dataType());
+            throw std::runtime_error ("MySQLLoadDataWriter: constructor: unknown property type "
+                                      + Property::asString(property.dataType()));
+        }
+    }
+}
+
+void MySQLLoadDataWriter::write (std::string& text, size_t from, size_t to)
+{
+    assert (formatters_.size());
+
+    size_t num_columns = formatters_.size();
+
+    for (size_t row=from; row < to; ++row)
+    {
+        for (size_t cnt=0; cnt < num_columns; ++cnt)
+        {
+            if (cnt)
+                text += '\t';
+
+            formatters_[cnt]->format(text, row);
+        }
+
+        text += '\n';
+    }
+}
+
+std::string MySQLLoadDataWriter::columnList () const
+{
+    std::string list;
+
+    for (const std::string& name : names_)
+    {
+        if (list.size())
+            list += ", ";
+
+        list += name;
+    }
+
+    return list;
+}
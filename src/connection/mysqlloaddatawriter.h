@@ -0,0 +1,63 @@
+/*
+ * This file is part of ATSDB.
+ *
+ * ATSDB is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * ATSDB is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with ATSDB.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef MYSQLLOADDATAWRITER_H_
+#define MYSQLLOADDATAWRITER_H_
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "buffer.h"
+
+/**
+ * @brief Formats the rows of a Buffer as text input of MySQL LOAD DATA
+ *
+ * Fields are separated by tabs, rows by newlines, Null is written as \N and backslash, tab, newline, carriage
+ * return and NUL are escaped with backslash, matching the default FIELDS and LINES clauses. Column order is the
+ * order of the buffer properties. Strings are escaped once per dictionary entry. The buffer must not be changed
+ * while the writer is used.
+ */
+class MySQLLoadDataWriter
+{
+public:
+    /// @brief Constructor, resolves formatters for all properties of buffer
+    MySQLLoadDataWriter (Buffer& buffer);
+
+    /// @brief Appends rows [from, to) to text
+    void write (std::string& text, size_t from, size_t to);
+
+    /// @brief Returns column list for the LOAD DATA statement, in property order
+    std::string columnList () const;
+
+    /// @brief Formatter of one buffer column
+    class ColumnFormatter
+    {
+    public:
+        virtual ~ColumnFormatter() {}
+
+        /// @brief Appends value at row, \N if Null
+        virtual void format (std::string& text, size_t row) = 0;
+    };
+
+private:
+    std::vector<std::string> names_;
+    std::vector<std::unique_ptr<ColumnFormatter>> formatters_;
+};
+
+#endif /* MYSQLLOADDATAWRITER_H_ */
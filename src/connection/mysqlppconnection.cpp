@@ -25,6 +25,10 @@
 #include "mysqlppconnectioninfowidget.h"
 #include "mysqlppconnectionwidget.h"
 #include "mysqlppconnection.h"
+#include "mysqlloaddatawriter.h"
+#include "mysqlstatementreader.h"
+#include "jobmanager.h"
+#include "sqlimportjob.h"
 #include "dbtableinfo.h"
 #include "stringconv.h"
 #include "mysqlserver.h"
@@ -33,16 +37,14 @@
 
 #include "boost/date_time/posix_time/posix_time.hpp"
 
-#include <archive.h>
-#include <archive_entry.h>
-
 #include <iostream>
 #include <fstream>
 
 #include <QMessageBox>
 #include <QProgressDialog>
 #include <QMessageBox>
-#include <QCoreApplication>
+#include <QDir>
+#include <QTemporaryFile>
 
 using namespace Utils;
 
@@ -52,14 +54,19 @@ MySQLppConnection::MySQLppConnection(const std::string &class_id, const std::str
       prepared_query_(connection_.query()), prepared_parameters_(mysqlpp::SQLQueryParms(&prepared_query_))
 {
     registerParameter("used_server", &used_server_, "");
+    registerParameter("import_connections", &import_connections_, 4);
+    registerParameter("import_transaction_statements", &import_transaction_statements_, 100);
 
     connection_.set_option(new mysqlpp::LocalInfileOption(true));
 
+    connect (&import_status_timer_, SIGNAL(timeout()), this, SLOT(importSQLStatusSlot()));
+
     createSubConfigurables ();
 }
 
 MySQLppConnection::~MySQLppConnection()
 {
+    closeStatementConnection();
 }
 
 void MySQLppConnection::setServer (const std::string &server)
@@ -115,9 +122,26 @@ void MySQLppConnection::openDatabase (const std::string &database_name)
     //        connection_.create_db(info->getDB().c_str()); // so, no database? create it first then.
     //    }
 
+    closeStatementConnection(); // still connected to previous database
+
     connection_.select_db(database_name);
     loginf  << "MySQLppConnection: openDatabase: successfully opened database '" << database_name << "'";
 
+    try // off by default since MySQL 8
+    {
+        mysqlpp::Query query = connection_.query("SELECT @@local_infile");
+        mysqlpp::StoreQueryResult res = query.store();
+        local_infile_ = res.num_rows() == 1 && (int) res[0][0] == 1;
+    }
+    catch (std::exception& e)
+    {
+        logwrn << "MySQLppConnection: openDatabase: local_infile check failed with '" << e.what() << "'";
+        local_infile_ = false;
+    }
+
+    loginf  << "MySQLppConnection: openDatabase: bulk load " << (local_infile_ ? "enabled" : "disabled, "
+                                                                "server local_infile is off");
+
     connection_ready_ = true;
     used_database_ = database_name;
 
@@ -133,8 +157,11 @@ void MySQLppConnection::openDatabase (const std::string &database_name)
 
 void MySQLppConnection::disconnect()
 {
+    closeStatementConnection();
+
     connection_.disconnect();
     connection_ready_ = false;
+    local_infile_ = false;
 
     for (auto it : servers_)
         delete it.second;
@@ -260,6 +287,79 @@ void MySQLppConnection::bindVariableNull (unsigned int index)
     prepared_parameters_[index] = mysqlpp::null;
 }
 
+void MySQLppConnection::bulkLoad (const std::string& table_name, Buffer& buffer)
+{
+    loginf  << "MySQLppConnection: bulkLoad: table " << table_name << " size " << buffer.size();
+
+    assert (!query_used_);
+    assert (prepared_command_done_);
+
+    size_t size = buffer.size();
+    MySQLLoadDataWriter writer (buffer);
+
+    QTemporaryFile file (QDir::tempPath()+"/atsdb_load_XXXXXX.txt");
+
+    if (!file.open())
+        throw std::runtime_error ("MySQLppConnection: bulkLoad: unable to create temporary file: "
+                                  +file.errorString().toStdString());
+
+    std::string text;
+    text.reserve(LOAD_DATA_CHUNK_ROWS * 64);
+
+    for (size_t row=0; row < size; row += LOAD_DATA_CHUNK_ROWS)
+    {
+        text.clear();
+        writer.write(text, row, std::min (size, row + LOAD_DATA_CHUNK_ROWS));
+
+        if (file.write(text.data(), text.size()) != (qint64) text.size())
+            throw std::runtime_error ("MySQLppConnection: bulkLoad: writing temporary file failed: "
+                                      +file.errorString().toStdString());
+    }
+
+    if (!file.flush())
+        throw std::runtime_error ("MySQLppConnection: bulkLoad: flushing temporary file failed: "
+                                  +file.errorString().toStdString());
+
+    query_used_=true;
+
+    try
+    {
+        mysqlpp::Transaction transaction (connection_); // rolled back if not committed
+
+        mysqlpp::Query query = connection_.query();
+
+        std::string path = file.fileName().toStdString();
+        std::string escaped_path;
+        query.escape_string(&escaped_path, path.c_str(), path.size());
+
+        query << "LOAD DATA LOCAL INFILE '" << escaped_path << "' INTO TABLE " << table_name
+              << " FIELDS TERMINATED BY '\\t' ESCAPED BY '\\\\' LINES TERMINATED BY '\\n' ("
+              << writer.columnList() << ")";
+
+        mysqlpp::SimpleResult result = query.execute();
+
+        // LOCAL downgrades duplicate key and conversion errors to warnings, skipping or changing rows
+        mysqlpp::StoreQueryResult warnings = connection_.query("SELECT @@warning_count").store();
+        unsigned int warning_count = warnings.num_rows() == 1 ? (unsigned int) warnings[0][0] : 0;
+
+        if (result.rows() != size || warning_count)
+            throw std::runtime_error ("MySQLppConnection: bulkLoad: table "+table_name+" loaded "
+                                      +std::to_string(result.rows())+" of "+std::to_string(size)+" rows with "
+                                      +std::to_string(warning_count)+" warnings, info '"+result.info()+"'");
+
+        transaction.commit();
+    }
+    catch (std::exception& e)
+    {
+        logerr << "MySQLppConnection: bulkLoad: table " << table_name << " error '" << e.what() << "'";
+        query_used_=false;
+
+        throw;
+    }
+
+    query_used_=false;
+}
+
 
 std::shared_ptr <DBResult> MySQLppConnection::execute (const DBCommand &command)
 {
@@ -323,106 +423,60 @@ void MySQLppConnection::execute (const std::string &command, std::shared_ptr <Bu
 
     query_used_=true;
 
-    unsigned int num_properties=0;
+    try
+    {
+        MySQLStatementReader reader (statementConnection(), command, *buffer);
+        reader.read(*buffer, 0);
+    }
+    catch (...)
+    {
+        query_used_=false;
+        throw;
+    }
 
-    const PropertyList &list = buffer->properties();
-    num_properties = list.size();
+    query_used_=false;
 
-    logdbg  << "MySQLppConnection: execute: creating query";
-    mysqlpp::Query query = connection_.query(command);
-    logdbg  << "MySQLppConnection: execute: creating storequeryresult";
-    mysqlpp::StoreQueryResult res = query.store();
+    logdbg  << "MySQLppConnection: execute done with size " << buffer->size();
+}
+
+MYSQL* MySQLppConnection::statementConnection ()
+{
+    if (statement_connection_)
+        return statement_connection_;
+
+    assert (connected_server_);
+    assert (used_database_.size());
 
-    logdbg  << "MySQLppConnection: execute: iterating result";
-    // Display results
-    size_t cnt = buffer->size();
+    statement_connection_ = mysql_init(nullptr);
 
-    mysqlpp::StoreQueryResult::const_iterator it;
-    for (it = res.begin(); it != res.end(); ++it)
+    if (!statement_connection_)
+        throw std::runtime_error ("MySQLppConnection: statementConnection: init failed");
+
+    if (!mysql_real_connect(statement_connection_, connected_server_->host().c_str(),
+                            connected_server_->user().c_str(), connected_server_->password().c_str(),
+                            used_database_.c_str(), connected_server_->port(), nullptr, 0))
     {
-        mysqlpp::Row row = *it;
-        readRowIntoBuffer (row, list, num_properties, buffer, cnt);
-        cnt++;
+        std::string error = mysql_error(statement_connection_);
+        mysql_close(statement_connection_);
+        statement_connection_ = nullptr;
+
+        throw std::runtime_error ("MySQLppConnection: statementConnection: connect failed with error "+error);
     }
 
-    query_used_=false;
+    loginf  << "MySQLppConnection: statementConnection: connected to database '" << used_database_ << "'";
 
-    logdbg  << "MySQLppConnection: execute done with size " << buffer->size();
+    return statement_connection_;
 }
 
-void MySQLppConnection::readRowIntoBuffer (mysqlpp::Row &row, const PropertyList &list, unsigned int num_properties,
-                                           std::shared_ptr <Buffer> buffer, unsigned int index)
+void MySQLppConnection::closeStatementConnection ()
 {
-    //logdbg << "MySQLppConnection::readRowIntoBuffer: start buffer size " << buffer->size() << " index " << index;
-    for (unsigned int cnt=0; cnt < num_properties; cnt++)
+    statement_reader_=nullptr;
+
+    if (statement_connection_)
     {
-            const Property &prop=list.at(cnt);
-
-            switch (prop.dataType())
-            {
-            case PropertyDataType::BOOL:
-                if (row[cnt] != mysqlpp::null)
-                    buffer->get<bool>(prop.name()).set(index, static_cast<bool> (row[cnt]));
-//                else
-//                    buffer->get<bool>(prop.name()).setNone(index);
-                //loginf  << "sqlex: bool " << prop->id_ << " val " << *ptr;
-                break;
-            case PropertyDataType::UCHAR:
-                if (row[cnt] != mysqlpp::null)
-                    buffer->get<unsigned char>(prop.name()).set(index, static_cast<unsigned char> (row[cnt]));
-//                else
-//                    buffer->get<unsigned char>(prop.name()).setNone(index);
-                //loginf  << "sqlex: uchar " << prop->id_ << " val " << *ptr;
-                break;
-            case PropertyDataType::CHAR:
-                if (row[cnt] != mysqlpp::null)
-                    buffer->get<char>(prop.name()).set(index, static_cast<signed char> (row[cnt]));
-//                else
-//                    buffer->get<char>(prop.name()).setNone(index);
-                //loginf  << "sqlex: char " << prop->id_ << " val " << *ptr;
-                break;
-            case PropertyDataType::INT:
-                if (row[cnt] != mysqlpp::null)
-                    buffer->get<int>(prop.name()).set(index, static_cast<int> (row[cnt]));
-//                else
-//                    buffer->get<int>(prop.name()).setNone(index);
-                //loginf  << "sqlex: int " << prop->id_ << " val " << *ptr;
-                break;
-            case PropertyDataType::UINT:
-                if (row[cnt] != mysqlpp::null)
-                    buffer->get<unsigned int>(prop.name()).set(index, static_cast<unsigned int> (row[cnt]));
-//                else
-//                    buffer->get<unsigned int>(prop.name()).setNone(index);
-                //loginf  << "sqlex: uint " << prop->id_ << " val " << *ptr;
-                break;
-            case PropertyDataType::STRING:
-                if (row[cnt] != mysqlpp::null)
-                    buffer->get<std::string>(prop.name()).set(index, static_cast<const char *> (row[cnt]));
-//                else
-//                    buffer->get<std::string>(prop.name()).setNone(index);
-                //loginf  << "sqlex: string " << prop->id_ << " val " << *ptr;
-                break;
-            case PropertyDataType::FLOAT:
-                if (row[cnt] != mysqlpp::null)
-                    buffer->get<float>(prop.name()).set(index, static_cast<float> (row[cnt]));
-//                else
-//                    buffer->get<float>(prop.name()).setNone(index);
-                //loginf  << "sqlex: float " << prop->id_ << " val " << *ptr;
-                break;
-            case PropertyDataType::DOUBLE:
-                if (row[cnt] != mysqlpp::null)
-                    buffer->get<double>(prop.name()).set(index, static_cast<double> (row[cnt]));
-//                else
-//                    buffer->get<double>(prop.name()).setNone(index);
-                //loginf  << "sqlex: double " << prop->id_ << " val " << *ptr;
-                break;
-            default:
-                logerr  <<  "MySQLppConnection: readRowIntoBuffer: unknown property type";
-                throw std::runtime_error ("MySQLppConnection: readRowIntoBuffer: unknown property type");
-                break;
-            }
+        mysql_close(statement_connection_);
+        statement_connection_ = nullptr;
     }
-    //logdbg << "MySQLppConnection::readRowIntoBuffer: end buffer size " << buffer->size() << " index " << index;
 }
 
 void MySQLppConnection::execute (const std::string &command)
@@ -454,16 +508,7 @@ void MySQLppConnection::prepareStatement (const std::string &sql)
     assert (!query_used_);
     query_used_=true;
 
-    result_step_ = mysqlpp::UseQueryResult ();
-
-    prepared_query_.clear();
-    prepared_query_ << sql;
-
-    if (!(result_step_ = prepared_query_.use()))
-    {
-        throw std::runtime_error ("MySQLppConnection: prepareStatement: query error '"
-                                  +std::string(prepared_query_.error())+"'");
-    }
+    statement_reader_=nullptr; // executed with the buffer of the first step
 
     if (info_widget_)
         info_widget_->updateSlot();
@@ -476,8 +521,7 @@ void MySQLppConnection::finalizeStatement ()
 
     assert (query_used_);
 
-    prepared_query_.clear();
-    prepared_query_.reset();
+    statement_reader_=nullptr; // closes the cursor
     query_used_=false;
 
     if (info_widget_)
@@ -502,7 +546,8 @@ void MySQLppConnection::prepareCommand (std::shared_ptr<DBCommand> command)
     logdbg  << "MySQLppConnection: prepareCommand: done";
 }
 
-std::shared_ptr <DBResult> MySQLppConnection::stepPreparedCommand (unsigned int max_results)
+std::shared_ptr <DBResult> MySQLppConnection::stepPreparedCommand (unsigned int max_results,
+                                                          std::shared_ptr<BufferPool> buffer_pool)
 {
     logdbg  << "MySQLppConnection: stepPreparedCommand";
 
@@ -512,43 +557,28 @@ std::shared_ptr <DBResult> MySQLppConnection::stepPreparedCommand (unsigned int
     std::string sql = prepared_command_->get();
     assert (prepared_command_->resultList().size() > 0); // data should be returned
 
-    std::shared_ptr <Buffer> buffer (new Buffer (prepared_command_->resultList()));
+    std::shared_ptr <Buffer> buffer (new Buffer (prepared_command_->resultList(), "", buffer_pool));
     assert (buffer->size() == 0);
     std::shared_ptr <DBResult> dbresult (new DBResult(buffer));
 
-    unsigned int num_properties = buffer->properties().size();
-    const PropertyList &list = buffer->properties();
-    unsigned int cnt = 0;
-
-    bool done=true;
+    if (!statement_reader_) // handles stay valid for all buffers of the result list
+        statement_reader_.reset(new MySQLStatementReader (statementConnection(), sql, *buffer));
 
-    max_results--;
+    if (max_results) // size once instead of growing per row
+        buffer->reserve(max_results);
 
-    while (mysqlpp::Row row = result_step_.fetch_row())
-    {
-        readRowIntoBuffer (row, list, num_properties, buffer, cnt);
-        assert (buffer->size() == cnt+1);
-
-        if (max_results != 0 && cnt >= max_results)
-        {
-            done=false;
-            break;
-        }
+    bool done = !statement_reader_->read(*buffer, max_results);
 
-        ++cnt;
-    }
-    logdbg  << "MySQLppConnection: stepPreparedCommand: buffer size " << buffer->size() << " max results " << max_results;
+    loginf  << "MySQLppConnection: stepPreparedCommand: read " << buffer->size() << " rows, "
+            << statement_reader_->rowsRead() << " in total";
 
-    assert (buffer->size() <= max_results+1); // because of max_results--
+    assert (!max_results || buffer->size() <= max_results);
 
-    if (buffer->size() == 0 || done)
+    if (done)
     {
         logdbg  << "MySQLppConnection: stepPreparedCommand: reading done";
         prepared_command_done_=true;
-        if (done)
-            buffer->lastOne(true);
-        else
-            buffer=nullptr;
+        buffer->lastOne(true);
     }
 
     logdbg  << "MySQLppConnection: stepPreparedCommand: done";
@@ -560,14 +590,6 @@ void MySQLppConnection::finalizeCommand ()
     assert (prepared_command_);
     //assert (prepared_command_done_); true if ok, false if quit job
 
-    bool first = true;
-    while (mysqlpp::Row row = result_step_.fetch_row())
-        if (first)
-        {
-            loginf << "MySQLppConnection: finalizeCommand: stepping through result set to finalize";
-            first = false;
-        }
-
     prepared_command_=nullptr; // should be deleted by caller
     prepared_command_done_=true;
     finalizeStatement();
@@ -648,6 +670,19 @@ DBTableInfo MySQLppConnection::getColumnList(const std::string &table) // buffer
                               buffer->get<std::string>("COLUMN_COMMENT").get(cnt));
     }
 
+    DBCommand index_command;
+    index_command.set ("SELECT DISTINCT INDEX_NAME FROM INFORMATION_SCHEMA.STATISTICS WHERE TABLE_SCHEMA = '"+database+"' AND TABLE_NAME = '"+table+"';");
+    PropertyList index_list;
+    index_list.addProperty ("INDEX_NAME", PropertyDataType::STRING);
+    index_command.list (index_list);
+
+    std::shared_ptr <DBResult> index_result = execute(index_command);
+    assert (index_result->containsData());
+    std::shared_ptr <Buffer> index_buffer = index_result->buffer();
+
+    for (unsigned int cnt=0; cnt < index_buffer->size(); cnt++)
+        table_info.addIndex (index_buffer->get<std::string>("INDEX_NAME").get(cnt));
+
     return table_info;
 }
 
@@ -834,294 +869,96 @@ void MySQLppConnection::generateSubConfigurable (const std::string &class_id, co
 
 void MySQLppConnection::importSQLFile (const std::string& filename)
 {
-    loginf  << "MySQLppConnection: importSQLFile: importing " << filename;
-    assert (Files::fileExists(filename));
-
-    QProgressDialog* progress_dialog = new QProgressDialog (tr("Importing SQL File"), tr(""), 0, 100);
-    progress_dialog->setCancelButton(0);
-    progress_dialog->setModal(true);
-    progress_dialog->setWindowModality(Qt::ApplicationModal);
-    progress_dialog->show();
-
-    for (unsigned int cnt=0; cnt < 10; cnt++)
-        QCoreApplication::processEvents(QEventLoop::ExcludeUserInputEvents);
-
-    std::ifstream is;
-    is.open (filename.c_str(), std::ios::binary );
-    is.seekg (0, std::ios::end);
-    size_t file_byte_size = is.tellg();
-    is.close();
-    assert (file_byte_size);
-    loginf  << "MySQLppConnection: importSQLFile: file_byte_size: " << file_byte_size;
+    importSQL (filename, false);
+}
 
-    for (unsigned int cnt=0; cnt < 10; cnt++)
-        QCoreApplication::processEvents(QEventLoop::ExcludeUserInputEvents);
+void MySQLppConnection::importSQLArchiveFile(const std::string& filename)
+{
+    importSQL (filename, true);
+}
 
-    std::ifstream sql_file (filename);
-    assert (sql_file.is_open());
+void MySQLppConnection::importSQL (const std::string& filename, bool archive)
+{
+    loginf  << "MySQLppConnection: importSQL: importing " << filename << " archive " << archive;
+    assert (Files::fileExists(filename));
+    assert (connected_server_);
 
-    std::string line;
-    std::stringstream ss;
-    size_t line_cnt = 0;
-    size_t byte_cnt = 0;
-    size_t error_cnt = 0;
+    if (import_job_)
+        throw std::runtime_error ("MySQLppConnection: importSQL: import already running");
 
-    while (getline (sql_file,line))
-    {
-        try
-        {
-            byte_cnt += line.size();
+    import_job_ = std::make_shared<SQLImportJob> (*connected_server_, used_database_, filename, archive,
+                                                  import_connections_, import_transaction_statements_);
 
-            if (line.find ("delimiter") != std::string::npos || line.find ("DELIMITER") != std::string::npos
-                    || line.find ("VIEW") != std::string::npos)
-            {
-                loginf << "MySQLppConnection: importSQLFile: breaking at delimiter, bytes " << byte_cnt;
-                break;
-            }
+    connect (import_job_.get(), SIGNAL(obsoleteSignal()), this, SLOT(importSQLDoneSlot()), Qt::QueuedConnection);
+    connect (import_job_.get(), SIGNAL(doneSignal()), this, SLOT(importSQLDoneSlot()), Qt::QueuedConnection);
 
-            ss << line << '\n';
+    assert (!import_progress_dialog_);
+    import_progress_dialog_ = new QProgressDialog (tr("Importing SQL File"), tr("Cancel"), 0, 100);
+    import_progress_dialog_->setWindowModality(Qt::ApplicationModal);
+    import_progress_dialog_->setAutoClose(false);
+    import_progress_dialog_->setAutoReset(false);
+    connect (import_progress_dialog_, SIGNAL(canceled()), this, SLOT(importSQLCancelSlot()));
+    import_progress_dialog_->show();
 
-            if (line.back() == ';')
-            {
-                //                loginf << "MySQLppConnection: importSQLFile: line cnt " << line_cnt << " of " << line_count
-                //                       << " strlen " << ss.str().size() << "'";
+    import_status_timer_.start(500);
 
-                if (ss.str().size())
-                    executeSQL (ss.str());
+    JobManager::instance().addDBJob(import_job_);
+}
 
-                ss.str("");
-            }
+void MySQLppConnection::importSQLStatusSlot ()
+{
+    if (!import_job_ || !import_progress_dialog_)
+        return;
 
-            if (line_cnt % 10 == 0)
-            {
-                progress_dialog->setValue(100*byte_cnt/file_byte_size);
-                QCoreApplication::processEvents(QEventLoop::ExcludeUserInputEvents);
-            }
+    import_progress_dialog_->setValue(import_job_->getStatusPercent());
 
-            line_cnt ++;
-        }
-        catch (std::exception& e)
-        {
-            logwrn << "MySQLppConnection: importSQLFile: sql error '" << e.what() << "'";
-            ss.str("");
-            error_cnt++;
-
-            if (error_cnt > 3)
-            {
-                logwrn << "MySQLppConnection: importSQLFile: quit after too many errors";
-
-                QMessageBox m_warning (QMessageBox::Warning, "MySQL Text Import Failed",
-                                       "Quit after too many SQL errors. Please make sure that"
-                                       " the SQL file is correct.",
-                                       QMessageBox::Ok);
-                m_warning.exec();
-
-                break;
-            }
-        }
+    std::string msg = "Executed "+std::to_string(import_job_->statementsExecuted())+" statements";
 
-    }
-    delete progress_dialog;
-    progress_dialog = nullptr;
+    if (import_job_->errorCount())
+        msg += ", "+std::to_string(import_job_->errorCount())+" SQL errors";
 
-    QMessageBox msgBox;
-    std::string msg;
-    if (error_cnt)
-        msg = "The SQL file was imported with "+std::to_string(error_cnt)+" SQL errors.";
-    else
-        msg = "The SQL file was imported without SQL errors.";
+    import_progress_dialog_->setLabelText(msg.c_str());
+}
 
-    msgBox.setText(msg.c_str());
-    msgBox.exec();
+void MySQLppConnection::importSQLCancelSlot ()
+{
+    if (!import_job_)
+        return;
 
-    sql_file.close();
-    interface_.databaseContentChanged();
+    loginf  << "MySQLppConnection: importSQLCancelSlot: canceling import";
+    import_job_->setObsolete();
 }
 
-void MySQLppConnection::importSQLArchiveFile(const std::string& filename)
+void MySQLppConnection::importSQLDoneSlot ()
 {
-    loginf  << "MySQLppConnection: importSQLArchiveFile: importing " << filename;
-    assert (Files::fileExists(filename));
+    if (!import_job_) // both signals received
+        return;
 
-    // if gz but not tar.gz or tgz
-    bool raw = String::hasEnding (filename, ".gz") && !String::hasEnding (filename, ".tar.gz");
+    loginf  << "MySQLppConnection: importSQLDoneSlot: done";
 
-    loginf  << "MySQLppConnection: importSQLArchiveFile: importing " << filename << " raw " << raw;
+    import_status_timer_.stop();
 
-    struct archive *a;
-    struct archive_entry *entry;
-    int r;
+    delete import_progress_dialog_;
+    import_progress_dialog_ = nullptr;
 
-    a = archive_read_new();
+    size_t error_cnt = import_job_->errorCount();
+    std::string msg;
 
-    if (raw)
-    {
-        archive_read_support_filter_gzip(a);
-        archive_read_support_filter_bzip2(a);
-        archive_read_support_format_raw(a);
-    }
+    if (import_job_->obsolete())
+        msg = "The SQL import was canceled.";
+    else if (error_cnt > SQLImportJob::MAX_ERRORS)
+        msg = "The SQL import quit after too many SQL errors. Please make sure that the SQL file is correct.";
+    else if (error_cnt)
+        msg = "The SQL file was imported with "+std::to_string(error_cnt)+" SQL errors.";
     else
-    {
-        archive_read_support_filter_all(a);
-        archive_read_support_format_all(a);
-
-    }
-    r = archive_read_open_filename(a, filename.c_str(), 10240); // Note 1
-
-    if (r != ARCHIVE_OK)
-        throw std::runtime_error("MySQLppConnection: importSQLArchiveFile: archive error: "
-                                 +std::string(archive_error_string(a)));
-
-    const void *buff;
-    size_t size;
-    int64_t offset;
-
-    size_t line_cnt = 0;
-    size_t error_cnt = 0;
-    size_t byte_cnt = 0;
-
-    QMessageBox msg_box;
-    std::string msg = "Importing archive '"+filename+"'.";
-    msg_box.setText(msg.c_str());
-    msg_box.setStandardButtons(QMessageBox::NoButton);
-    msg_box.show();
-
-    for (unsigned int cnt=0; cnt < 10; cnt++)
-        QCoreApplication::processEvents(QEventLoop::ExcludeUserInputEvents);
-
-    while (archive_read_next_header(a, &entry) == ARCHIVE_OK)
-    {
-        loginf << "Archive file found: " << archive_entry_pathname(entry) << " size " << archive_entry_size(entry);
-
-        msg_box.setInformativeText(archive_entry_pathname(entry));
-
-        bool done=false;
-
-        std::stringstream ss;
-
-        for (;;)
-        {
-            r = archive_read_data_block(a, &buff, &size, &offset);
-
-            if (r == ARCHIVE_EOF)
-                break;
-            if (r != ARCHIVE_OK)
-                throw std::runtime_error("MySQLppConnection: importSQLArchiveFile: archive error: "
-                                         +std::string(archive_error_string(a)));
-
-            std::string str (reinterpret_cast<char const*>(buff), size);
-
-            //loginf << "UGA read offset " << offset << " size " << size;
-
-            std::vector<std::string> lines = String::split(str, '\n');
-            std::string line;
-
-            //loginf << "UGA read str has " << lines.size() << " lines";
-
-            for (std::vector<std::string>::iterator line_it = lines.begin(); line_it != lines.end(); line_it++)
-            {
-                if (line_it + 1 == lines.end() )
-                {
-                    //loginf << "last one";
-                    ss << *line_it;
-                    break;
-                }
-
-                try
-                {
-                    ss << *line_it << '\n';
-
-                    line = ss.str();
-
-                    byte_cnt += line.size();
-
-                    if (line.find ("delimiter") != std::string::npos || line.find ("DELIMITER") != std::string::npos
-                            || line.find ("VIEW") != std::string::npos)
-                    {
-                        loginf << "MySQLppConnection: importSQLArchiveFile: breaking at delimiter, bytes " << byte_cnt;
-                        done = true;
-                        break;
-                    }
-
-                    if (line_it->back() == ';')
-                    {
-                        //                        loginf << "MySQLppConnection: importSQLArchiveFile: line cnt " << line_cnt
-                        //                               <<  " strlen " << ss.str().size() << "'";
-
-                        if (line.size())
-                            executeSQL (line+"\n");
-
-                        ss.str("");
-                    }
-
-                    if (line_cnt % 10 == 0)
-                    {
-                        logdbg << "MySQLppConnection: importSQLArchiveFile: line cnt " << line_cnt;
-                        msg = "Read " + std::to_string(line_cnt) + " lines from "
-                                + std::string(archive_entry_pathname(entry)) + " archive entry.";
-
-                        msg_box.setInformativeText(msg.c_str());
-                        msg_box.show();
-                        QCoreApplication::processEvents(QEventLoop::ExcludeUserInputEvents);
-                        //                        progress_dialog->setValue(100*byte_cnt/file_byte_size);
-                        //                        QCoreApplication::processEvents(QEventLoop::ExcludeUserInputEvents);
-                    }
-
-                    line_cnt ++;
-                }
-                catch (std::exception& e)
-                {
-                    logwrn << "MySQLppConnection: importSQLArchiveFile: sql error '" << e.what() << "'";
-                    ss.str("");
-                    error_cnt++;
-
-                    if (error_cnt > 3)
-                    {
-                        logwrn << "MySQLppConnection: importSQLArchiveFile: quit after too many errors";
-
-                        QMessageBox m_warning (QMessageBox::Warning, "MySQL Archive Import Failed",
-                                               "Quit after too many SQL errors. Please make sure that"
-                                               " the archive is correct as specified in the user manual.",
-                                               QMessageBox::Ok);
-                        m_warning.exec();
-                        done=true;
-                        break;
-                    }
-                }
-            }
-
-            if (done)
-                break;
-        }
-
-        if (done)
-            break;
-
-        loginf << "MySQLppConnection: importSQLArchiveFile: archive file " << archive_entry_pathname(entry) << " imported";
-    }
+        msg = "The SQL file was imported without SQL errors.";
 
-    msg_box.close();
+    import_job_ = nullptr;
 
     QMessageBox msgBox;
-    if (error_cnt)
-        msg = "The SQL archive file was imported with "+std::to_string(error_cnt)+" SQL errors.";
-    else
-        msg = "The SQL archive file was imported without SQL errors.";
-
     msgBox.setText(msg.c_str());
     msgBox.exec();
 
-    r = archive_read_close(a);
-    if (r != ARCHIVE_OK)
-        throw std::runtime_error("MySQLppConnection: importSQLArchiveFile: archive read close error: "
-                                 +std::string(archive_error_string(a)));
-
-    r = archive_read_free(a);
-
-    if (r != ARCHIVE_OK)
-        throw std::runtime_error("MySQLppConnection: importSQLArchiveFile: archive read free error: "
-                                 +std::string(archive_error_string(a)));
-
     interface_.databaseContentChanged();
 }
 
@@ -19,8 +19,11 @@
 #define MySQLppConnection_H_
 
 #include <mysql++/mysql++.h>
+#include <memory>
 #include <string>
 
+#include <QTimer>
+
 #include "configurable.h"
 #include "dbconnection.h"
 #include "global.h"
@@ -31,7 +34,10 @@ class DBTableInfo;
 class MySQLppConnectionWidget;
 class MySQLppConnectionInfoWidget;
 class MySQLServer;
+class MySQLStatementReader;
 class PropertyList;
+class QProgressDialog;
+class SQLImportJob;
 
 /**
  * @brief Interface for a MySQL database connection
@@ -40,6 +46,12 @@ class PropertyList;
  */
 class MySQLppConnection : public DBConnection
 {
+    Q_OBJECT
+public slots:
+    void importSQLStatusSlot ();
+    void importSQLCancelSlot ();
+    void importSQLDoneSlot ();
+
 public:
     MySQLppConnection(const std::string& class_id, const std::string& instance_id, DBInterface* interface);
     virtual ~MySQLppConnection();
@@ -68,11 +80,15 @@ public:
     void bindVariable (unsigned int index, const std::string &value) override;
     void bindVariableNull (unsigned int index) override;
 
+    bool supportsBulkLoad () const override { return local_infile_; }
+    void bulkLoad (const std::string& table_name, Buffer& buffer) override;
+
     std::shared_ptr <DBResult> execute (const DBCommand& command) override;
     std::shared_ptr <DBResult> execute (const DBCommandList& command_list) override;
 
     void prepareCommand (const std::shared_ptr<DBCommand> command) override;
-    std::shared_ptr <DBResult> stepPreparedCommand (unsigned int max_results=0) override;
+    std::shared_ptr <DBResult> stepPreparedCommand (unsigned int max_results=0,
+                                                    std::shared_ptr<BufferPool> buffer_pool=nullptr) override;
     void finalizeCommand () override;
     bool getPreparedCommandDone () override { return prepared_command_done_; }
 
@@ -98,7 +114,9 @@ public:
 
     MySQLServer& connectedServer () { assert (connected_server_); return *connected_server_; }
 
+    /// @brief Imports SQL dump in the background, plain text
     void importSQLFile (const std::string& filename);
+    /// @brief Imports SQL dump in the background, compressed or archived
     void importSQLArchiveFile (const std::string& filename);
 
 protected:
@@ -115,10 +133,14 @@ protected:
     mysqlpp::Query prepared_query_;
     /// Parameters which are bound to the a query
     mysqlpp::SQLQueryParms prepared_parameters_;
-    /// Result from query for incremental reading.
-    mysqlpp::UseQueryResult result_step_;
+    /// Connection of the server-side cursors, opened on first read
+    MYSQL* statement_connection_ {nullptr};
+    /// Cursor of the prepared command, created on first step
+    std::unique_ptr<MySQLStatementReader> statement_reader_;
     /// Query is in use flag.
     bool query_used_ {false};
+    /// Server allows LOAD DATA LOCAL INFILE, checked when opening a database
+    bool local_infile_ {false};
 
     // Transaction which can group queries (for fast insertion)
     mysqlpp::Transaction* transaction_ {nullptr};
@@ -133,6 +155,18 @@ protected:
 
     std::map <std::string, MySQLServer*> servers_;
 
+    /// Number of connections used by SQL dump imports
+    unsigned int import_connections_;
+    /// Number of statements per transaction in SQL dump imports
+    unsigned int import_transaction_statements_;
+    /// Running SQL dump import
+    std::shared_ptr<SQLImportJob> import_job_;
+    QProgressDialog* import_progress_dialog_ {nullptr};
+    QTimer import_status_timer_;
+
+    /// Number of rows formatted per write to the LOAD DATA file
+    static const size_t LOAD_DATA_CHUNK_ROWS = 8192;
+
     void prepareStatement (const std::string &sql) override;
     void finalizeStatement () override;
 
@@ -142,8 +176,12 @@ protected:
     /// @brief Executes an SQL command which returns no data (internal)
     void execute (const std::string &command);
 
-    void readRowIntoBuffer (mysqlpp::Row &row, const PropertyList &list, unsigned int num_properties,
-                            std::shared_ptr <Buffer> buffer, unsigned int index);
+    /// @brief Returns connection for statement readers, opens it to the used database if needed
+    MYSQL* statementConnection ();
+    /// @brief Closes statement reader and connection, reopened to the used database on next read
+    void closeStatementConnection ();
+
+    void importSQL (const std::string& filename, bool archive);
 
     std::vector<std::string> getTableList();
     DBTableInfo getColumnList(const std::string &table);
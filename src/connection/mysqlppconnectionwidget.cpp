@@ -227,7 +227,7 @@ void MySQLppConnectionWidget::importSQLTextFromArchiveSlot()
 
     QFileDialog dialog(this);
     dialog.setFileMode(QFileDialog::ExistingFile);
-    dialog.setNameFilter(tr("Archives (*.tar.gz *.gz *.tar *.zip *.tgz *.rar)"));
+    dialog.setNameFilter(tr("Archives (*.tar.gz *.gz *.bz2 *.tar *.zip *.tgz *.rar)"));
     dialog.setViewMode(QFileDialog::Detail);
 
     QStringList filenames;
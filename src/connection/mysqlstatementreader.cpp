@@ -0,0 +1,373 @@
+/*
+ * This file is part of ATSDB.
+ *
+ * ATSDB is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * ATSDB is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with ATSDB.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include "mysqlstatementreader.h"
+#include "property.h"
+#include "logger.h"
+
+#include <cstring>
+
+namespace
+{
+
+/// Output slot and MySQL buffer type per container type
+template <typename T> struct BindTraits;
+
+template <> struct BindTraits<bool>
+{
+    typedef signed char Slot;
+    static const enum_field_types type = MYSQL_TYPE_TINY;
+    static const bool is_unsigned = false;
+};
+
+template <> struct BindTraits<char>
+{
+    typedef signed char Slot;
+    static const enum_field_types type = MYSQL_TYPE_TINY;
+    static const bool is_unsigned = false;
+};
+
+template <> struct BindTraits<unsigned char>
+{
+    typedef unsigned char Slot;
+    static const enum_field_types type = MYSQL_TYPE_TINY;
+    static const bool is_unsigned = true;
+};
+
+template <> struct BindTraits<int>
+{
+    typedef int Slot;
+    static const enum_field_types type = MYSQL_TYPE_LONG;
+    static const bool is_unsigned = false;
+};
+
+template <> struct BindTraits<unsigned int>
+{
+    typedef unsigned int Slot;
+    static const enum_field_types type = MYSQL_TYPE_LONG;
+    static const bool is_unsigned = true;
+};
+
+template <> struct BindTraits<long int>
+{
+    typedef long long Slot;
+    static const enum_field_types type = MYSQL_TYPE_LONGLONG;
+    static const bool is_unsigned = false;
+};
+
+template <> struct BindTraits<unsigned long int>
+{
+    typedef unsigned long long Slot;
+    static const enum_field_types type = MYSQL_TYPE_LONGLONG;
+    static const bool is_unsigned = true;
+};
+
+template <> struct BindTraits<float>
+{
+    typedef float Slot;
+    static const enum_field_types type = MYSQL_TYPE_FLOAT;
+    static const bool is_unsigned = false;
+};
+
+template <> struct BindTraits<double>
+{
+    typedef double Slot;
+    static const enum_field_types type = MYSQL_TYPE_DOUBLE;
+    static const bool is_unsigned = false;
+};
+
+/// Stages values with validity of one block of rows, appends them to the container on flush
+template <typename T> class StagedColumnReader : public MySQLStatementReader::ColumnReader
+{
+public:
+    StagedColumnReader (ColumnHandle<T> handle)
+        : handle_(handle), values_(new T[MySQLStatementReader::BLOCK_SIZE]()),
+          validity_(MySQLStatementReader::BLOCK_SIZE / NullableVector<T>::VALIDITY_WORD_BITS, 0) {}
+
+    virtual void flush (Buffer& buffer, size_t count)
+    {
+        buffer.get<T>(handle_).append(values_.get(), has_null_ ? validity_.data() : nullptr, count);
+
+        std::fill (validity_.begin(), validity_.end(), 0);
+        has_null_ = false;
+    }
+
+protected:
+    ColumnHandle<T> handle_;
+    std::unique_ptr<T[]> values_;
+    std::vector<uint64_t> validity_;
+    bool has_null_ {false};
+    MySQLStatementReader::NullFlag is_null_ {0};
+
+    /// Returns false and stages Null at row if fetched value is Null
+    bool stageValid (size_t row)
+    {
+        if (is_null_)
+        {
+            values_[row] = T(); // no stale value from a previous block
+            has_null_ = true;
+            return false;
+        }
+
+        validity_[row / NullableVector<T>::VALIDITY_WORD_BITS] |=
+                uint64_t(1) << (row % NullableVector<T>::VALIDITY_WORD_BITS);
+        return true;
+    }
+};
+
+template <typename T> class TypedColumnReader : public StagedColumnReader<T>
+{
+public:
+    TypedColumnReader (ColumnHandle<T> handle) : StagedColumnReader<T> (handle) {}
+
+    virtual void bind (MYSQL_BIND& bind)
+    {
+        bind.buffer_type = BindTraits<T>::type;
+        bind.buffer = &slot_;
+        bind.buffer_length = sizeof(slot_);
+        bind.is_unsigned = BindTraits<T>::is_unsigned;
+        bind.is_null = &this->is_null_;
+    }
+
+    virtual bool read (MYSQL_STMT* statement, MYSQL_BIND& bind, unsigned int column, size_t row)
+    {
+        if (this->stageValid(row))
+            this->values_[row] = static_cast<T> (slot_);
+
+        return false;
+    }
+
+private:
+    typename BindTraits<T>::Slot slot_ {0};
+};
+
+/// Fetches into a growing character slot, values longer than the slot are fetched again
+class StringColumnReader : public StagedColumnReader<std::string>
+{
+public:
+    StringColumnReader (ColumnHandle<std::string> handle)
+        : StagedColumnReader<std::string> (handle), slot_(INITIAL_LENGTH) {}
+
+    virtual void bind (MYSQL_BIND& bind)
+    {
+        bind.buffer_type = MYSQL_TYPE_STRING;
+        bind.buffer = slot_.data();
+        bind.buffer_length = slot_.size();
+        bind.length = &length_;
+        bind.is_null = &is_null_;
+    }
+
+    virtual bool read (MYSQL_STMT* statement, MYSQL_BIND& bind, unsigned int column, size_t row)
+    {
+        if (!stageValid(row))
+            return false;
+
+        bool grown = length_ > slot_.size();
+
+        if (grown) // truncated
+        {
+            slot_.resize(length_);
+            this->bind (bind);
+
+            if (mysql_stmt_fetch_column(statement, &bind, column, 0))
+                throw std::runtime_error ("MySQLStatementReader: read: fetching column failed: "
+                                          +std::string(mysql_stmt_error(statement)));
+        }
+
+        values_[row].assign(slot_.data(), length_); // keeps capacity of staged string
+        return grown;
+    }
+
+private:
+    static const size_t INITIAL_LENGTH = 256;
+
+    std::vector<char> slot_;
+    unsigned long length_ {0};
+};
+
+template <typename T> std::unique_ptr<MySQLStatementReader::ColumnReader> createReader (Buffer& buffer,
+                                                                                       const std::string& name)
+{
+    return std::unique_ptr<MySQLStatementReader::ColumnReader> (new TypedColumnReader<T> (buffer.handle<T>(name)));
+}
+
+template <> std::unique_ptr<MySQLStatementReader::ColumnReader> createReader<std::string> (Buffer& buffer,
+                                                                                          const std::string& name)
+{
+    return std::unique_ptr<MySQLStatementReader::ColumnReader> (
+                new StringColumnReader (buffer.handle<std::string>(name)));
+}
+
+}
+
+MySQLStatementReader::MySQLStatementReader (MYSQL* connection, const std::string& sql, Buffer& buffer)
+{
+    assert (connection);
+
+    statement_ = mysql_stmt_init(connection);
+
+    if (!statement_)
+        throw std::runtime_error ("MySQLStatementReader: constructor: statement init failed: "
+                                  +std::string(mysql_error(connection)));
+
+    try
+    {
+        unsigned long cursor_type = CURSOR_TYPE_READ_ONLY; // rows are fetched from server in blocks
+        unsigned long prefetch_rows = BLOCK_SIZE;
+
+        if (mysql_stmt_attr_set(statement_, STMT_ATTR_CURSOR_TYPE, &cursor_type)
+                || mysql_stmt_attr_set(statement_, STMT_ATTR_PREFETCH_ROWS, &prefetch_rows))
+            throwError ("constructor: setting cursor failed");
+
+        if (mysql_stmt_prepare(statement_, sql.c_str(), sql.size()))
+            throwError ("constructor: prepare failed");
+
+        const PropertyList& list = buffer.properties();
+        unsigned int num_fields = mysql_stmt_field_count(statement_);
+
+        if (num_fields < list.size())
+            throw std::runtime_error ("MySQLStatementReader: constructor: query returns "+std::to_string(num_fields)
+                                      +" columns for "+std::to_string(list.size())+" properties");
+
+        for (unsigned int cnt=0; cnt < list.size(); ++cnt)
+        {
+            const Property& property = list.at(cnt);
+
+            switch (property.dataType())
+            {
+            case PropertyDataType::BOOL:
+                readers_.push_back(createReader<bool>(buffer, property.name()));
+                break;
+            case PropertyDataType::CHAR:
+                readers_.push_back(createReader<char>(buffer, property.name()));
+                break;
+            case PropertyDataType::UCHAR:
+                readers_.push_back(createReader<unsigned char>(buffer, property.name()));
+                break;
+            case PropertyDataType::INT:
+                readers_.push_back(createReader<int>(buffer, property.name()));
+                break;
+            case PropertyDataType::UINT:
+                readers_.push_back(createReader<unsigned int>(buffer, property.name()));
+                break;
+            case PropertyDataType::LONGINT:
+                readers_.push_back(createReader<long int>(buffer, property.name()));
+                break;
+            case PropertyDataType::ULONGINT:
+                readers_.push_back(createReader<unsigned long int>(buffer, property.name()));
+                break;
+            case PropertyDataType::FLOAT:
+                readers_.push_back(createReader<float>(buffer, property.name()));
+                break;
+            case PropertyDataType::DOUBLE:
+                readers_.push_back(createReader<double>(buffer, property.name()));
+                break;
+            case PropertyDataType::STRING:
+                readers_.push_back(createReader<std::string>(buffer, property.name()));
+                break;
+            default:
+                logerr  <<  "MySQLStatementReader: constructor: unknown property type "
+                         << Property::asString(property.dataType());
+                throw std::runtime_error ("MySQLStatementReader: constructor: unknown property type "
+                                          +Property::asString(property.dataType()));
+            }
+        }
+
+        binds_.resize(num_fields);
+        std::memset (binds_.data(), 0, num_fields * sizeof(MYSQL_BIND));
+
+        for (unsigned int cnt=0; cnt < num_fields; ++cnt)
+        {
+            if (cnt < readers_.size())
+                readers_[cnt]->bind(binds_[cnt]);
+            else
+                binds_[cnt].buffer_type = MYSQL_TYPE_NULL; // not in buffer, ignored
+        }
+
+        if (mysql_stmt_execute(statement_))
+            throwError ("constructor: execute failed");
+
+        if (mysql_stmt_bind_result(statement_, binds_.data()))
+            throwError ("constructor: binding result failed");
+    }
+    catch (...)
+    {
+        mysql_stmt_close(statement_);
+        throw;
+    }
+}
+
+MySQLStatementReader::~MySQLStatementReader ()
+{
+    mysql_stmt_close(statement_); // also closes the cursor
+}
+
+bool MySQLStatementReader::read (Buffer& buffer, size_t max_rows)
+{
+    size_t rows = 0;
+
+    while (!done_ && (!max_rows || rows < max_rows))
+    {
+        int result = mysql_stmt_fetch(statement_);
+
+        if (result == MYSQL_NO_DATA)
+        {
+            done_ = true;
+            break;
+        }
+
+        if (result == 1)
+            throwError ("read: fetch failed");
+
+        // MYSQL_DATA_TRUNCATED is handled by the string readers
+        bool rebind = false;
+
+        for (unsigned int cnt=0; cnt < readers_.size(); ++cnt)
+            rebind |= readers_[cnt]->read(statement_, binds_[cnt], cnt, count_);
+
+        if (rebind && mysql_stmt_bind_result(statement_, binds_.data()))
+            throwError ("read: binding result failed");
+
+        ++rows;
+
+        if (++count_ == BLOCK_SIZE)
+            flush (buffer);
+    }
+
+    flush (buffer);
+    rows_read_ += rows;
+
+    return !done_;
+}
+
+void MySQLStatementReader::flush (Buffer& buffer)
+{
+    if (!count_)
+        return;
+
+    for (auto& reader : readers_)
+        reader->flush(buffer, count_);
+
+    count_ = 0;
+}
+
+void MySQLStatementReader::throwError (const std::string& message)
+{
+    logerr << "MySQLStatementReader: " << message << ": " << mysql_stmt_error(statement_);
+    throw std::runtime_error ("MySQLStatementReader: "+message+": "+std::string(mysql_stmt_error(statement_)));
+}
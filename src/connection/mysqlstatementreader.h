@@ -0,0 +1,83 @@
+/*
+ * This file is part of ATSDB.
+ *
+ * ATSDB is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * ATSDB is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with ATSDB.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef MYSQLSTATEMENTREADER_H_
+#define MYSQLSTATEMENTREADER_H_
+
+#include <mysql.h>
+#include <memory>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#include "buffer.h"
+
+/**
+ * @brief Reads the result of an SQL query through a MySQL server-side cursor into Buffers column by column
+ *
+ * Uses the binary prepared statement protocol with a read-only cursor, result values are fetched into bound
+ * fixed-width slots per column without string conversion. Values of up to BLOCK_SIZE rows are staged per column
+ * and appended to the containers in bulk, Null cells included. Usable for all buffers created from the
+ * PropertyList of the first one.
+ */
+class MySQLStatementReader
+{
+public:
+    /// @brief Constructor, prepares and executes sql on connection, buffer is used to resolve the column handles
+    MySQLStatementReader (MYSQL* connection, const std::string& sql, Buffer& buffer);
+    /// @brief Destructor, closes the statement and its cursor
+    virtual ~MySQLStatementReader ();
+
+    /// @brief Appends up to max_rows rows to buffer, all if 0. Returns false if the result is read completely.
+    bool read (Buffer& buffer, size_t max_rows);
+
+    /// @brief Returns number of rows read so far
+    size_t rowsRead () const { return rows_read_; }
+
+    static const size_t BLOCK_SIZE = 1024;
+
+    /// Type of the is_null flag in MYSQL_BIND, differs between client library versions
+    typedef std::remove_pointer<decltype(MYSQL_BIND::is_null)>::type NullFlag;
+
+    /// @brief Staging reader of one result column
+    class ColumnReader
+    {
+    public:
+        virtual ~ColumnReader() {}
+
+        /// @brief Sets output slot of column in bind
+        virtual void bind (MYSQL_BIND& bind) = 0;
+        /// @brief Stages fetched value at row, returns true if bind was changed to fit a truncated value
+        virtual bool read (MYSQL_STMT* statement, MYSQL_BIND& bind, unsigned int column, size_t row) = 0;
+        virtual void flush (Buffer& buffer, size_t count) = 0;
+    };
+
+private:
+    MYSQL_STMT* statement_ {nullptr};
+    std::vector<MYSQL_BIND> binds_;
+    std::vector<std::unique_ptr<ColumnReader>> readers_;
+    /// Number of staged rows
+    size_t count_ {0};
+    size_t rows_read_ {0};
+    bool done_ {false};
+
+    void flush (Buffer& buffer);
+    void throwError (const std::string& message);
+};
+
+#endif /* MYSQLSTATEMENTREADER_H_ */
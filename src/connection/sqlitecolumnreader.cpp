@@ -0,0 +1,165 @@
+/*
+ * This file is part of ATSDB.
+ *
+ * ATSDB is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * ATSDB is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with ATSDB.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include "sqlitecolumnreader.h"
+#include "property.h"
+#include "logger.h"
+
+namespace
+{
+
+template <typename T> inline T columnValue (sqlite3_stmt* statement, int column)
+{
+    return static_cast<T> (sqlite3_column_int64(statement, column));
+}
+
+template <> inline float columnValue<float> (sqlite3_stmt* statement, int column)
+{
+    return static_cast<float> (sqlite3_column_double(statement, column));
+}
+
+template <> inline double columnValue<double> (sqlite3_stmt* statement, int column)
+{
+    return sqlite3_column_double(statement, column);
+}
+
+template <typename T> class TypedColumnWriter : public SQLiteColumnReader::ColumnWriter
+{
+public:
+    TypedColumnWriter (ColumnHandle<T> handle)
+        : handle_(handle), values_(new T[SQLiteColumnReader::BLOCK_SIZE]()),
+          validity_(SQLiteColumnReader::BLOCK_SIZE / NullableVector<T>::VALIDITY_WORD_BITS, 0) {}
+
+    virtual void read (sqlite3_stmt* statement, int column, size_t row)
+    {
+        if (sqlite3_column_type(statement, column) == SQLITE_NULL)
+        {
+            values_[row] = T(); // no stale value from a previous block
+            has_null_ = true;
+            return;
+        }
+
+        assign (statement, column, values_[row]);
+        validity_[row / NullableVector<T>::VALIDITY_WORD_BITS] |=
+                uint64_t(1) << (row % NullableVector<T>::VALIDITY_WORD_BITS);
+    }
+
+    virtual void flush (Buffer& buffer, size_t count)
+    {
+        buffer.get<T>(handle_).append(values_.get(), has_null_ ? validity_.data() : nullptr, count);
+
+        std::fill (validity_.begin(), validity_.end(), 0);
+        has_null_ = false;
+    }
+
+private:
+    ColumnHandle<T> handle_;
+    std::unique_ptr<T[]> values_;
+    std::vector<uint64_t> validity_;
+    bool has_null_ {false};
+
+    void assign (sqlite3_stmt* statement, int column, T& value) { value = columnValue<T>(statement, column); }
+};
+
+template <> void TypedColumnWriter<std::string>::assign (sqlite3_stmt* statement, int column, std::string& value)
+{
+    // text before bytes, as documented for sqlite3_column_bytes
+    const char* text = reinterpret_cast<const char*> (sqlite3_column_text(statement, column));
+    value.assign (text, sqlite3_column_bytes(statement, column)); // keeps capacity of staged string
+}
+
+template <typename T> std::unique_ptr<SQLiteColumnReader::ColumnWriter> createWriter (Buffer& buffer,
+                                                                                     const std::string& name)
+{
+    return std::unique_ptr<SQLiteColumnReader::ColumnWriter> (new TypedColumnWriter<T> (buffer.handle<T>(name)));
+}
+
+}
+
+SQLiteColumnReader::SQLiteColumnReader (sqlite3_stmt* statement, Buffer& buffer)
+    : statement_(statement)
+{
+    assert (statement_);
+
+    const PropertyList& list = buffer.properties();
+    assert ((size_t) sqlite3_column_count(statement_) >= list.size());
+
+    for (unsigned int cnt=0; cnt < list.size(); ++cnt)
+    {
+        const Property& property = list.at(cnt);
+
+        switch (property.dataType())
+        {
+        case PropertyDataType::BOOL:
+            writers_.push_back(createWriter<bool>(buffer, property.name()));
+            break;
+        case PropertyDataType::CHAR:
+            writers_.push_back(createWriter<char>(buffer, property.name()));
+            break;
+        case PropertyDataType::UCHAR:
+            writers_.push_back(createWriter<unsigned char>(buffer, property.name()));
+            break;
+        case PropertyDataType::INT:
+            writers_.push_back(createWriter<int>(buffer, property.name()));
+            break;
+        case PropertyDataType::UINT:
+            writers_.push_back(createWriter<unsigned int>(buffer, property.name()));
+            break;
+        case PropertyDataType::LONGINT:
+            writers_.push_back(createWriter<long int>(buffer, property.name()));
+            break;
+        case PropertyDataType::ULONGINT:
+            writers_.push_back(createWriter<unsigned long int>(buffer, property.name()));
+            break;
+        case PropertyDataType::FLOAT:
+            writers_.push_back(createWriter<float>(buffer, property.name()));
+            break;
+        case PropertyDataType::DOUBLE:
+            writers_.push_back(createWriter<double>(buffer, property.name()));
+            break;
+        case PropertyDataType::STRING:
+            writers_.push_back(createWriter<std::string>(buffer, property.name()));
+            break;
+        default:
+            logerr  <<  "SQLiteColumnReader: constructor: unknown property type "
+                     << Property::asString(property.dataType());
+            throw std::runtime_error ("SQLiteColumnReader: constructor: unknown property type "
+                                      +Property::asString(property.dataType()));
+        }
+    }
+}
+
+void SQLiteColumnReader::readRow (Buffer& buffer)
+{
+    for (unsigned int cnt=0; cnt < writers_.size(); ++cnt)
+        writers_[cnt]->read(statement_, cnt, count_);
+
+    if (++count_ == BLOCK_SIZE)
+        flush (buffer);
+}
+
+void SQLiteColumnReader::flush (Buffer& buffer)
+{
+    if (!count_)
+        return;
+
+    for (auto& writer : writers_)
+        writer->flush(buffer, count_);
+
+    count_ = 0;
+}
@@ -0,0 +1,65 @@
+/*
+ * This file is part of ATSDB.
+ *
+ * ATSDB is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * ATSDB is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with ATSDB.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef SQLITECOLUMNREADER_H_
+#define SQLITECOLUMNREADER_H_
+
+#include <sqlite3.h>
+#include <memory>
+#include <vector>
+
+#include "buffer.h"
+
+/**
+ * @brief Reads result rows of a prepared SQLite statement into a Buffer column by column
+ *
+ * Resolves a ColumnHandle and a typed writer per result column once, stages values of up to BLOCK_SIZE rows
+ * per column and appends them to the containers in bulk, Null cells included. Usable for all buffers created
+ * from the PropertyList of the first one.
+ */
+class SQLiteColumnReader
+{
+public:
+    /// @brief Constructor, buffer is used to resolve the column handles
+    SQLiteColumnReader (sqlite3_stmt* statement, Buffer& buffer);
+
+    /// @brief Stages the current row of the statement, appends to buffer when the block is full
+    void readRow (Buffer& buffer);
+    /// @brief Appends all staged rows to buffer
+    void flush (Buffer& buffer);
+
+    static const size_t BLOCK_SIZE = 1024;
+
+    /// @brief Staging writer of one result column
+    class ColumnWriter
+    {
+    public:
+        virtual ~ColumnWriter() {}
+
+        virtual void read (sqlite3_stmt* statement, int column, size_t row) = 0;
+        virtual void flush (Buffer& buffer, size_t count) = 0;
+    };
+
+private:
+    sqlite3_stmt* statement_;
+    std::vector<std::unique_ptr<ColumnWriter>> writers_;
+    /// Number of staged rows
+    size_t count_ {0};
+};
+
+#endif /* SQLITECOLUMNREADER_H_ */
@@ -16,6 +16,10 @@
  */
 
 #include <cstring>
+#include <algorithm>
+
+#include <QFileInfo>
+#include <QDateTime>
 
 #include "property.h"
 #include "buffer.h"
@@ -25,6 +29,9 @@
 #include "logger.h"
 #include "sqlitefile.h"
 #include "sqliteconnection.h"
+#include "sqlitecolumnreader.h"
+#include "sqlitepartitionreader.h"
+#include "sqlitereadhandlepool.h"
 #include "sqliteconnectionwidget.h"
 #include "sqliteconnectioninfowidget.h"
 #include "dbinterface.h"
@@ -37,6 +44,18 @@ SQLiteConnection::SQLiteConnection(const std::string &class_id, const std::strin
 {
     registerParameter("last_filename", &last_filename_, "");
 
+    registerParameter("page_size", &page_size_, 4096);
+    registerParameter("cache_size_kb", &cache_size_kb_, 65536);
+    registerParameter("mmap_size_mb", &mmap_size_mb_, 0);
+    registerParameter("journal_mode", &journal_mode_, "OFF");
+    registerParameter("synchronous", &synchronous_, "OFF");
+    registerParameter("temp_store", &temp_store_, "DEFAULT");
+    registerParameter("locking_mode", &locking_mode_, "NORMAL");
+
+    registerParameter("bulk_synchronous", &bulk_synchronous_, "OFF");
+    registerParameter("bulk_cache_size_kb", &bulk_cache_size_kb_, 262144);
+    registerParameter("bulk_temp_store", &bulk_temp_store_, "MEMORY");
+
     createSubConfigurables();
 }
 
@@ -57,6 +76,8 @@ void SQLiteConnection::openFile (const std::string &file_name)
     last_filename_=file_name;
     assert (last_filename_.size() > 0);
 
+    bool created = !QFileInfo::exists(QString::fromStdString(last_filename_));
+
     int result = sqlite3_open_v2(last_filename_.c_str(), &db_handle_, SQLITE_OPEN_READWRITE | SQLITE_OPEN_CREATE, NULL);
 
     if (result != SQLITE_OK)
@@ -67,9 +88,11 @@ void SQLiteConnection::openFile (const std::string &file_name)
         sqlite3_close(db_handle_);
         throw std::runtime_error ("SQLiteConnection: openFile: error");
     }
-    char * sErrMsg = 0;
-    sqlite3_exec(db_handle_, "PRAGMA synchronous = OFF", NULL, NULL, &sErrMsg);
-    sqlite3_exec(db_handle_, "PRAGMA journal_mode = OFF", NULL, NULL, &sErrMsg);
+
+    applyProfile(created);
+    sqlite3_busy_timeout(db_handle_, 60000); // writes wait for readers on own handles
+
+    read_handles_.reset(new SQLiteReadHandlePool (last_filename_));
 
     connection_ready_ = true;
 
@@ -83,6 +106,7 @@ void SQLiteConnection::disconnect()
     loginf << "SQLiteConnection: disconnect";
 
     connection_ready_ = false;
+    read_handles_ = nullptr; // closed with the last reader using them
 
     if (widget_)
     {
@@ -98,6 +122,8 @@ void SQLiteConnection::disconnect()
 
     if (db_handle_)
     {
+        clearBindStatements();
+        clearReadStatements();
         sqlite3_close(db_handle_);
         db_handle_=nullptr;
     }
@@ -122,6 +148,17 @@ void SQLiteConnection::executeSQL(const std::string &sql)
 
 void SQLiteConnection::prepareBindStatement (const std::string &statement)
 {
+    auto it = bind_statements_.find(statement);
+
+    if (it != bind_statements_.end()) // reset by finalizeBindStatement
+    {
+        statement_ = it->second;
+        return;
+    }
+
+    if (bind_statements_.size() >= MAX_BIND_STATEMENTS)
+        clearBindStatements();
+
     const char * tail = 0;
     int ret=sqlite3_prepare_v2(db_handle_, statement.c_str(), statement.size(), &statement_, &tail);
 
@@ -130,6 +167,8 @@ void SQLiteConnection::prepareBindStatement (const std::string &statement)
         logerr  << "DBInterface: prepareBindStatement: error preparing bind";
         return;
     }
+
+    bind_statements_[statement] = statement_;
 }
 void SQLiteConnection::beginBindTransaction ()
 {
@@ -169,7 +208,29 @@ void SQLiteConnection::endBindTransaction ()
 }
 void SQLiteConnection::finalizeBindStatement ()
 {
-    sqlite3_finalize(statement_);
+    // kept in bind_statements_
+    sqlite3_clear_bindings(statement_);
+    sqlite3_reset(statement_);
+}
+
+void SQLiteConnection::clearBindStatements ()
+{
+    logdbg  << "SQLiteConnection: clearBindStatements: " << bind_statements_.size();
+
+    for (auto& it : bind_statements_)
+        sqlite3_finalize(it.second);
+
+    bind_statements_.clear();
+}
+
+void SQLiteConnection::clearReadStatements ()
+{
+    logdbg  << "SQLiteConnection: clearReadStatements: " << read_statements_.size();
+
+    for (auto& it : read_statements_)
+        sqlite3_finalize(it.second);
+
+    read_statements_.clear();
 }
 
 void SQLiteConnection::bindVariable (unsigned int index, int value)
@@ -193,6 +254,12 @@ void SQLiteConnection::bindVariableNull (unsigned int index)
     sqlite3_bind_null(statement_, index);
 }
 
+unsigned int SQLiteConnection::maxBindVariables () const
+{
+    assert (db_handle_);
+    return sqlite3_limit(db_handle_, SQLITE_LIMIT_VARIABLE_NUMBER, -1);
+}
+
 // TODO: beware of se deleted propertylist, new buffer should use deep copied list
 std::shared_ptr <DBResult> SQLiteConnection::execute (const DBCommand &command)
 {
@@ -265,23 +332,18 @@ void SQLiteConnection::execute (const std::string &command, std::shared_ptr <Buf
     logdbg  << "SQLiteConnection: execute";
 
     assert (buffer);
-    unsigned int num_properties=0;
-
-    const PropertyList &list = buffer->properties();
-    num_properties = list.size();
-
-    unsigned int cnt=buffer->size();
 
     int result;
 
     prepareStatement(command.c_str());
 
+    SQLiteColumnReader reader (statement_, *buffer);
+
     // Now step throught the result lines
     for (result = sqlite3_step(statement_); result == SQLITE_ROW; result = sqlite3_step(statement_))
-    {
-        readRowIntoBuffer (list, num_properties, buffer, cnt);
-        cnt++;
-    }
+        reader.readRow(*buffer);
+
+    reader.flush(*buffer);
 
     if (result != SQLITE_DONE)
     {
@@ -292,76 +354,59 @@ void SQLiteConnection::execute (const std::string &command, std::shared_ptr <Buf
     finalizeStatement();
 }
 
-void SQLiteConnection::readRowIntoBuffer (const PropertyList &list, unsigned int num_properties,
-                                          std::shared_ptr <Buffer> buffer, unsigned int index)
+void SQLiteConnection::applyProfile (bool created)
 {
-    for (unsigned int cnt=0; cnt < num_properties; cnt++)
+    loginf << "SQLiteConnection: applyProfile: journal " << journal_mode_ << " synchronous " << synchronous_
+           << " cache " << cache_size_kb_ << " KiB mmap " << mmap_size_mb_ << " MiB temp " << temp_store_
+           << " locking " << locking_mode_;
+
+    if (created) // before first write and journal mode
+        setPragma("page_size", std::to_string(page_size_));
+
+    setPragma("journal_mode", journal_mode_, {"DELETE", "TRUNCATE", "PERSIST", "MEMORY", "WAL", "OFF"});
+    setPragma("synchronous", synchronous_, {"OFF", "NORMAL", "FULL", "EXTRA"});
+    setPragma("cache_size", "-"+std::to_string(cache_size_kb_)); // negative for KiB
+    setPragma("mmap_size", std::to_string(static_cast<long long>(mmap_size_mb_) * 1024 * 1024));
+    setPragma("temp_store", temp_store_, {"DEFAULT", "FILE", "MEMORY"});
+    setPragma("locking_mode", locking_mode_, {"NORMAL", "EXCLUSIVE"});
+}
+
+void SQLiteConnection::bulkMode (bool bulk)
+{
+    loginf << "SQLiteConnection: bulkMode: " << bulk;
+
+    assert (db_handle_);
+
+    if (bulk)
+    {
+        setPragma("synchronous", bulk_synchronous_, {"OFF", "NORMAL", "FULL", "EXTRA"});
+        setPragma("cache_size", "-"+std::to_string(bulk_cache_size_kb_));
+        setPragma("temp_store", bulk_temp_store_, {"DEFAULT", "FILE", "MEMORY"});
+    }
+    else
     {
-        const Property &prop=list.at(cnt);
+        setPragma("synchronous", synchronous_, {"OFF", "NORMAL", "FULL", "EXTRA"});
+        setPragma("cache_size", "-"+std::to_string(cache_size_kb_));
+        setPragma("temp_store", temp_store_, {"DEFAULT", "FILE", "MEMORY"});
+    }
+}
 
-        switch (prop.dataType())
-        {
-        case PropertyDataType::BOOL:
-            if (sqlite3_column_type(statement_, cnt) != SQLITE_NULL)
-                buffer->get<bool>(prop.name()).set(index, static_cast<bool> (sqlite3_column_int(statement_, cnt)));
-//            else
-//                buffer->get<bool>(prop.name()).setNone(index);
-            //loginf  << "sqlex: bool " << prop->id_ << " val " << *ptr;
-            break;
-        case PropertyDataType::UCHAR:
-            if (sqlite3_column_type(statement_, cnt) != SQLITE_NULL)
-                buffer->get<unsigned char>(prop.name()).set(index, static_cast<unsigned char> (sqlite3_column_int(statement_, cnt)));
-//            else
-//                buffer->get<unsigned char>(prop.name()).setNone(index);
-            //loginf  << "sqlex: uchar " << prop->id_ << " val " << *ptr;
-            break;
-        case PropertyDataType::CHAR:
-            if (sqlite3_column_type(statement_, cnt) != SQLITE_NULL)
-                buffer->get<char>(prop.name()).set(index, static_cast<signed char> (sqlite3_column_int(statement_, cnt)));
-//            else
-//                buffer->get<char>(prop.name()).setNone(index);
-            //loginf  << "sqlex: char " << prop->id_ << " val " << *ptr;
-            break;
-        case PropertyDataType::INT:
-            if (sqlite3_column_type(statement_, cnt) != SQLITE_NULL)
-                buffer->get<int>(prop.name()).set(index, static_cast<int> (sqlite3_column_int(statement_, cnt)));
-//            else
-//                buffer->get<int>(prop.name()).setNone(index);
-            //loginf  << "sqlex: int " << prop->id_ << " val " << *ptr;
-            break;
-        case PropertyDataType::UINT:
-            if (sqlite3_column_type(statement_, cnt) != SQLITE_NULL)
-                buffer->get<unsigned int>(prop.name()).set(index, static_cast<unsigned int> (sqlite3_column_int(statement_, cnt)));
-//            else
-//                buffer->get<unsigned int>(prop.name()).setNone(index);
-            //loginf  << "sqlex: uint " << prop->id_ << " val " << *ptr;
-            break;
-        case PropertyDataType::STRING:
-            if (sqlite3_column_type(statement_, cnt) != SQLITE_NULL)
-                buffer->get<std::string>(prop.name()).set(index, std::string (reinterpret_cast<const char*> (sqlite3_column_text(statement_, cnt))));
-//            else
-//                buffer->get<std::string>(prop.name()).setNone(index);
-            //loginf  << "sqlex: string " << prop->id_ << " val " << *ptr;
-            break;
-        case PropertyDataType::FLOAT:
-            if (sqlite3_column_type(statement_, cnt) != SQLITE_NULL)
-                buffer->get<float>(prop.name()).set(index, static_cast<float> (sqlite3_column_double (statement_, cnt)));
-//            else
-//                buffer->get<float>(prop.name()).setNone(index);
-            //loginf  << "sqlex: float " << prop->id_ << " val " << *ptr;
-            break;
-        case PropertyDataType::DOUBLE:
-            if (sqlite3_column_type(statement_, cnt) != SQLITE_NULL)
-                buffer->get<double>(prop.name()).set(index, static_cast<double> (sqlite3_column_double (statement_, cnt)));
-//            else
-//                buffer->get<double>(prop.name()).setNone(index);
-            //loginf  << "sqlex: double " << prop->id_ << " val " << *ptr;
-            break;
-        default:
-            logerr  <<  "MySQLppConnection: readRowIntoBuffer: unknown property type";
-            throw std::runtime_error ("MySQLppConnection: readRowIntoBuffer: unknown property type");
-            break;
-        }
+void SQLiteConnection::setPragma (const std::string &name, const std::string &value,
+                                  const std::vector<std::string>& allowed)
+{
+    if (allowed.size() && std::find(allowed.begin(), allowed.end(), value) == allowed.end())
+    {
+        logwrn << "SQLiteConnection: setPragma: invalid " << name << " value '" << value << "', not set";
+        return;
+    }
+
+    std::string sql = "PRAGMA "+name+" = "+value;
+    char* error_msg {nullptr};
+
+    if (sqlite3_exec(db_handle_, sql.c_str(), nullptr, nullptr, &error_msg) != SQLITE_OK)
+    {
+        logwrn << "SQLiteConnection: setPragma: '" << sql << "' failed: " << (error_msg ? error_msg : "");
+        sqlite3_free(error_msg);
     }
 }
 
@@ -400,9 +445,47 @@ void SQLiteConnection::prepareCommand (const std::shared_ptr<DBCommand> command)
     prepared_command_=command;
     prepared_command_done_=false;
 
-    prepareStatement (command->get().c_str());
+    auto it = read_statements_.find(command->get());
+
+    if (it != read_statements_.end()) // reset by finalizeCommand
+        statement_ = it->second;
+    else
+    {
+        if (read_statements_.size() >= MAX_READ_STATEMENTS)
+            clearReadStatements();
+
+        prepareStatement (command->get());
+        read_statements_[command->get()] = statement_;
+    }
+
+    sqlite3_clear_bindings(statement_);
+
+    if (SQLitePartitionReader::bindParameters(statement_, *command) != SQLITE_OK)
+    {
+        logerr << "SQLiteConnection: prepareCommand: binding parameters failed: " << sqlite3_errmsg(db_handle_);
+        prepared_command_=nullptr;
+        throw std::runtime_error ("SQLiteConnection: prepareCommand: binding parameters failed");
+    }
+}
+
+bool SQLiteConnection::supportsConcurrentRead () const
+{
+    return connection_ready_ && last_filename_.size() && last_filename_ != ":memory:"
+            && locking_mode_ != "EXCLUSIVE";
 }
-std::shared_ptr <DBResult> SQLiteConnection::stepPreparedCommand (unsigned int max_results)
+
+std::unique_ptr<DBReader> SQLiteConnection::createReader (const std::vector<std::shared_ptr<DBCommand>>& commands)
+{
+    assert (supportsConcurrentRead());
+    assert (commands.size());
+
+    logdbg << "SQLiteConnection: createReader: " << commands.size() << " commands";
+
+    return std::unique_ptr<DBReader> (new SQLitePartitionReader (read_handles_, commands));
+}
+
+std::shared_ptr <DBResult> SQLiteConnection::stepPreparedCommand (unsigned int max_results,
+                                                          std::shared_ptr<BufferPool> buffer_pool)
 {
     assert (prepared_command_);
     assert (!prepared_command_done_);
@@ -410,26 +493,26 @@ std::shared_ptr <DBResult> SQLiteConnection::stepPreparedCommand (unsigned int m
     std::string sql = prepared_command_->get();
     assert (prepared_command_->resultList().size() > 0); // data should be returned
 
-    std::shared_ptr <Buffer> buffer (new Buffer (prepared_command_->resultList()));
+    std::shared_ptr <Buffer> buffer (new Buffer (prepared_command_->resultList(), "", buffer_pool));
     assert (buffer->size() == 0);
     std::shared_ptr <DBResult> dbresult (new DBResult(buffer));
 
-    unsigned int num_properties = buffer->properties().size();
-    const PropertyList &list = buffer->properties();
+    if (!column_reader_) // handles stay valid for all buffers of the result list
+        column_reader_.reset(new SQLiteColumnReader (statement_, *buffer));
 
     unsigned int cnt = 0;
     int result;
     bool done=true;
 
+    if (max_results) // size once instead of growing per row
+        buffer->reserve(max_results);
+
     max_results--;
 
     // Now step throught the result lines
     for (result = sqlite3_step(statement_); result == SQLITE_ROW; result = sqlite3_step(statement_))
     {
-        readRowIntoBuffer (list, num_properties, buffer, cnt);
-
-        if (buffer->size()) // 0 == 1 otherwise
-            assert (buffer->size() == cnt+1);
+        column_reader_->readRow(*buffer);
 
         if (max_results != 0 && cnt >= max_results)
         {
@@ -446,6 +529,8 @@ std::shared_ptr <DBResult> SQLiteConnection::stepPreparedCommand (unsigned int m
         throw std::runtime_error ("SQLiteConnection: stepPreparedCommand: problem while stepping the result");
     }
 
+    column_reader_->flush(*buffer);
+
     assert (buffer->size() <= max_results+1); // because of max_results--
 
     if (result == SQLITE_DONE || buffer->size() == 0 || done)
@@ -463,7 +548,8 @@ std::shared_ptr <DBResult> SQLiteConnection::stepPreparedCommand (unsigned int m
 void SQLiteConnection::finalizeCommand ()
 {
     assert (prepared_command_ != nullptr);
-    sqlite3_finalize(statement_);
+    sqlite3_reset(statement_); // kept in read_statements_
+    column_reader_=nullptr;
     prepared_command_=nullptr; // should be deleted by caller
     prepared_command_done_=true;
 }
@@ -569,6 +655,19 @@ DBTableInfo SQLiteConnection::getColumnList(const std::string &table) // buffer
                               buffer->get<int>("pk").get(cnt) > 0, !buffer->get<int>("notnull").get(cnt), "");
     }
 
+    DBCommand index_command;
+    index_command.set ("SELECT name FROM sqlite_master WHERE type = 'index' AND tbl_name = '"+table+"';");
+    PropertyList index_list;
+    index_list.addProperty ("name", PropertyDataType::STRING);
+    index_command.list (index_list);
+
+    std::shared_ptr <DBResult> index_result = execute(index_command);
+    assert (index_result->containsData());
+    std::shared_ptr <Buffer> index_buffer = index_result->buffer();
+
+    for (unsigned int cnt=0; cnt < index_buffer->size(); cnt++)
+        table_info.addIndex (index_buffer->get<std::string>("name").get(cnt));
+
     return table_info;
 }
 
@@ -626,6 +725,20 @@ std::string SQLiteConnection::identifier () const
     return "SQLite: "+last_filename_;
 }
 
+long long SQLiteConnection::modificationTime () const
+{
+    assert (connection_ready_);
+
+    long long time = QFileInfo (QString::fromStdString(last_filename_)).lastModified().toMSecsSinceEpoch();
+
+    QFileInfo wal_file (QString::fromStdString(last_filename_+"-wal")); // changes not yet checkpointed
+
+    if (wal_file.exists())
+        time = std::max(time, (long long) wal_file.lastModified().toMSecsSinceEpoch());
+
+    return time;
+}
+
 void SQLiteConnection::addFile (const std::string &filename)
 {
     if (file_list_.count (filename) != 0)
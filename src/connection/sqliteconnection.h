@@ -20,6 +20,8 @@
 
 #include <sqlite3.h>
 #include <string>
+#include <memory>
+#include <vector>
 
 #include "dbconnection.h"
 #include "global.h"
@@ -30,6 +32,8 @@ class SQLiteConnectionWidget;
 class SQLiteConnectionInfoWidget;
 class SavedFile;
 class PropertyList;
+class SQLiteColumnReader;
+class SQLiteReadHandlePool;
 
 /**
  * @brief Interface for a SQLite3 database connection
@@ -57,15 +61,21 @@ public:
     void bindVariable (unsigned int index, double value);
     void bindVariable (unsigned int index, const std::string &value);
     void bindVariableNull (unsigned int index);
+    unsigned int maxBindVariables () const override;
 
     std::shared_ptr <DBResult> execute (const DBCommand &command);
     std::shared_ptr <DBResult> execute (const DBCommandList &command_list);
 
     void prepareCommand (const std::shared_ptr<DBCommand> command);
-    std::shared_ptr <DBResult> stepPreparedCommand (unsigned int max_results=0);
+    std::shared_ptr <DBResult> stepPreparedCommand (unsigned int max_results=0,
+                                                    std::shared_ptr<BufferPool> buffer_pool=nullptr);
     void finalizeCommand ();
     bool getPreparedCommandDone () { return prepared_command_done_; }
 
+    bool supportsParameters () const override { return true; }
+    bool supportsConcurrentRead () const override;
+    std::unique_ptr<DBReader> createReader (const std::vector<std::shared_ptr<DBCommand>>& commands) override;
+
     std::map <std::string, DBTableInfo> getTableInfo ();
     virtual std::vector <std::string> getDatabases();
 
@@ -76,6 +86,8 @@ public:
     std::string status () const;
     std::string identifier () const;
     std::string type () const override { return SQLITE_IDENTIFIER; }
+    long long modificationTime () const override;
+    void bulkMode (bool bulk) override;
 
     const std::map <std::string, SavedFile*> &fileList () { return file_list_; }
     bool hasFile (const std::string &filename) { return file_list_.count (filename) > 0; }
@@ -92,21 +104,62 @@ protected:
     sqlite3* db_handle_;
     /// Statement for binding variables to.
     sqlite3_stmt *statement_;
+    /// Prepared bind statements by SQL, reset instead of finalized for reuse
+    std::map <std::string, sqlite3_stmt*> bind_statements_;
+    static const size_t MAX_BIND_STATEMENTS = 64;
+    /// Prepared read statements by SQL on db_handle_, used if concurrent reads are not supported
+    std::map <std::string, sqlite3_stmt*> read_statements_;
+    static const size_t MAX_READ_STATEMENTS = 32;
+    /// Read-only handles with prepared statements for concurrent readers of last_filename_
+    std::shared_ptr<SQLiteReadHandlePool> read_handles_;
 
     std::shared_ptr<DBCommand> prepared_command_;
     bool prepared_command_done_;
+    /// Reader of the prepared command, created with its first result buffer
+    std::unique_ptr<SQLiteColumnReader> column_reader_;
 
     SQLiteConnectionWidget *widget_;
     SQLiteConnectionInfoWidget *info_widget_;
 
     std::map <std::string, SavedFile*> file_list_;
 
+    // session profile, applied as pragmas when opening a file
+
+    /// Page size in bytes, only used when creating a file
+    unsigned int page_size_;
+    /// Page cache size in KiB
+    unsigned int cache_size_kb_;
+    /// Memory mapped I/O size in MiB, 0 to disable
+    unsigned int mmap_size_mb_;
+    /// DELETE, TRUNCATE, PERSIST, MEMORY, WAL or OFF. WAL lets readers on own handles run during writes
+    std::string journal_mode_;
+    /// OFF, NORMAL, FULL or EXTRA
+    std::string synchronous_;
+    /// DEFAULT, FILE or MEMORY
+    std::string temp_store_;
+    /// NORMAL or EXCLUSIVE, EXCLUSIVE disables concurrent reads
+    std::string locking_mode_;
+
+    /// Bulk profile, replaces synchronous, cache size and temp store while in bulk mode
+    std::string bulk_synchronous_;
+    unsigned int bulk_cache_size_kb_;
+    std::string bulk_temp_store_;
+
     void execute (const std::string &command);
     void execute (const std::string &command, std::shared_ptr <Buffer> buffer);
-    void readRowIntoBuffer (const PropertyList &list, unsigned int num_properties, std::shared_ptr <Buffer> buffer, unsigned int index);
 
     void prepareStatement (const std::string &sql);
     void finalizeStatement ();
+    /// @brief Finalizes all cached bind statements
+    void clearBindStatements ();
+    /// @brief Finalizes all cached read statements
+    void clearReadStatements ();
+
+    /// @brief Applies session profile, page size only if created
+    void applyProfile (bool created);
+    /// @brief Executes pragma if value is one of allowed, warns otherwise
+    void setPragma (const std::string &name, const std::string &value,
+                    const std::vector<std::string>& allowed=std::vector<std::string>());
 
     std::vector<std::string> getTableList();
     DBTableInfo getColumnList(const std::string &table);
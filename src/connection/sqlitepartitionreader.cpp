@@ -0,0 +1,231 @@
+/*
+ * This file is part of ATSDB.
+ *
+ * ATSDB is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * ATSDB is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with ATSDB.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include <cassert>
+#include <stdexcept>
+
+#include "sqlitepartitionreader.h"
+#include "sqlitecolumnreader.h"
+#include "dbcommand.h"
+#include "buffer.h"
+#include "logger.h"
+
+SQLitePartitionReader::SQLitePartitionReader (std::shared_ptr<SQLiteReadHandlePool> handles,
+                                              const std::vector<std::shared_ptr<DBCommand>>& commands)
+    : handles_(handles)
+{
+    assert (handles_);
+    assert (commands.size());
+
+    properties_ = commands.front()->resultList();
+
+    for (auto& command : commands)
+    {
+        assert (command->resultList().size() == properties_.size());
+
+        partitions_.emplace_back(new Partition ());
+        partitions_.back()->command_ = command;
+    }
+}
+
+SQLitePartitionReader::~SQLitePartitionReader()
+{
+    {
+        std::lock_guard<std::mutex> lock (mutex_);
+        stop_ = true;
+    }
+
+    condition_.notify_all(); // wakes blocked pushes
+
+    for (auto& partition : partitions_)
+        if (partition->thread_.joinable())
+            partition->thread_.join();
+}
+
+std::shared_ptr<Buffer> SQLitePartitionReader::next (unsigned int chunk_size,
+                                                     std::shared_ptr<BufferPool> buffer_pool)
+{
+    if (!started_)
+    {
+        logdbg << "SQLitePartitionReader: next: starting " << partitions_.size() << " partitions";
+
+        for (auto& partition : partitions_)
+            partition->thread_ = std::thread (&SQLitePartitionReader::read, this, std::ref(*partition),
+                                              chunk_size, buffer_pool);
+        started_ = true;
+    }
+
+    std::unique_lock<std::mutex> lock (mutex_);
+
+    while (true)
+    {
+        Partition& partition = *partitions_.at(current_);
+
+        condition_.wait(lock, [&partition] { return partition.buffers_.size() || partition.done_; });
+
+        if (partition.error_.size())
+        {
+            logerr << "SQLitePartitionReader: next: partition " << current_ << " failed: " << partition.error_;
+            throw std::runtime_error ("SQLitePartitionReader: next: partition failed: "+partition.error_);
+        }
+
+        bool last_partition = current_+1 == partitions_.size();
+
+        if (partition.buffers_.size())
+        {
+            std::shared_ptr<Buffer> buffer = partition.buffers_.front();
+            partition.buffers_.pop_front();
+            condition_.notify_all(); // space in queue
+
+            if (partition.done_ && partition.buffers_.empty())
+            {
+                if (last_partition)
+                    buffer->lastOne(true);
+                else
+                    ++current_;
+            }
+
+            return buffer;
+        }
+
+        if (last_partition) // done without further data
+        {
+            std::shared_ptr<Buffer> buffer {new Buffer (properties_, "", buffer_pool)};
+            buffer->lastOne(true);
+            return buffer;
+        }
+
+        ++current_;
+    }
+}
+
+int SQLitePartitionReader::bindParameters (sqlite3_stmt* statement, const DBCommand& command)
+{
+    int index = 1;
+    int result = SQLITE_OK;
+
+    for (auto& parameter : command.parameters())
+    {
+        if (parameter.data_type_ == PropertyDataType::LONGINT)
+            result = sqlite3_bind_int64(statement, index, std::stoll(parameter.value_));
+        else if (parameter.data_type_ == PropertyDataType::DOUBLE)
+            result = sqlite3_bind_double(statement, index, std::stod(parameter.value_));
+        else
+        {
+            assert (parameter.data_type_ == PropertyDataType::STRING);
+            result = sqlite3_bind_text(statement, index, parameter.value_.c_str(), parameter.value_.size(),
+                                       SQLITE_TRANSIENT);
+        }
+
+        if (result != SQLITE_OK)
+            break;
+
+        ++index;
+    }
+
+    return result;
+}
+
+void SQLitePartitionReader::read (Partition& partition, unsigned int chunk_size,
+                                  std::shared_ptr<BufferPool> buffer_pool)
+{
+    std::unique_ptr<SQLiteReadHandlePool::Handle> handle;
+    sqlite3_stmt* statement {nullptr};
+    const std::string& sql = partition.command_->get();
+    bool keep = partitions_.size() == 1; // partition commands are not repeated
+    std::string error;
+
+    try
+    {
+        logdbg << "SQLitePartitionReader: read: sql '" << sql << "'";
+
+        handle = handles_->acquire();
+        statement = handle->prepare(sql);
+
+        if (bindParameters(statement, *partition.command_) != SQLITE_OK)
+            throw std::runtime_error (std::string("bind failed: ")+sqlite3_errmsg(handle->handle()));
+
+        std::shared_ptr<Buffer> buffer {new Buffer (properties_, "", buffer_pool)};
+        SQLiteColumnReader reader (statement, *buffer);
+        unsigned int rows = 0;
+        int result;
+
+        if (chunk_size)
+            buffer->reserve(chunk_size);
+
+        for (result = sqlite3_step(statement); result == SQLITE_ROW && !stop_; result = sqlite3_step(statement))
+        {
+            reader.readRow(*buffer);
+
+            if (chunk_size && ++rows == chunk_size)
+            {
+                reader.flush(*buffer);
+                push (partition, buffer);
+
+                buffer.reset(new Buffer (properties_, "", buffer_pool));
+                buffer->reserve(chunk_size);
+                rows = 0;
+            }
+        }
+
+        if (result != SQLITE_ROW && result != SQLITE_DONE)
+            throw std::runtime_error (std::string("step failed: ")+sqlite3_errmsg(handle->handle()));
+
+        reader.flush(*buffer);
+
+        if (buffer->size())
+            push (partition, buffer);
+    }
+    catch (std::exception& e)
+    {
+        error = e.what();
+    }
+
+    if (handle)
+    {
+        handle->finish(sql, statement, keep && error.empty());
+
+        if (error.empty())
+            handles_->release(std::move(handle));
+        else
+            handle.reset(); // closed, may be in a failed state
+    }
+
+    {
+        std::lock_guard<std::mutex> lock (mutex_);
+        partition.done_ = true;
+        partition.error_ = error;
+    }
+
+    condition_.notify_all();
+}
+
+void SQLitePartitionReader::push (Partition& partition, std::shared_ptr<Buffer> buffer)
+{
+    {
+        std::unique_lock<std::mutex> lock (mutex_);
+        condition_.wait(lock, [this, &partition] { return partition.buffers_.size() < MAX_QUEUED_BUFFERS || stop_; });
+
+        if (stop_)
+            return;
+
+        partition.buffers_.push_back(buffer);
+    }
+
+    condition_.notify_all();
+}
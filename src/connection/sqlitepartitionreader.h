@@ -0,0 +1,94 @@
+/*
+ * This file is part of ATSDB.
+ *
+ * ATSDB is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * ATSDB is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with ATSDB.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef SQLITEPARTITIONREADER_H_
+#define SQLITEPARTITIONREADER_H_
+
+#include <sqlite3.h>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "propertylist.h"
+#include "dbreader.h"
+#include "sqlitereadhandlepool.h"
+
+class Buffer;
+class BufferPool;
+class DBCommand;
+
+/**
+ * @brief Reads a number of partition commands concurrently on own read-only handles of a SQLite file
+ *
+ * One thread per command steps its result into buffers of chunk size, which are returned in command order,
+ * so the partitions of one read are merged as if read back to back. Each thread waits while its partition
+ * holds MAX_QUEUED_BUFFERS unreturned buffers. Handles are taken from and given back to a pool; for a single
+ * command the prepared statement is kept on its handle, partition commands change with the table contents.
+ */
+class SQLitePartitionReader : public DBReader
+{
+public:
+    /// @brief Constructor, commands must have the same result list
+    SQLitePartitionReader (std::shared_ptr<SQLiteReadHandlePool> handles,
+                           const std::vector<std::shared_ptr<DBCommand>>& commands);
+    /// @brief Destructor, stops and joins all threads
+    virtual ~SQLitePartitionReader();
+
+    /// @brief Returns next buffer in command order, blocks until available, last one is flagged
+    ///
+    /// Threads are started on the first call with chunk_size and buffer_pool.
+    std::shared_ptr<Buffer> next (unsigned int chunk_size, std::shared_ptr<BufferPool> buffer_pool) override;
+
+    /// @brief Binds parameters of command to statement, returns SQLite result code
+    static int bindParameters (sqlite3_stmt* statement, const DBCommand& command);
+
+    /// Maximum number of read buffers queued per partition
+    static const size_t MAX_QUEUED_BUFFERS = 2;
+
+private:
+    struct Partition
+    {
+        std::shared_ptr<DBCommand> command_;
+        std::deque<std::shared_ptr<Buffer>> buffers_;
+        bool done_ {false};
+        std::string error_;
+        std::thread thread_;
+    };
+
+    std::shared_ptr<SQLiteReadHandlePool> handles_;
+    PropertyList properties_;
+    std::vector<std::unique_ptr<Partition>> partitions_;
+    /// Index of partition buffers are returned from
+    size_t current_ {0};
+    bool started_ {false};
+
+    std::mutex mutex_;
+    std::condition_variable condition_;
+    std::atomic<bool> stop_ {false};
+
+    void read (Partition& partition, unsigned int chunk_size, std::shared_ptr<BufferPool> buffer_pool);
+    /// @brief Queues buffer, blocks while partition queue is full
+    void push (Partition& partition, std::shared_ptr<Buffer> buffer);
+};
+
+#endif /* SQLITEPARTITIONREADER_H_ */
@@ -0,0 +1,124 @@
+/*
+ * This file is part of ATSDB.
+ *
+ * ATSDB is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * ATSDB is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with ATSDB.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include <cassert>
+#include <stdexcept>
+
+#include "sqlitereadhandlepool.h"
+#include "logger.h"
+
+SQLiteReadHandlePool::Handle::~Handle()
+{
+    for (auto& it : statements_)
+        sqlite3_finalize(it.second);
+
+    sqlite3_close(handle_);
+}
+
+sqlite3_stmt* SQLiteReadHandlePool::Handle::prepare (const std::string& sql)
+{
+    auto it = statements_.find(sql);
+
+    if (it != statements_.end()) // reset by finish
+    {
+        sqlite3_stmt* statement = it->second;
+        statements_.erase(it); // kept again by finish
+        return statement;
+    }
+
+    sqlite3_stmt* statement {nullptr};
+
+    if (sqlite3_prepare_v2(handle_, sql.c_str(), sql.size(), &statement, nullptr) != SQLITE_OK)
+    {
+        sqlite3_finalize(statement);
+        throw std::runtime_error (std::string("prepare failed: ")+sqlite3_errmsg(handle_));
+    }
+
+    return statement;
+}
+
+void SQLiteReadHandlePool::Handle::finish (const std::string& sql, sqlite3_stmt* statement, bool keep)
+{
+    if (!statement)
+        return;
+
+    if (!keep)
+    {
+        sqlite3_finalize(statement);
+        return;
+    }
+
+    sqlite3_reset(statement);
+    sqlite3_clear_bindings(statement);
+
+    if (statements_.size() >= MAX_STATEMENTS)
+    {
+        logdbg << "SQLiteReadHandlePool: Handle: finish: clearing " << statements_.size() << " statements";
+
+        for (auto& it : statements_)
+            sqlite3_finalize(it.second);
+
+        statements_.clear();
+    }
+
+    statements_[sql] = statement;
+}
+
+SQLiteReadHandlePool::SQLiteReadHandlePool (const std::string& file_name)
+    : file_name_(file_name)
+{
+    assert (file_name_.size());
+}
+
+std::unique_ptr<SQLiteReadHandlePool::Handle> SQLiteReadHandlePool::acquire ()
+{
+    {
+        std::lock_guard<std::mutex> lock (mutex_);
+
+        if (handles_.size())
+        {
+            std::unique_ptr<Handle> handle = std::move(handles_.back());
+            handles_.pop_back();
+            return handle;
+        }
+    }
+
+    sqlite3* handle {nullptr};
+
+    if (sqlite3_open_v2(file_name_.c_str(), &handle, SQLITE_OPEN_READONLY | SQLITE_OPEN_NOMUTEX, nullptr)
+            != SQLITE_OK)
+    {
+        std::string error = std::string("open failed: ")+sqlite3_errmsg(handle);
+        sqlite3_close(handle);
+        throw std::runtime_error (error);
+    }
+
+    sqlite3_busy_timeout(handle, 60000);
+
+    return std::unique_ptr<Handle> (new Handle (handle));
+}
+
+void SQLiteReadHandlePool::release (std::unique_ptr<Handle> handle)
+{
+    assert (handle);
+
+    std::lock_guard<std::mutex> lock (mutex_);
+
+    if (handles_.size() < MAX_HANDLES)
+        handles_.push_back(std::move(handle));
+}
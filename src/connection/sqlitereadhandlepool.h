@@ -0,0 +1,80 @@
+/*
+ * This file is part of ATSDB.
+ *
+ * ATSDB is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * ATSDB is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with ATSDB.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef SQLITEREADHANDLEPOOL_H_
+#define SQLITEREADHANDLEPOOL_H_
+
+#include <sqlite3.h>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+/**
+ * @brief Keeps idle read-only handles of a SQLite file with their prepared statements
+ *
+ * Handles are taken by readers with acquire and given back with release, so repeated reads of the same
+ * command skip opening the file and preparing the statement. Handles not given back are closed by their owner.
+ */
+class SQLiteReadHandlePool
+{
+public:
+    /// @brief Read-only handle with statements kept for reuse
+    class Handle
+    {
+    public:
+        Handle (sqlite3* handle) : handle_(handle) {}
+        /// @brief Destructor, finalizes kept statements and closes handle
+        ~Handle();
+
+        sqlite3* handle () { return handle_; }
+
+        /// @brief Returns kept statement for sql or prepares a new one, throws on error
+        sqlite3_stmt* prepare (const std::string& sql);
+        /// @brief Resets and keeps statement for sql if keep is set, finalizes it otherwise
+        void finish (const std::string& sql, sqlite3_stmt* statement, bool keep);
+
+        /// Maximum number of statements kept per handle
+        static const size_t MAX_STATEMENTS = 32;
+
+    private:
+        sqlite3* handle_;
+        std::map<std::string, sqlite3_stmt*> statements_;
+    };
+
+    SQLiteReadHandlePool (const std::string& file_name);
+
+    const std::string& fileName () const { return file_name_; }
+
+    /// @brief Returns idle handle or opens a new one, throws on error
+    std::unique_ptr<Handle> acquire ();
+    /// @brief Keeps handle for later reads, closes it if MAX_HANDLES are idle already
+    void release (std::unique_ptr<Handle> handle);
+
+    /// Maximum number of idle handles kept
+    static const size_t MAX_HANDLES = 4;
+
+private:
+    std::string file_name_;
+
+    std::mutex mutex_;
+    std::vector<std::unique_ptr<Handle>> handles_;
+};
+
+#endif /* SQLITEREADHANDLEPOOL_H_ */
@@ -15,6 +15,8 @@
  * along with ATSDB.  If not, see <http://www.gnu.org/licenses/>.
  */
 
+#include <algorithm>
+
 #include "atsdb.h"
 #include "datasourcesfilter.h"
 #include "datasourcesfilterwidget.h"
@@ -22,6 +24,9 @@
 #include "dbobjectmanager.h"
 #include "dbobject.h"
 #include "dbovariable.h"
+#include "dbtable.h"
+#include "dbtablecolumn.h"
+#include "metadbtable.h"
 
 #include "stringconv.h"
 
@@ -90,7 +95,8 @@ bool DataSourcesFilter::filters (const std::string& dbo_type)
 }
 
 std::string DataSourcesFilter::getConditionString (const std::string& dbo_name, bool& first,
-                                                   std::vector <DBOVariable*>& filtered_variables)
+                                                   std::vector <DBOVariable*>& filtered_variables,
+                                                   DBCommandParameters* parameters)
 {
     logdbg  << "DataSourcesFilter: getConditionString ";
 
@@ -120,6 +126,7 @@ std::string DataSourcesFilter::getConditionString (const std::string& dbo_name,
             bool got_all=true;
 
             std::stringstream values;
+            DBCommandParameters ds_parameters; // added only if the condition is used
 
             std::map<int, DataSourcesFilterDataSource>::iterator it;
 
@@ -129,7 +136,16 @@ std::string DataSourcesFilter::getConditionString (const std::string& dbo_name,
                 {
                     if (values.str().size() > 0)
                         values << ",";
-                    values << it->first;
+
+                    if (parameters)
+                    {
+                        values << "?";
+                        ds_parameters.push_back(DBCommandParameter (PropertyDataType::LONGINT,
+                                                                    std::to_string(it->first)));
+                    }
+                    else
+                        values << it->first;
+
                     got_one=true;
                 }
                 else
@@ -146,7 +162,12 @@ std::string DataSourcesFilter::getConditionString (const std::string& dbo_name,
 
             //WHERE column_name IN (value1,value2,...)
             if (got_one)
+            {
                 ss << " " <<ds_column_name_ << " IN (" << values.str() << ")";
+
+                if (parameters)
+                    parameters->insert(parameters->end(), ds_parameters.begin(), ds_parameters.end());
+            }
             else
             {
                 ss  << " "+ds_column_name_+" IS NULL";
@@ -161,6 +182,46 @@ std::string DataSourcesFilter::getConditionString (const std::string& dbo_name,
 }
 
 
+bool DataSourcesFilter::getPredicates (const std::string& dbo_name, bool& first,
+                                       std::vector <DBOVariable*>& filtered_variables, SQLPredicates& predicates,
+                                       bool use_parameters)
+{
+    bool condition_first = true;
+    std::vector <DBOVariable*> condition_variables;
+    SQLPredicate predicate;
+
+    predicate.condition_ = getConditionString (dbo_name, condition_first, condition_variables,
+                                               use_parameters ? &predicate.parameters_ : nullptr);
+
+    if (!predicate.condition_.size()) // not filtering
+        return true;
+
+    first = false; // always AND-connected
+
+    predicate.condition_.erase(0, predicate.condition_.find_first_not_of(' '));
+    predicate.variable_ = &object_->variable(ds_column_name_);
+
+    const DBTableColumn& column = predicate.variable_->currentDBColumn();
+    predicate.table_name_ = predicate.variable_->currentMetaTable().tableFor(column.identifier()).name();
+    predicate.null_rejecting_ = predicate.condition_.find("IS NULL") == std::string::npos;
+
+    unsigned int active_cnt = 0;
+
+    for (auto& ds_it : data_sources_)
+        if (ds_it.second.isActiveInFilter())
+            ++active_cnt;
+
+    if (data_sources_.size())
+        predicate.selectivity_ = static_cast<double>(active_cnt) / data_sources_.size();
+
+    if (find (filtered_variables.begin(), filtered_variables.end(), predicate.variable_) == filtered_variables.end())
+        filtered_variables.push_back(predicate.variable_);
+
+    predicates.push_back(predicate);
+
+    return true;
+}
+
 void DataSourcesFilter::updateDataSources ()
 {
     if (!object_->hasDataSources ())
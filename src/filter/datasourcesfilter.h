@@ -104,7 +104,11 @@ public:
   virtual ~DataSourcesFilter();
 
   virtual std::string getConditionString (const std::string& dbo_name, bool& first,
-                                          std::vector <DBOVariable*>& filtered_variables);
+                                          std::vector <DBOVariable*>& filtered_variables,
+                                          DBCommandParameters* parameters=nullptr);
+  virtual bool getPredicates (const std::string& dbo_name, bool& first,
+                              std::vector <DBOVariable*>& filtered_variables, SQLPredicates& predicates,
+                              bool use_parameters);
 
   virtual void generateSubConfigurable (const std::string &class_id, const std::string &instance_id);
 
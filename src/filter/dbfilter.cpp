@@ -194,7 +194,8 @@ bool DBFilter::filters (const std::string &dbo_type)
  * If active, returns concatenated condition strings from all sub-conditions and sub-filters, else returns empty string.
  */
 std::string DBFilter::getConditionString (const std::string &dbo_name, bool &first,
-                                          std::vector <DBOVariable*>& filtered_variables)
+                                          std::vector <DBOVariable*>& filtered_variables,
+                                          DBCommandParameters* parameters)
 {
     assert (!disabled_);
 
@@ -210,13 +211,15 @@ std::string DBFilter::getConditionString (const std::string &dbo_name, bool &fir
                 continue;
             }
 
-            std::string text = conditions_.at(cnt)->getConditionString(dbo_name, first, filtered_variables);
+            std::string text = conditions_.at(cnt)->getConditionString(dbo_name, first, filtered_variables,
+                                                                       parameters);
             ss << text;
         }
 
         for (unsigned int cnt=0; cnt < sub_filters_.size(); cnt ++)
         {
-            std::string text = sub_filters_.at(cnt)->getConditionString(dbo_name, first, filtered_variables);
+            std::string text = sub_filters_.at(cnt)->getConditionString(dbo_name, first, filtered_variables,
+                                                                        parameters);
             ss << text;
         }
     }
@@ -227,6 +230,36 @@ std::string DBFilter::getConditionString (const std::string &dbo_name, bool &fir
     return ss.str();
 }
 
+bool DBFilter::getPredicates (const std::string &dbo_name, bool &first,
+                              std::vector <DBOVariable*>& filtered_variables, SQLPredicates& predicates,
+                              bool use_parameters)
+{
+    assert (!disabled_);
+
+    if (!active_)
+        return true;
+
+    for (unsigned int cnt=0; cnt < conditions_.size(); cnt++)
+    {
+        if (conditions_.at(cnt)->valueInvalid())
+        {
+            logwrn  << "DBFilter " << instanceId() << ": getPredicates: invalid condition, will be skipped";
+            continue;
+        }
+
+        if (!conditions_.at(cnt)->getPredicate(dbo_name, first, filtered_variables, predicates, use_parameters))
+            return false;
+    }
+
+    for (unsigned int cnt=0; cnt < sub_filters_.size(); cnt ++)
+    {
+        if (!sub_filters_.at(cnt)->getPredicates(dbo_name, first, filtered_variables, predicates, use_parameters))
+            return false;
+    }
+
+    return true;
+}
+
 void DBFilter::setAnd (bool op_and)
 {
     assert (!disabled_);
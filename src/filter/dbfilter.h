@@ -21,6 +21,8 @@
 #include <string>
 #include <vector>
 #include "configurable.h"
+#include "dbcommand.h"
+#include "sqlpredicate.h"
 
 class DBFilterWidget;
 class DBFilterCondition;
@@ -72,8 +74,14 @@ public:
     /// @brief Returns the generic flag
     bool isGeneric () { return is_generic_; }
 
-    /// @brief Returns the condition string for a DBObject
-    virtual std::string getConditionString (const std::string &dbo_name, bool &first, std::vector <DBOVariable*>& filtered_variables);
+    /// @brief Returns the condition string for a DBObject, values as placeholders added to parameters if given
+    virtual std::string getConditionString (const std::string &dbo_name, bool &first,
+                                            std::vector <DBOVariable*>& filtered_variables,
+                                            DBCommandParameters* parameters=nullptr);
+    /// @brief Adds the conditions for a DBObject as predicates, returns false if not all AND-connected
+    virtual bool getPredicates (const std::string &dbo_name, bool &first,
+                                std::vector <DBOVariable*>& filtered_variables, SQLPredicates& predicates,
+                                bool use_parameters);
     /// @brief Returns if only sub-filters and no own conditions exist
     bool onlyHasSubFilter () { return conditions_.size()>0; }
 
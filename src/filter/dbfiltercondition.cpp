@@ -15,6 +15,7 @@
  * along with ATSDB.  If not, see <http://www.gnu.org/licenses/>.
  */
 
+#include <algorithm>
 #include <sstream>
 #include <cassert>
 
@@ -24,6 +25,7 @@
 #include <QLabel>
 
 #include <boost/algorithm/string/join.hpp>
+#include <boost/algorithm/string/replace.hpp>
 //#include <boost/algorithm/string.hpp>
 
 #include "dbfiltercondition.h"
@@ -143,7 +145,8 @@ bool DBFilterCondition::filters (const std::string &dbo_name)
 }
 
 std::string DBFilterCondition::getConditionString (const std::string &dbo_name, bool &first,
-                                                   std::vector <DBOVariable*>& filtered_variables)
+                                                   std::vector <DBOVariable*>& filtered_variables,
+                                                   DBCommandParameters* parameters)
 {
     logdbg << "DBFilterCondition: getConditionString: object " << dbo_name << " first " << first;
     assert (usable_);
@@ -190,6 +193,32 @@ std::string DBFilterCondition::getConditionString (const std::string &dbo_name,
     const MetaDBTable& meta_table = variable->currentMetaTable();
     std::string table_db_name = meta_table.tableFor(column.identifier()).name();
 
+    std::string value_str;
+    DBCommandParameters condition_parameters;
+    bool bound = parameters && operator_ != "IS" && operator_ != "IS NOT"; // NULL stays literal
+
+    if (bound)
+    {
+        std::vector<std::string> placeholders;
+
+        for (auto& value_it : getTransformedValues (value_, variable))
+        {
+            if (!addLiteralParameter(value_it, condition_parameters))
+            {
+                bound = false; // e.g. expression, kept as literal text
+                break;
+            }
+
+            placeholders.push_back("?");
+        }
+
+        if (bound)
+            value_str = operator_ == "IN" ? "(" + boost::algorithm::join(placeholders, ",") + ")" : "?";
+    }
+
+    if (!bound)
+        value_str = getTransformedValue (value_, variable);
+
     if (!first)
     {
         if (op_and_)
@@ -200,7 +229,10 @@ std::string DBFilterCondition::getConditionString (const std::string &dbo_name,
     first=false;
 
     ss << variable_prefix << table_db_name << "." << column.name() << variable_suffix << " " << operator_  << " "
-       << getTransformedValue (value_, variable);
+       << value_str;
+
+    if (bound)
+        parameters->insert(parameters->end(), condition_parameters.begin(), condition_parameters.end());
 
     if (find (filtered_variables.begin(), filtered_variables.end(), variable) == filtered_variables.end())
         filtered_variables.push_back(variable);
@@ -212,6 +244,75 @@ std::string DBFilterCondition::getConditionString (const std::string &dbo_name,
     return ss.str();
 }
 
+bool DBFilterCondition::getPredicate (const std::string& dbo_name, bool& first,
+                                      std::vector <DBOVariable*>& filtered_variables, SQLPredicates& predicates,
+                                      bool use_parameters)
+{
+    bool condition_first = true;
+    std::vector <DBOVariable*> condition_variables;
+    SQLPredicate predicate;
+
+    predicate.condition_ = getConditionString (dbo_name, condition_first, condition_variables,
+                                               use_parameters ? &predicate.parameters_ : nullptr);
+
+    if (!predicate.condition_.size()) // not in db, skipped
+        return true;
+
+    if (!first && !op_and_)
+        return false;
+
+    first = false;
+
+    assert (condition_variables.size() == 1);
+    predicate.variable_ = condition_variables.at(0);
+
+    const DBTableColumn& column = predicate.variable_->currentDBColumn();
+    predicate.table_name_ = predicate.variable_->currentMetaTable().tableFor(column.identifier()).name();
+    predicate.null_rejecting_ = operator_ != "IS" && operator_ != "IS NOT";
+    predicate.selectivity_ = estimateSelectivity (*predicate.variable_);
+
+    if (find (filtered_variables.begin(), filtered_variables.end(), predicate.variable_) == filtered_variables.end())
+        filtered_variables.push_back(predicate.variable_);
+
+    predicates.push_back(predicate);
+
+    return true;
+}
+
+double DBFilterCondition::estimateSelectivity (DBOVariable& variable)
+{
+    if (absolute_value_ || !variable.hasMinMax()
+            || variable.representation() != DBOVariable::Representation::STANDARD)
+        return 1.0;
+
+    try
+    {
+        double min = std::stod(variable.getMinString());
+        double max = std::stod(variable.getMaxString());
+        double value = std::stod(value_);
+
+        if (max <= min)
+            return 1.0;
+
+        double fraction;
+
+        if (operator_ == ">" || operator_ == ">=")
+            fraction = (max - value) / (max - min);
+        else if (operator_ == "<" || operator_ == "<=")
+            fraction = (value - min) / (max - min);
+        else if (operator_ == "=")
+            fraction = value < min || value > max ? 0.0 : 1.0;
+        else
+            return 1.0;
+
+        return std::min(1.0, std::max(0.0, fraction));
+    }
+    catch (std::exception&) // no numeric minimum/maximum or value
+    {
+        return 1.0;
+    }
+}
+
 /**
  * Checks if value_ is different than edit_ value, if yes sets changed_ and emits possibleFilterChange.
  */
@@ -361,6 +462,20 @@ bool DBFilterCondition::checkValueInvalid (const std::string& new_value)
 }
 
 std::string DBFilterCondition::getTransformedValue (const std::string& untransformed_value, DBOVariable* variable)
+{
+    std::vector<std::string> transformed_value_strings = getTransformedValues (untransformed_value, variable);
+
+    if (operator_ != "IN")
+    {
+        assert (transformed_value_strings.size() == 1);
+        return transformed_value_strings.at(0);
+    }
+    else
+        return "(" + boost::algorithm::join(transformed_value_strings, ",") + ")";
+}
+
+std::vector<std::string> DBFilterCondition::getTransformedValues (const std::string& untransformed_value,
+                                                                  DBOVariable* variable)
 {
     assert (variable);
     const DBTableColumn &column = variable->currentDBColumn();
@@ -445,12 +560,62 @@ std::string DBFilterCondition::getTransformedValue (const std::string& untransfo
 
     assert (transformed_value_strings.size());
 
-    if (operator_ != "IN")
+    return transformed_value_strings;
+}
+
+bool DBFilterCondition::addLiteralParameter (const std::string& literal, DBCommandParameters& parameters)
+{
+    size_t begin = literal.find_first_not_of(' ');
+
+    if (begin == std::string::npos)
+        return false;
+
+    std::string value = literal.substr(begin, literal.find_last_not_of(' ')-begin+1);
+
+    if (value.size() >= 2 && value.front() == '\'' && value.back() == '\'')
     {
-        assert (transformed_value_strings.size() == 1);
-        return transformed_value_strings.at(0);
+        std::string text = value.substr(1, value.size()-2);
+
+        for (size_t cnt=0; cnt < text.size(); ++cnt)
+        {
+            if (text.at(cnt) != '\'')
+                continue;
+
+            if (cnt+1 == text.size() || text.at(cnt+1) != '\'') // unescaped, e.g. 'a' || 'b', keep expression
+                return false;
+
+            ++cnt;
+        }
+
+        boost::algorithm::replace_all(text, "''", "'");
+        parameters.push_back(DBCommandParameter (PropertyDataType::STRING, text));
+        return true;
     }
-    else
-        return "(" + boost::algorithm::join(transformed_value_strings, ",") + ")";
+
+    size_t pos = 0;
+
+    try
+    {
+        std::stoll(value, &pos);
+
+        if (pos == value.size())
+        {
+            parameters.push_back(DBCommandParameter (PropertyDataType::LONGINT, value));
+            return true;
+        }
+
+        std::stod(value, &pos);
+
+        if (pos == value.size())
+        {
+            parameters.push_back(DBCommandParameter (PropertyDataType::DOUBLE, value));
+            return true;
+        }
+    }
+    catch (std::exception&) // not a number
+    {
+    }
+
+    return false;
 }
 
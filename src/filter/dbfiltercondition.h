@@ -22,6 +22,8 @@
 #include <cassert>
 
 #include "configurable.h"
+#include "dbcommand.h"
+#include "sqlpredicate.h"
 
 class QWidget;
 class QLineEdit;
@@ -62,9 +64,13 @@ public:
     void invert ();
     /// @brief Returns if condition is active for the DBO type
     bool filters (const std::string& dbo_name);
-    /// @brief Returns condition string for a DBO type
+    /// @brief Returns condition string for a DBO type, values as placeholders added to parameters if given
     std::string getConditionString (const std::string& dbo_name, bool& first,
-                                    std::vector <DBOVariable*>& filtered_variables);
+                                    std::vector <DBOVariable*>& filtered_variables,
+                                    DBCommandParameters* parameters=nullptr);
+    /// @brief Adds condition for a DBO type as predicate, returns false if OR-connected to a previous condition
+    bool getPredicate (const std::string& dbo_name, bool& first, std::vector <DBOVariable*>& filtered_variables,
+                       SQLPredicates& predicates, bool use_parameters);
 
     /// @brief Returns the widget
     QWidget* getWidget () { assert(widget_); return widget_;}
@@ -143,6 +149,12 @@ private:
     QLabel* label_  {nullptr};
 
     std::string getTransformedValue (const std::string& untransformed_value, DBOVariable* variable);
+    /// @brief Returns transformed values, one for operator IN items
+    std::vector<std::string> getTransformedValues (const std::string& untransformed_value, DBOVariable* variable);
+    /// @brief Returns estimated fraction of rows matching, from the variable's minimum/maximum if already read
+    double estimateSelectivity (DBOVariable& variable);
+    /// @brief Adds parameter for SQL literal, returns false if not a number or quoted string
+    static bool addLiteralParameter (const std::string& literal, DBCommandParameters& parameters);
     bool checkValueInvalid (const std::string& new_value);
 };
 
@@ -15,6 +15,9 @@
  * along with ATSDB.  If not, see <http://www.gnu.org/licenses/>.
  */
 
+#include <algorithm>
+#include <set>
+
 #include "configurationmanager.h"
 #include "dbfilter.h"
 #include "dbobject.h"
@@ -27,6 +30,10 @@
 #include "dbconnection.h"
 #include "filtermanagerwidget.h"
 #include "datasourcesfilter.h"
+#include "dbtable.h"
+#include "dbtablecolumn.h"
+#include "dbtableindex.h"
+#include "metadbtable.h"
 
 using namespace std;
 
@@ -171,7 +178,8 @@ void FilterManager::checkSubConfigurables ()
     }
 }
 
-std::string FilterManager::getSQLCondition (const std::string& dbo_name, std::vector <DBOVariable*>& filtered_variables)
+std::string FilterManager::getSQLCondition (const std::string& dbo_name, std::vector <DBOVariable*>& filtered_variables,
+                                            DBCommandParameters* parameters)
 {
     assert (ATSDB::instance().objectManager().object(dbo_name).loadable());
 
@@ -187,7 +195,7 @@ std::string FilterManager::getSQLCondition (const std::string& dbo_name, std::ve
 
         if (filter->getActive() && filter->filters (dbo_name))
         {
-            ss << filter->getConditionString (dbo_name, first, filtered_variables);
+            ss << filter->getConditionString (dbo_name, first, filtered_variables, parameters);
         }
     }
 
@@ -196,6 +204,138 @@ std::string FilterManager::getSQLCondition (const std::string& dbo_name, std::ve
 }
 
 
+std::string FilterManager::getReadSQLCondition (const std::string& dbo_name, DBOVariableSet& read_set,
+                                                DBOVariable* order_variable,
+                                                std::vector <DBOVariable*>& filtered_variables,
+                                                DBCommandParameters* parameters)
+{
+    DBObject& object = ATSDB::instance().objectManager().object(dbo_name);
+    assert (object.loadable());
+
+    SQLPredicates predicates;
+    std::vector <DBOVariable*> predicate_variables;
+    bool first=true;
+
+    for (auto* filter : filters_)
+    {
+        if (filter->getActive() && filter->filters (dbo_name)
+                && !filter->getPredicates(dbo_name, first, predicate_variables, predicates, parameters != nullptr))
+        {
+            loginf << "FilterManager: getReadSQLCondition: name " << dbo_name << " conditions not AND-connected";
+            return getSQLCondition(dbo_name, filtered_variables, parameters);
+        }
+    }
+
+    DBCommandParameters planned_parameters;
+
+    std::string condition = ATSDB::instance().interface().planFilter(
+                object.currentMetaTable(), read_set, order_variable, predicates, planned_parameters,
+                filtered_variables);
+
+    if (parameters)
+        parameters->insert(parameters->end(), planned_parameters.begin(), planned_parameters.end());
+
+    logdbg  << "FilterManager: getReadSQLCondition: name " << dbo_name << " '" << condition << "'";
+    return condition;
+}
+
+std::vector<IndexSuggestion> FilterManager::suggestIndexes ()
+{
+    std::vector<IndexSuggestion> suggestions;
+
+    for (auto& obj_it : ATSDB::instance().objectManager())
+    {
+        if (!obj_it.second->loadable())
+            continue;
+
+        std::vector <DBOVariable*> filtered_variables;
+        getSQLCondition (obj_it.first, filtered_variables);
+
+        std::string ds_variable_name;
+
+        if (obj_it.second->hasCurrentDataSourceDefinition())
+            ds_variable_name = obj_it.second->currentDataSourceDefinition().localKey();
+
+        // filtered columns per table, data source column first
+        std::map <DBTable*, std::vector<std::string>> table_columns;
+        std::set <DBTable*> ds_tables;
+
+        for (auto* variable : filtered_variables)
+        {
+            if (!variable->existsInDB())
+                continue;
+
+            const DBTableColumn& column = variable->currentDBColumn();
+
+            if (column.isKey()) // primary key is indexed
+                continue;
+
+            DBTable* table = &variable->currentMetaTable().tableFor(column.identifier());
+            std::vector<std::string>& columns = table_columns[table];
+
+            if (find (columns.begin(), columns.end(), column.name()) != columns.end())
+                continue;
+
+            if (variable->name() == ds_variable_name)
+            {
+                columns.insert(columns.begin(), column.name());
+                ds_tables.insert(table);
+            }
+            else
+                columns.push_back(column.name());
+        }
+
+        for (auto& table_it : table_columns)
+        {
+            DBTable& table = *table_it.first;
+            std::vector<std::string>& columns = table_it.second;
+            std::vector<std::vector<std::string>> index_columns;
+
+            if (ds_tables.count(&table) && columns.size() > 1)
+            {
+                for (unsigned int cnt=1; cnt < columns.size(); ++cnt)
+                    index_columns.push_back({columns.front(), columns.at(cnt)});
+            }
+            else
+            {
+                for (auto& column : columns)
+                    index_columns.push_back({column});
+            }
+
+            for (auto& index : index_columns)
+            {
+                bool covered = false; // by an index starting with the same columns
+
+                for (auto& index_it : table.indexes())
+                {
+                    std::vector<std::string> defined = index_it.second->columns();
+                    covered |= defined.size() >= index.size() && std::equal(index.begin(), index.end(),
+                                                                            defined.begin());
+                }
+
+                std::string index_name = "idx_"+table.name();
+                std::string column_names;
+
+                for (auto& column : index)
+                {
+                    index_name += "_"+column;
+                    column_names += (column_names.size() ? "," : "")+column;
+                }
+
+                for (auto& suggestion : suggestions)
+                    covered |= suggestion.index_name_ == index_name;
+
+                if (!covered && !table.hasIndex(index_name))
+                    suggestions.push_back({&table, index_name, column_names});
+            }
+        }
+    }
+
+    loginf << "FilterManager: suggestIndexes: " << suggestions.size() << " suggestions";
+
+    return suggestions;
+}
+
 unsigned int FilterManager::getNumFilters ()
 {
     return filters_.size();
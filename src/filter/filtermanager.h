@@ -25,11 +25,23 @@
 
 #include "singleton.h"
 #include "configurable.h"
+#include "dbcommand.h"
 
 class DBFilter;
 class ATSDB;
 class FilterManagerWidget;
 class DBOVariable;
+class DBOVariableSet;
+class DBTable;
+
+/// @brief Secondary index proposed by FilterManager::suggestIndexes
+struct IndexSuggestion
+{
+    DBTable* table_;
+    std::string index_name_;
+    /// Comma separated column names
+    std::string column_names_;
+};
 
 /**
  * @brief Manages all filters and generates SQL conditions
@@ -57,7 +69,23 @@ public:
     virtual ~FilterManager();
 
     /// @brief Returns the SQL condition for a DBO and sets all used variable names
-    std::string getSQLCondition (const std::string& dbo_name,std::vector <DBOVariable*>& filtered_variables);
+    ///
+    /// If parameters is given, values are returned as '?' placeholders and added to it in order.
+    std::string getSQLCondition (const std::string& dbo_name,std::vector <DBOVariable*>& filtered_variables,
+                                 DBCommandParameters* parameters=nullptr);
+    /// @brief Returns the SQL condition for a read of a DBO, planned on its meta table
+    ///
+    /// If all active conditions are AND-connected, conditions on sub-tables not needed for read_set or order_variable
+    /// are pushed into subqueries instead of joining them, see SQLGenerator::planFilter. Otherwise as getSQLCondition.
+    std::string getReadSQLCondition (const std::string& dbo_name, DBOVariableSet& read_set,
+                                     DBOVariable* order_variable, std::vector <DBOVariable*>& filtered_variables,
+                                     DBCommandParameters* parameters=nullptr);
+
+    /// @brief Returns indexes not yet defined for the columns filtered by the active filters
+    ///
+    /// Per table, a filtered data source column leads composite indexes with the other filtered columns, so loads
+    /// of some sensors over a range are one index range scan.
+    std::vector<IndexSuggestion> suggestIndexes ();
 
     /// @brief Returns number of existing filters
     unsigned int getNumFilters ();
@@ -29,6 +29,8 @@
 #include "filtermanager.h"
 #include "dbfilter.h"
 #include "dbfilterwidget.h"
+#include "dbinterface.h"
+#include "atsdb.h"
 
 #include <QLabel>
 #include <QPushButton>
@@ -37,6 +39,10 @@
 #include <QHBoxLayout>
 #include <QInputDialog>
 #include <QStackedWidget>
+#include <QMessageBox>
+#include <QApplication>
+
+#include <set>
 
 FilterManagerWidget::FilterManagerWidget(FilterManager &filter_manager, QWidget* parent, Qt::WindowFlags f)
  : QFrame(parent), filter_manager_(filter_manager), filter_generator_widget_(nullptr), add_button_(nullptr)
@@ -65,6 +71,11 @@ FilterManagerWidget::FilterManagerWidget(FilterManager &filter_manager, QWidget*
     connect(add_button_, SIGNAL( clicked() ), this, SLOT( addFilterSlot() ));
     button_layout->addWidget (add_button_);
 
+    suggest_indexes_button_ = new QPushButton(tr("Suggest Indexes"));
+    suggest_indexes_button_->setToolTip(tr("Analyze active filters and suggest database indexes"));
+    connect(suggest_indexes_button_, SIGNAL( clicked() ), this, SLOT( suggestIndexesSlot() ));
+    button_layout->addWidget (suggest_indexes_button_);
+
     layout->addLayout(button_layout);
 
     setLayout (layout);
@@ -90,6 +101,57 @@ void FilterManagerWidget::addFilterSlot ()
     filter_generator_widget_->show();
 }
 
+void FilterManagerWidget::suggestIndexesSlot ()
+{
+    std::vector<IndexSuggestion> suggestions = filter_manager_.suggestIndexes();
+
+    if (!suggestions.size())
+    {
+        QMessageBox::information(this, tr("Suggest Indexes"), tr("All columns of the active filters are indexed."));
+        return;
+    }
+
+    QString text = tr("Indexes for the columns of the active filters:\n\n");
+
+    for (auto& suggestion : suggestions)
+        text += QString::fromStdString(suggestion.table_->name()+" ("+suggestion.column_names_+")\n");
+
+    text += tr("\nAdd to the schema and create in the database? This may take a while for large tables.");
+
+    if (QMessageBox::question(this, tr("Suggest Indexes"), text, QMessageBox::Yes | QMessageBox::No)
+            != QMessageBox::Yes)
+        return;
+
+    std::set<DBTable*> tables;
+
+    for (auto& suggestion : suggestions)
+    {
+        suggestion.table_->addIndex(suggestion.index_name_, suggestion.column_names_);
+        tables.insert(suggestion.table_);
+    }
+
+    QApplication::setOverrideCursor(Qt::WaitCursor);
+
+    try
+    {
+        for (auto* table : tables)
+        {
+            if (table->existsInDB())
+                ATSDB::instance().interface().createIndexes(*table);
+        }
+    }
+    catch (std::exception& e)
+    {
+        QApplication::restoreOverrideCursor();
+
+        logerr << "FilterManagerWidget: suggestIndexesSlot: index creation failed: " << e.what();
+        QMessageBox::warning(this, tr("Suggest Indexes"), tr("Index creation failed: ")+e.what());
+        return;
+    }
+
+    QApplication::restoreOverrideCursor();
+}
+
 void FilterManagerWidget::updateFiltersSlot()
 {
     assert (filter_layout_);
@@ -34,6 +34,7 @@ signals:
 
 public slots:
     void addFilterSlot ();
+    void suggestIndexesSlot ();
     void updateFiltersSlot();
     void filterWidgetActionSlot (bool result);
 
@@ -50,6 +51,7 @@ protected:
     QVBoxLayout *filter_layout_;
 
     QPushButton *add_button_;
+    QPushButton *suggest_indexes_button_ {nullptr};
 };
 
 #endif // FILTERMANAGERWIDGET_H
@@ -17,6 +17,8 @@
 
 #include "boost/date_time/posix_time/posix_time.hpp"
 
+#include <algorithm>
+
 #include <QMutexLocker>
 #include <QMessageBox>
 #include <QThread>
@@ -31,8 +33,12 @@
 #include "dbcommandlist.h"
 #include "mysqlserver.h"
 #include "dbconnection.h"
+#include "dbreader.h"
 #include "mysqlppconnection.h"
 #include "sqliteconnection.h"
+#if USE_DUCKDB == true
+#include "duckdbconnection.h"
+#endif
 #include "dbinterfacewidget.h"
 #include "dbinterfaceinfowidget.h"
 #include "dbinterface.h"
@@ -52,6 +58,7 @@
 #include "unitmanager.h"
 #include "dbtableinfo.h"
 #include "dbtable.h"
+#include "dbtableindex.h"
 #include "stringconv.h"
 
 using namespace Utils;
@@ -68,6 +75,10 @@ DBInterface::DBInterface(std::string class_id, std::string instance_id, ATSDB *a
     QMutexLocker locker(&connection_mutex_);
 
     registerParameter ("read_chunk_size", &read_chunk_size_, 50000);
+    registerParameter ("read_partitions", &read_partitions_, 1);
+    registerParameter ("read_prefetch_depth", &read_prefetch_depth_, 2);
+    registerParameter ("insert_batch_rows", &insert_batch_rows_, 100);
+    registerParameter ("bulk_load_min_rows", &bulk_load_min_rows_, 10000);
     registerParameter ("used_connection", &used_connection_, "");
 
     createSubConfigurables();
@@ -141,6 +152,7 @@ void DBInterface::closeConnection ()
     }
 
     table_info_.clear();
+    bulk_mode_ = false; // setting of the closed connection
     logdbg  << "DBInterface: closeConnection: done";
 }
 
@@ -152,6 +164,7 @@ void DBInterface::updateTableInfo ()
 
     assert (current_connection_);
     table_info_ = current_connection_->getTableInfo();
+    sql_generator_.clearCache();
 
     loginf << "DBInterface: updateTableInfo: found " << table_info_.size() << " tables";
 }
@@ -225,6 +238,15 @@ void DBInterface::generateSubConfigurable (const std::string &class_id, const st
         connections_.insert (std::pair <std::string, DBConnection*> (connection->instanceId(),
                                                                      dynamic_cast<DBConnection*>(connection)));
     }
+#if USE_DUCKDB == true
+    else if (class_id == "DuckDBConnection")
+    {
+        DuckDBConnection *connection = new DuckDBConnection (class_id, instance_id, this);
+        assert (connections_.count (connection->instanceId()) == 0);
+        connections_.insert (std::pair <std::string, DBConnection*> (connection->instanceId(),
+                                                                     dynamic_cast<DBConnection*>(connection)));
+    }
+#endif
     else
         throw std::runtime_error ("DBInterface: generateSubConfigurable: unknown class_id "+class_id );
 }
@@ -242,6 +264,14 @@ void DBInterface::checkSubConfigurables ()
         addNewSubConfiguration ("SQLiteConnection", "SQLite Connection");
         generateSubConfigurable ("SQLiteConnection", "SQLite Connection");
     }
+
+#if USE_DUCKDB == true
+    if (connections_.count("DuckDB Connection") == 0)
+    {
+        addNewSubConfiguration ("DuckDBConnection", "DuckDB Connection");
+        generateSubConfigurable ("DuckDBConnection", "DuckDB Connection");
+    }
+#endif
 }
 
 bool DBInterface::existsTable (const std::string& table_name)
@@ -273,6 +303,52 @@ void DBInterface::createTable (DBTable& table)
     loginf << "DBInterface: createTable: checking " << table.name();
     assert (table.existsInDB());
     //emit databaseContentChangedSignal();
+
+    if (bulk_mode_)
+    {
+        loginf << "DBInterface: createTable: deferring indexes of " << table.name() << " in bulk mode";
+        return;
+    }
+
+    createIndexes(table);
+}
+
+void DBInterface::createIndexes (DBTable& table)
+{
+    assert (table.existsInDB());
+
+    bool created = false;
+
+    for (auto& index_it : table.indexes())
+    {
+        if (index_it.second->existsInDB())
+            continue;
+
+        loginf << "DBInterface: createIndexes: table " << table.name() << " index " << index_it.first;
+
+        std::string statement = sql_generator_.getCreateIndexStatement(*index_it.second);
+
+        QMutexLocker locker(&connection_mutex_);
+        current_connection_->executeSQL(statement);
+        created = true;
+    }
+
+    if (!created)
+        return;
+
+    updateTableInfo();
+    table.updateOnDatabase();
+}
+
+void DBInterface::createIndexes ()
+{
+    const DBSchema &schema = ATSDB::instance().schemaManager().getCurrentSchema();
+
+    for (auto& table_it : schema.tables())
+    {
+        if (table_it.second->existsInDB())
+            createIndexes(*table_it.second);
+    }
 }
 
 /**
@@ -634,6 +710,41 @@ std::map <int, DBODataSource> DBInterface::getDataSources (DBObject &object)
     return sources;
 }
 
+bool DBInterface::supportsParameters ()
+{
+    QMutexLocker locker(&connection_mutex_);
+    return current_connection_ && current_connection_->supportsParameters();
+}
+
+std::string DBInterface::planFilter (const MetaDBTable &meta_table, DBOVariableSet& read_list,
+                                     DBOVariable* order_variable, const SQLPredicates& predicates,
+                                     DBCommandParameters& parameters, std::vector <DBOVariable*>& filtered_variables)
+{
+    return sql_generator_.planFilter(meta_table, read_list, order_variable, predicates, parameters,
+                                     filtered_variables);
+}
+
+std::string DBInterface::keySetClause (const std::string& column_identifier)
+{
+    return sql_generator_.getKeySetClause(column_identifier);
+}
+
+DBCommandParameter DBInterface::keySetParameter (const std::vector<int>& keys)
+{
+    return sql_generator_.getKeySetParameter(keys);
+}
+
+void DBInterface::bulkMode (bool bulk)
+{
+    loginf  << "DBInterface: bulkMode: " << bulk;
+
+    QMutexLocker locker(&connection_mutex_);
+    assert (current_connection_);
+
+    current_connection_->bulkMode(bulk);
+    bulk_mode_ = bulk;
+}
+
 size_t DBInterface::count (const std::string &table)
 {
     logdbg  << "DBInterface: count: table " << table;
@@ -1052,25 +1163,57 @@ void DBInterface::insertBuffer (DBTable& table, std::shared_ptr<Buffer> buffer)
 
     assert (table.existsInDB());
 
-    std::string bind_statement = sql_generator_.insertDBUpdateStringBind(buffer, table.name());
-
     QMutexLocker locker(&connection_mutex_);
 
-    logdbg  << "DBInterface: partialInsertBuffer: preparing bind statement";
-    current_connection_->prepareBindStatement(bind_statement);
-    current_connection_->beginBindTransaction();
+    if (bulk_load_min_rows_ && buffer->size() >= bulk_load_min_rows_ && current_connection_->supportsBulkLoad())
+    {
+        logdbg  << "DBInterface: partialInsertBuffer: bulk loading";
+
+        try
+        {
+            current_connection_->bulkLoad(table.name(), *buffer);
+            return;
+        }
+        catch (std::exception& e) // nothing inserted, bind inserts report row errors
+        {
+            logwrn << "DBInterface: partialInsertBuffer: bulk load into " << table.name() << " failed with '"
+                   << e.what() << "', inserting with bound statements";
+        }
+    }
+
+    unsigned int num_columns = properties.size();
+    assert (num_columns);
+    size_t batch_rows = std::max (1u, std::min (insert_batch_rows_,
+                                                current_connection_->maxBindVariables() / num_columns));
 
-    logdbg  << "DBInterface: partialInsertBuffer: starting inserts";
+    std::vector<size_t> handle_indexes = buffer->handleIndexes();
     size_t size = buffer->size();
-    for (unsigned int cnt=0; cnt < size; ++cnt)
+    size_t row = 0;
+
+    current_connection_->beginBindTransaction();
+
+    logdbg  << "DBInterface: partialInsertBuffer: starting inserts, " << batch_rows << " rows per statement";
+
+    while (row < size) // full batches, then remainder in one statement
     {
-        insertBindStatementUpdateForCurrentIndex(buffer, cnt);
+        size_t rows = std::min (batch_rows, size - row);
+
+        current_connection_->prepareBindStatement(
+                    sql_generator_.insertDBUpdateStringBind(buffer, table.name(), rows));
+
+        for (size_t end = row + rows * ((size - row) / rows); row < end; row += rows)
+        {
+            for (unsigned int cnt=0; cnt < rows; ++cnt)
+                bindRow(buffer, row+cnt, handle_indexes, cnt*num_columns);
+
+            current_connection_->stepAndClearBindings();
+        }
+
+        current_connection_->finalizeBindStatement();
     }
 
     logdbg  << "DBInterface: partialInsertBuffer: ending bind transactions";
     current_connection_->endBindTransaction();
-    logdbg  << "DBInterface: partialInsertBuffer: finalizing bind statement";
-    current_connection_->finalizeBindStatement();
 }
 
 std::shared_ptr<Buffer> DBInterface::getPartialBuffer (DBTable& table, std::shared_ptr<Buffer> buffer)
@@ -1209,10 +1352,11 @@ void DBInterface::updateBuffer (DBTable& table, const DBTableColumn& key_col, st
         to_index = buffer->size()-1;
 
     logdbg  << "DBInterface: updateBuffer: starting inserts";
+    std::vector<size_t> handle_indexes = buffer->handleIndexes();
     for (int cnt=from_index; cnt <= to_index; cnt++)
     {
         logdbg  << "DBInterface: updateBuffer: insert cnt " << cnt;
-        insertBindStatementUpdateForCurrentIndex(buffer, cnt);
+        insertBindStatementUpdateForCurrentIndex(buffer, cnt, handle_indexes);
     }
 
     logdbg  << "DBInterface: updateBuffer: ending bind transactions";
@@ -1221,11 +1365,14 @@ void DBInterface::updateBuffer (DBTable& table, const DBTableColumn& key_col, st
     current_connection_->finalizeBindStatement();
 }
 
-void DBInterface::prepareRead (const DBObject &dbobject, DBOVariableSet read_list, std::string custom_filter_clause,
-                               std::vector <DBOVariable *> filtered_variables, bool use_order,
-                               DBOVariable *order_variable, bool use_order_ascending, const std::string &limit)
+unsigned int DBInterface::prepareRead (const DBObject &dbobject, DBOVariableSet read_list,
+                                       std::string custom_filter_clause, const DBCommandParameters& parameters,
+                                       std::vector <DBOVariable *> filtered_variables, bool use_order,
+                                       DBOVariable *order_variable, bool use_order_ascending,
+                                       const std::string &limit)
 {
     assert (current_connection_);
+    assert (!parameters.size() || current_connection_->supportsParameters());
 
     assert (dbobject.existsInDB());
 
@@ -1238,25 +1385,114 @@ void DBInterface::prepareRead (const DBObject &dbobject, DBOVariableSet read_lis
     if (order_variable)
         assert (order_variable->existsInDB());
 
+    if (current_connection_->supportsConcurrentRead()) // read on own connections, concurrent to other reads
+    {
+        std::vector<std::shared_ptr<DBCommand>> reads;
+
+        if (read_partitions_ > 1 && !use_order && !limit.size())
+        {
+            QMutexLocker locker(&connection_mutex_);
+            reads = getPartitionedSelectCommands (dbobject, read_list, custom_filter_clause, parameters,
+                                                  filtered_variables);
+        }
+
+        if (!reads.size())
+        {
+            reads.push_back(sql_generator_.getSelectCommand (
+                                dbobject.currentMetaTable(), read_list, custom_filter_clause, filtered_variables,
+                                use_order, order_variable, use_order_ascending, limit, true));
+            reads.back()->parameters(parameters);
+        }
+
+        loginf  << "DBInterface: prepareRead: dbo " << dbobject.name() << " concurrent, " << reads.size()
+                << " partitions, sql '" << reads.front()->get() << "'";
+
+        std::unique_ptr<DBReader> reader = current_connection_->createReader(reads);
+
+        QMutexLocker locker(&readers_mutex_);
+        unsigned int read_id = next_read_id_++;
+        readers_[read_id] = std::move(reader);
+        return read_id;
+    }
+
     connection_mutex_.lock();
 
     std::shared_ptr<DBCommand> read = sql_generator_.getSelectCommand (
                 dbobject.currentMetaTable(), read_list, custom_filter_clause, filtered_variables, use_order,
                 order_variable, use_order_ascending, limit, true);
+    read->parameters(parameters);
 
-    loginf  << "DBInterface: prepareRead: dbo " << dbobject.name() << " sql '" << read->get() << "'";
+    loginf  << "DBInterface: prepareRead: dbo " << dbobject.name() << " sql '" << read->get() << "' "
+            << parameters.size() << " parameters";
     current_connection_->prepareCommand(read);
+
+    return 0;
+}
+
+std::vector<std::shared_ptr<DBCommand>> DBInterface::getPartitionedSelectCommands (
+        const DBObject &dbobject, DBOVariableSet& read_list, const std::string& custom_filter_clause,
+        const DBCommandParameters& parameters, std::vector <DBOVariable *>& filtered_variables)
+{
+    // locked by prepareRead
+    assert (current_connection_);
+
+    const MetaDBTable& meta_table = dbobject.currentMetaTable();
+    std::vector<std::shared_ptr<DBCommand>> reads;
+
+    std::shared_ptr<DBResult> result = current_connection_->execute(*sql_generator_.getRowIdMinMaxCommand(meta_table));
+    assert (result->containsData());
+    std::shared_ptr<Buffer> buffer = result->buffer();
+
+    if (!buffer->size() || buffer->get<long int>("min").isNull(0) || buffer->get<long int>("max").isNull(0))
+        return reads; // no rows
+
+    long int min = buffer->get<long int>("min").get(0);
+    long int max = buffer->get<long int>("max").get(0);
+    long int step = (max - min) / read_partitions_ + 1;
+
+    for (long int from = min; from <= max; from += step)
+    {
+        std::string filter = sql_generator_.getRowIdRangeClause(meta_table, from, std::min(from + step - 1, max));
+
+        if (custom_filter_clause.size())
+            filter = "(" + custom_filter_clause + ") AND " + filter;
+
+        // not cached, rowid ranges change with the table contents
+        reads.push_back(sql_generator_.getSelectCommand (meta_table, read_list, filter, filtered_variables,
+                                                         false, nullptr, false, "", true, false));
+        reads.back()->parameters(parameters); // placeholders precede the rowid range
+    }
+
+    return reads;
 }
 
 /**
  * Retrieves result from connection stepPreparedCommand, calls activateKeySearch on buffer and returns it.
  */
-std::shared_ptr <Buffer> DBInterface::readDataChunk (const DBObject &dbobject)
+std::shared_ptr <Buffer> DBInterface::readDataChunk (const DBObject &dbobject, unsigned int read_id,
+                                                     std::shared_ptr<BufferPool> buffer_pool)
 {
+    if (read_id) // reader is only removed by finalizeReadStatement of the same read
+    {
+        DBReader* reader {nullptr};
+
+        {
+            QMutexLocker locker(&readers_mutex_);
+            assert (readers_.count(read_id));
+            reader = readers_.at(read_id).get();
+        }
+
+        std::shared_ptr <Buffer> buffer = reader->next(read_chunk_size_, buffer_pool);
+        assert (buffer);
+
+        buffer->dboName(dbobject.name());
+        return buffer;
+    }
+
     // locked by prepareRead
     assert (current_connection_);
 
-    std::shared_ptr <DBResult> result = current_connection_->stepPreparedCommand(read_chunk_size_);
+    std::shared_ptr <DBResult> result = current_connection_->stepPreparedCommand(read_chunk_size_, buffer_pool);
 
     if (!result)
     {
@@ -1283,14 +1519,31 @@ std::shared_ptr <Buffer> DBInterface::readDataChunk (const DBObject &dbobject)
 }
 
 
-void DBInterface::finalizeReadStatement (const DBObject &dbobject)
+void DBInterface::finalizeReadStatement (const DBObject &dbobject, unsigned int read_id)
 {
-    connection_mutex_.unlock();
+    if (read_id)
+    {
+        std::unique_ptr<DBReader> reader;
+
+        {
+            QMutexLocker locker(&readers_mutex_);
+            assert (readers_.count(read_id));
+            reader = std::move(readers_.at(read_id));
+            readers_.erase(read_id);
+        }
+
+        reader = nullptr; // deleted outside of lock, joins reading threads
+
+        logdbg  << "DBInterface: finalizeReadStatement: " << dbobject.name() << " concurrent read done";
+        return;
+    }
+
     assert (current_connection_);
 
     logdbg  << "DBInterface: finishReadSystemTracks: start ";
     //prepared_.at(dbobject.name())=false;
-    current_connection_->finalizeCommand();
+    current_connection_->finalizeCommand(); // before other reads waiting on the connection can prepare
+    connection_mutex_.unlock();
 }
 
 void DBInterface::createPropertiesTable ()
@@ -1330,63 +1583,90 @@ std::shared_ptr<DBResult> DBInterface::queryMinMaxNormalForTable (const DBTable&
     return result;
 }
 
-void DBInterface::insertBindStatementUpdateForCurrentIndex (std::shared_ptr<Buffer> buffer, unsigned int row)
+void DBInterface::insertBindStatementUpdateForCurrentIndex (std::shared_ptr<Buffer> buffer, unsigned int row,
+                                                           const std::vector<size_t>& handle_indexes)
+{
+    bindRow(buffer, row, handle_indexes, 0);
+
+    current_connection_->stepAndClearBindings();
+}
+
+void DBInterface::bindRow (std::shared_ptr<Buffer> buffer, unsigned int row, const std::vector<size_t>& handle_indexes,
+                           unsigned int index_offset)
 {
     assert (buffer);
-    logdbg  << "DBInterface: insertBindStatementUpdateForCurrentIndex: start";
+    logdbg  << "DBInterface: bindRow: start";
     const PropertyList &list =buffer->properties();
     unsigned int size = list.size();
-    logdbg  << "DBInterface: insertBindStatementUpdateForCurrentIndex: creating bind for " << size << " elements";
+    logdbg  << "DBInterface: bindRow: creating bind for " << size << " elements";
+
+    assert (handle_indexes.size() == size);
 
     std::string connection_type = current_connection_->type();
 
-    assert (connection_type == MYSQL_IDENTIFIER || connection_type == SQLITE_IDENTIFIER);
+    assert (connection_type == MYSQL_IDENTIFIER || connection_type == SQLITE_IDENTIFIER
+            || connection_type == DUCKDB_IDENTIFIER);
 
     unsigned int index_cnt=0;
 
-    logdbg << "DBInterface: insertBindStatementUpdateForCurrentIndex: starting for loop";
+    logdbg << "DBInterface: bindRow: starting for loop";
     for (unsigned int cnt=0; cnt < size; cnt++)
     {
         const Property &property = list.at(cnt);
         PropertyDataType data_type = property.dataType();
+        size_t handle_index = handle_indexes[cnt];
 
-        logdbg  << "DBInterface: insertBindStatementUpdateForCurrentIndex: at cnt " << cnt << " id "
+        logdbg  << "DBInterface: bindRow: at cnt " << cnt << " id "
                 << property.name() << " index cnt " << index_cnt;
 
         if (connection_type == SQLITE_IDENTIFIER)
-            index_cnt=cnt+1;
+            index_cnt=index_offset+cnt+1;
         else if (connection_type == MYSQL_IDENTIFIER)
-            index_cnt=cnt+1;
+            index_cnt=index_offset+cnt+1;
+        else if (connection_type == DUCKDB_IDENTIFIER)
+            index_cnt=index_offset+cnt+1;
         else
             throw std::runtime_error ("DBInterface: insertBindStatementForCurrentIndex: unknown db type");
 
-        if (buffer->isNone(property, row))
-        {
-            current_connection_->bindVariableNull (index_cnt);
-            logdbg  << "DBInterface: insertBindStatementUpdateForCurrentIndex: at " << cnt << " is null";
-            continue;
-        }
-
         switch (data_type)
         {
         case PropertyDataType::BOOL:
-            current_connection_->bindVariable (index_cnt,
-                                               static_cast<int> (buffer->get<bool>(property.name()).get(row)));
+        {
+            NullableVector<bool>& array_list = buffer->get<bool>(ColumnHandle<bool>(handle_index));
+            if (array_list.isNull(row))
+                current_connection_->bindVariableNull (index_cnt);
+            else
+                current_connection_->bindVariable (index_cnt, static_cast<int> (array_list.get(row)));
             break;
+        }
         case PropertyDataType::CHAR:
-            current_connection_->bindVariable (index_cnt,
-                                               static_cast<int> (buffer->get<char>(property.name()).get(row)));
+        {
+            NullableVector<char>& array_list = buffer->get<char>(ColumnHandle<char>(handle_index));
+            if (array_list.isNull(row))
+                current_connection_->bindVariableNull (index_cnt);
+            else
+                current_connection_->bindVariable (index_cnt, static_cast<int> (array_list.get(row)));
             break;
+        }
         case PropertyDataType::UCHAR:
-            current_connection_->bindVariable (index_cnt,
-                                               static_cast<int> (buffer->get<unsigned char>(property.name()).get(row)));
+        {
+            NullableVector<unsigned char>& array_list =
+                    buffer->get<unsigned char>(ColumnHandle<unsigned char>(handle_index));
+            if (array_list.isNull(row))
+                current_connection_->bindVariableNull (index_cnt);
+            else
+                current_connection_->bindVariable (index_cnt, static_cast<int> (array_list.get(row)));
             break;
+        }
         case PropertyDataType::INT:
-            logdbg  << "DBInterface: insertBindStatementUpdateForCurrentIndex: at " << cnt << " is '"
-                    << buffer->get<int>(property.name()).get(row) << "'";
-            current_connection_->bindVariable (index_cnt,
-                                               static_cast<int> (buffer->get<int>(property.name()).get(row)));
+        {
+            NullableVector<int>& array_list = buffer->get<int>(ColumnHandle<int>(handle_index));
+            if (array_list.isNull(row))
+                current_connection_->bindVariableNull (index_cnt);
+            else
+                current_connection_->bindVariable (index_cnt, static_cast<int> (array_list.get(row)));
             break;
+        }
         case PropertyDataType::UINT:
             assert (false);
             break;
@@ -1397,29 +1677,44 @@ void DBInterface::insertBindStatementUpdateForCurrentIndex (std::shared_ptr<Buff
             assert (false);
             break;
         case PropertyDataType::FLOAT:
-            current_connection_->bindVariable (index_cnt,
-                                               static_cast<double> (buffer->get<float>(property.name()).get(row)));
+        {
+            NullableVector<float>& array_list = buffer->get<float>(ColumnHandle<float>(handle_index));
+            if (array_list.isNull(row))
+                current_connection_->bindVariableNull (index_cnt);
+            else
+                current_connection_->bindVariable (index_cnt, static_cast<double> (array_list.get(row)));
             break;
+        }
         case PropertyDataType::DOUBLE:
-            current_connection_->bindVariable (index_cnt, buffer->get<double>(property.name()).get(row));
+        {
+            NullableVector<double>& array_list = buffer->get<double>(ColumnHandle<double>(handle_index));
+            if (array_list.isNull(row))
+                current_connection_->bindVariableNull (index_cnt);
+            else
+                current_connection_->bindVariable (index_cnt, array_list.get(row));
             break;
+        }
         case PropertyDataType::STRING:
-            if (connection_type == SQLITE_IDENTIFIER)
-                current_connection_->bindVariable (index_cnt, buffer->get<std::string>(property.name()).get(row));
+        {
+            NullableVector<std::string>& array_list =
+                    buffer->get<std::string>(ColumnHandle<std::string>(handle_index));
+            if (array_list.isNull(row))
+                current_connection_->bindVariableNull (index_cnt);
+            else if (connection_type == SQLITE_IDENTIFIER || connection_type == DUCKDB_IDENTIFIER)
+                current_connection_->bindVariable (index_cnt, array_list.get(row));
             else //MYSQL assumed
-                current_connection_->bindVariable (index_cnt, "'"+buffer->get<std::string>(property.name()).get(row)+"'");
+                current_connection_->bindVariable (index_cnt, "'"+array_list.get(row)+"'");
             break;
+        }
         default:
-            logerr  <<  "Buffer: insertBindStatementUpdateForCurrentIndex: unknown property type "
+            logerr  <<  "DBInterface: bindRow: unknown property type "
                      << Property::asString(data_type);
-            throw std::runtime_error ("Buffer: insertBindStatementUpdateForCurrentIndex: unknown property type "
+            throw std::runtime_error ("DBInterface: bindRow: unknown property type "
                                       + Property::asString(data_type));
         }
     }
 
-    current_connection_->stepAndClearBindings();
-
-    logdbg  << "DBInterface: insertBindStatementUpdateForCurrentIndex: done";
+    logdbg  << "DBInterface: bindRow: done";
 }
 
 //DBResult *DBInterface::getDistinctStatistics (const std::string &type, DBOVariable *variable, unsigned int sensor_number)
@@ -26,6 +26,7 @@
 #include "configurable.h"
 #include "propertylist.h"
 #include "dbovariableset.h"
+#include "dbcommand.h"
 #include "sqlgenerator.h"
 
 static const std::string ACTIVE_DATA_SOURCES_PROPERTY_PREFIX="activeDataSources_";
@@ -35,7 +36,9 @@ static const std::string TABLE_NAME_MINMAX = "atsdb_minmax";
 class ATSDB;
 class Buffer;
 class BufferWriter;
+class BufferPool;
 class DBConnection;
+class DBReader;
 class DBOVariable;
 class DBTable;
 class QProgressDialog;
@@ -128,18 +131,47 @@ public:
 
     std::shared_ptr<Buffer> getPartialBuffer (DBTable& table, std::shared_ptr<Buffer> buffer);
 
-    //    /// @brief Prepares incremental read of DBO type
-    void prepareRead (const DBObject &dbobject, DBOVariableSet read_list, std::string custom_filter_clause,
-                      std::vector <DBOVariable *> filtered_variables, bool use_order=false,
-                      DBOVariable *order_variable=nullptr, bool use_order_ascending=false, const std::string &limit="");
-
-    /// @brief Returns data chunk of DBO type
-    std::shared_ptr <Buffer> readDataChunk (const DBObject &dbobject);
+    /// @brief Prepares incremental read of DBO type, returns read id for readDataChunk and finalizeReadStatement
+    ///
+    /// parameters are bound to the placeholders of custom_filter_clause, see supportsParameters. Concurrent reads,
+    /// also of the same DBO type, have distinct ids.
+    unsigned int prepareRead (const DBObject &dbobject, DBOVariableSet read_list, std::string custom_filter_clause,
+                      const DBCommandParameters& parameters, std::vector <DBOVariable *> filtered_variables,
+                      bool use_order=false, DBOVariable *order_variable=nullptr, bool use_order_ascending=false,
+                      const std::string &limit="");
+
+    /// @brief Returns data chunk of read of DBO type, storage taken from buffer_pool if given
+    std::shared_ptr <Buffer> readDataChunk (const DBObject &dbobject, unsigned int read_id,
+                                            std::shared_ptr<BufferPool> buffer_pool=nullptr);
     /// @brief Cleans up incremental read of DBO type
-    void finalizeReadStatement (const DBObject &dbobject);
+    void finalizeReadStatement (const DBObject &dbobject, unsigned int read_id);
+    /// @brief Returns number of chunks a read may run ahead of its processing
+    unsigned int readPrefetchDepth () const { return read_prefetch_depth_; }
     /// @brief Sets reading_done_ flags
     //void clearResult ();
 
+    /// @brief Returns filter clause planned on meta table, see SQLGenerator::planFilter
+    std::string planFilter (const MetaDBTable &meta_table, DBOVariableSet& read_list, DBOVariable* order_variable,
+                            const SQLPredicates& predicates, DBCommandParameters& parameters,
+                            std::vector <DBOVariable*>& filtered_variables);
+    /// @brief Returns if read filter clauses may contain placeholders bound from parameters
+    bool supportsParameters ();
+    /// @brief Returns filter clause matching column identifier against a set of keys bound as one parameter
+    std::string keySetClause (const std::string& column_identifier);
+    /// @brief Returns the parameter for keySetClause
+    DBCommandParameter keySetParameter (const std::vector<int>& keys);
+
+    /// @brief Removes cached SQL commands, to be called when table definitions change
+    void clearSQLCache () { sql_generator_.clearCache(); }
+
+    /// @brief Switches connection to settings for bulk inserts or back
+    void bulkMode (bool bulk);
+    /// @brief Returns if in bulk mode, tables are then created without secondary indexes
+    ///
+    /// SQLite integer keys of tables created in bulk mode are INTEGER PRIMARY KEY without AUTOINCREMENT, also after
+    /// leaving it, see SQLGenerator::getCreateTableStatement.
+    bool bulkMode () const { return bulk_mode_; }
+
     /// @brief Returns number of rows for a database table
     size_t count (const std::string &table);
     //    DBResult *count (const std::string &dbo_type, unsigned int sensor_number);
@@ -156,6 +188,10 @@ public:
 
     bool existsTable (const std::string& table_name);
     void createTable (DBTable& table);
+    /// @brief Creates secondary indexes of table not existing in the database
+    void createIndexes (DBTable& table);
+    /// @brief Creates missing secondary indexes of all tables of the current schema existing in the database
+    void createIndexes ();
     /// @brief Returns if minimum/maximum table exists
     bool existsMinMaxTable ();
     /// @brief Returns the minimum/maximum table
@@ -218,9 +254,25 @@ protected:
 
     /// Protects the database
     QMutex connection_mutex_;
+    /// Concurrent reads on own connections, by read id
+    std::map <unsigned int, std::unique_ptr<DBReader>> readers_;
+    /// Id of next concurrent read, 0 is used for reads on the current connection
+    unsigned int next_read_id_ {1};
+    /// Protects readers_ and next_read_id_
+    QMutex readers_mutex_;
 
     /// Size of a read chunk in incremental reading process
     unsigned int read_chunk_size_;
+    /// Number of concurrently read rowid partitions if the connection supports concurrent reads
+    unsigned int read_partitions_;
+    /// Number of chunks a read may run ahead of their transformation and merging
+    unsigned int read_prefetch_depth_;
+    /// Number of rows inserted per statement, limited by the bind variables of the connection
+    unsigned int insert_batch_rows_;
+    /// Minimum buffer size for bulk loading if the connection supports it, 0 to disable
+    unsigned int bulk_load_min_rows_;
+    /// Flag indicating bulk mode, secondary indexes of created tables are deferred to createIndexes
+    bool bulk_mode_ {false};
 
     /// Generates SQL statements
     SQLGenerator sql_generator_;
@@ -236,7 +288,16 @@ protected:
 
     virtual void checkSubConfigurables ();
 
-    void insertBindStatementUpdateForCurrentIndex (std::shared_ptr<Buffer> buffer, unsigned int row);
+    /// @brief Returns select commands for read_partitions_ rowid ranges of the main table, empty if no rows
+    std::vector<std::shared_ptr<DBCommand>> getPartitionedSelectCommands (
+            const DBObject &dbobject, DBOVariableSet& read_list, const std::string& custom_filter_clause,
+            const DBCommandParameters& parameters, std::vector <DBOVariable *>& filtered_variables);
+
+    void insertBindStatementUpdateForCurrentIndex (std::shared_ptr<Buffer> buffer, unsigned int row,
+                                                   const std::vector<size_t>& handle_indexes);
+    /// @brief Binds values of row to variables after index_offset, without stepping
+    void bindRow (std::shared_ptr<Buffer> buffer, unsigned int row, const std::vector<size_t>& handle_indexes,
+                  unsigned int index_offset);
 
     void setPostProcessed (bool value);
     //    /// @brief Returns buffer with min/max data from another Buffer with the string contents. Delete returned buffer yourself.
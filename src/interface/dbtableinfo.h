@@ -19,6 +19,7 @@
 #define DBTABLEINFO_H_
 
 #include <map>
+#include <set>
 
 class DBTableColumnInfo
 {
@@ -62,10 +63,16 @@ public:
 
     const std::map <std::string, DBTableColumnInfo> &columns () const { return columns_; }
 
+    bool hasIndex (const std::string &name) const { return indexes_.count(name) > 0; }
+    void addIndex (const std::string &name) { indexes_.insert(name); }
+    /// @brief Returns names of all indexes, including key indexes
+    const std::set <std::string> &indexes () const { return indexes_; }
+
 protected:
     std::string name_;
 
     std::map <std::string, DBTableColumnInfo> columns_;
+    std::set <std::string> indexes_;
 };
 
 #endif
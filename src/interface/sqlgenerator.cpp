@@ -18,6 +18,7 @@
 #include <algorithm>
 #include <string>
 #include <iomanip>
+#include <set>
 
 #include "buffer.h"
 #include "dbcommandlist.h"
@@ -34,6 +35,7 @@
 //#include "StructureDescriptionManager.h"
 #include "dbtablecolumn.h"
 #include "dbtable.h"
+#include "dbtableindex.h"
 #include "metadbtable.h"
 #include "dbschemamanager.h"
 #include "dbschema.h"
@@ -64,6 +66,38 @@ SQLGenerator::~SQLGenerator()
 {
 }
 
+void SQLGenerator::clearCache ()
+{
+    QMutexLocker locker(&command_cache_mutex_);
+
+    logdbg << "SQLGenerator: clearCache: " << command_cache_.size() << " commands";
+    command_cache_.clear();
+}
+
+std::shared_ptr<DBCommand> SQLGenerator::cachedCommand (const std::string& key)
+{
+    QMutexLocker locker(&command_cache_mutex_);
+
+    auto it = command_cache_.find(key);
+
+    if (it == command_cache_.end())
+        return nullptr;
+
+    return std::make_shared<DBCommand>(*it->second);
+}
+
+std::shared_ptr<DBCommand> SQLGenerator::cacheCommand (const std::string& key, std::shared_ptr<DBCommand> command)
+{
+    QMutexLocker locker(&command_cache_mutex_);
+
+    if (command_cache_.size() >= MAX_CACHED_COMMANDS)
+        command_cache_.clear();
+
+    command_cache_[key] = command;
+
+    return std::make_shared<DBCommand>(*command);
+}
+
 std::string SQLGenerator::getCreateTableStatement (const DBTable& table)
 {
     std::stringstream ss;
@@ -91,6 +125,7 @@ std::string SQLGenerator::getCreateTableStatement (const DBTable& table)
 
     std::string data_type;
     std::string connection_type = db_interface_.connection().type();
+    std::string sequence; // DuckDB key default
 
     unsigned int cnt = 0;
     for (auto& col_it : table.columns())
@@ -106,6 +141,16 @@ std::string SQLGenerator::getCreateTableStatement (const DBTable& table)
             else if (data_type == "enum")
                 data_type = "int"; // hacky
         }
+        else if (connection_type == DUCKDB_IDENTIFIER)
+        {
+            if (data_type == "real")
+                data_type = "DOUBLE"; // single precision in DuckDB
+            else if (data_type == "mediumint")
+                data_type = "INTEGER";
+            else if (data_type == "enum" || data_type == "tinyblob" || data_type == "blob"
+                     || data_type == "mediumblob" || data_type == "longblob")
+                data_type = "VARCHAR"; // read as strings
+        }
 
 //        if (connection_type == SQLITE_IDENTIFIER) // && connection_type != MYSQL_IDENTIFIE
 //        {
@@ -123,11 +168,26 @@ std::string SQLGenerator::getCreateTableStatement (const DBTable& table)
         {
             if (connection_type == SQLITE_IDENTIFIER)
             {
-                if (data_type == "int") // mysql defaults autoincrement
+                // intended to stay a plain rowid alias without sqlite_sequence upkeep: keys are assigned ascending
+                // as with AUTOINCREMENT, only reuse after deleting the highest rows differs, which object tables
+                // never do, and adding AUTOINCREMENT later would require rebuilding the table
+                if (data_type == "int" && db_interface_.bulkMode())
+                    ss << " INTEGER PRIMARY KEY";
+                else if (data_type == "int") // mysql defaults autoincrement
                     ss << " INTEGER PRIMARY KEY AUTOINCREMENT";
                 else
                     ss << " " << data_type << " PRIMARY KEY";
             }
+            else if (connection_type == DUCKDB_IDENTIFIER)
+            {
+                if (data_type == "int") // no autoincrement, default from a sequence created before the table
+                {
+                    sequence = "CREATE SEQUENCE IF NOT EXISTS "+table.name()+"_key_seq; ";
+                    ss << " INTEGER PRIMARY KEY DEFAULT nextval('" << table.name() << "_key_seq')";
+                }
+                else
+                    ss << " " << data_type << " PRIMARY KEY";
+            }
             else
             {
                 assert (connection_type == MYSQL_IDENTIFIER);
@@ -150,7 +210,27 @@ std::string SQLGenerator::getCreateTableStatement (const DBTable& table)
 
     ss << ");";
 
-    loginf << "SQLGenerator: getCreateTableStatement: sql '" << ss.str() << "'";
+    loginf << "SQLGenerator: getCreateTableStatement: sql '" << sequence << ss.str() << "'";
+    return sequence+ss.str();
+}
+
+std::string SQLGenerator::getCreateIndexStatement (const DBTableIndex& index)
+{
+    std::vector<std::string> columns = index.columns();
+    assert (columns.size());
+
+    std::stringstream ss;
+
+    ss << "CREATE INDEX " << index.name() << " ON " << index.table().name() << " (";
+
+    for (unsigned int cnt=0; cnt < columns.size(); ++cnt)
+    {
+        assert (index.table().hasColumn(columns.at(cnt)));
+        ss << (cnt ? ", " : "") << columns.at(cnt);
+    }
+
+    ss << ");";
+
     return ss.str();
 }
 
@@ -444,10 +524,68 @@ std::string SQLGenerator::getCountStatement (const std::string &table)
     return "SELECT COUNT(*) FROM " + table + ";";
 }
 
+std::shared_ptr<DBCommand> SQLGenerator::getRowIdMinMaxCommand (const MetaDBTable &meta_table)
+{
+    std::shared_ptr<DBCommand> command (new DBCommand ());
+    command->set("SELECT MIN(rowid), MAX(rowid) FROM " + meta_table.mainTableName() + ";");
+
+    PropertyList list;
+    list.addProperty("min", PropertyDataType::LONGINT);
+    list.addProperty("max", PropertyDataType::LONGINT);
+    command->list(list);
+
+    return command;
+}
+
+std::string SQLGenerator::getRowIdRangeClause (const MetaDBTable &meta_table, long int from, long int to)
+{
+    std::stringstream ss;
+
+    ss << meta_table.mainTableName() << ".rowid BETWEEN " << from << " AND " << to;
+
+    return ss.str();
+}
+
+std::string SQLGenerator::getKeySetClause (const std::string& column_identifier)
+{
+    std::string connection_type = db_interface_.connection().type();
+
+    if (connection_type == SQLITE_IDENTIFIER)
+        return column_identifier+" IN (SELECT value FROM json_each(?))";
+    else if (connection_type == DUCKDB_IDENTIFIER)
+        return column_identifier+" IN (SELECT unnest(CAST(? AS BIGINT[])))";
+
+    throw std::runtime_error ("SQLGenerator: getKeySetClause: not supported for connection type "
+                              +connection_type);
+}
+
+DBCommandParameter SQLGenerator::getKeySetParameter (const std::vector<int>& keys)
+{
+    std::string value = "[";
+
+    for (auto& key : keys)
+    {
+        if (value.size() > 1)
+            value += ",";
+
+        value += std::to_string(key);
+    }
+
+    value += "]";
+
+    return DBCommandParameter (PropertyDataType::STRING, value);
+}
+
 std::shared_ptr <DBCommand> SQLGenerator::getTableSelectMinMaxNormalStatement (const DBTable& table)
 {
     logdbg  << "SQLGenerator: getTableSelectMinMaxNormalStatement: start for table " << table.name();
 
+    std::string key = "minmax#"+table.name();
+    std::shared_ptr<DBCommand> cached = cachedCommand(key);
+
+    if (cached)
+        return cached;
+
     stringstream ss;
 
     std::shared_ptr<DBCommand> command (new DBCommand ());
@@ -484,7 +622,7 @@ std::shared_ptr <DBCommand> SQLGenerator::getTableSelectMinMaxNormalStatement (c
 
     logdbg  << "SQLGenerator: getTableSelectMinMaxNormalStatement: sql '" << ss.str() << "'";
 
-    return command;
+    return cacheCommand(key, command);
 }
 
 //DBCommand *SQLGenerator::getColumnSelectMinMaxStatement (DBTableColumn *column, std::string table_name)
@@ -531,7 +669,7 @@ std::string SQLGenerator::getInsertPropertyStatement (const std::string &id, con
         logwrn << "SQLGenerator: getInsertPropertyStatement: value size very large (" << value.size() << ")";
 
     // REPLACE into table (id, name, age) values(1, "A", 19)
-    ss << "REPLACE INTO " << TABLE_NAME_PROPERTIES << " VALUES ('" << id <<"', '" << value <<"');";
+    ss << replaceInto() << TABLE_NAME_PROPERTIES << " VALUES ('" << id <<"', '" << value <<"');";
     return ss.str();
 }
 std::string SQLGenerator::getSelectPropertyStatement (const std::string &id)
@@ -545,7 +683,7 @@ std::string SQLGenerator::getInsertMinMaxStatement (const std::string& variable_
                                                     const std::string& min, const std::string& max)
 {
     stringstream ss;
-    ss << "REPLACE INTO " << TABLE_NAME_MINMAX << " VALUES ('" << variable_name <<"', '" << object_name <<"', '"
+    ss << replaceInto() << TABLE_NAME_MINMAX << " VALUES ('" << variable_name <<"', '" << object_name <<"', '"
        << min<< "', '"<< max <<"');";
     return ss.str();
 }
@@ -643,16 +781,18 @@ std::string SQLGenerator::getTablePropertiesCreateStatement ()
 //    return ss.str();
 //}
 
-std::string SQLGenerator::insertDBUpdateStringBind(std::shared_ptr<Buffer> buffer, std::string tablename)
+std::string SQLGenerator::insertDBUpdateStringBind(std::shared_ptr<Buffer> buffer, std::string tablename,
+                                                   unsigned int rows)
 {
     assert (buffer);
     //assert (object.existsInDB());
     //assert (key_var.existsInDB());
     assert (tablename.size() > 0);
+    assert (rows > 0);
 
     const std::vector <Property> &properties = buffer->properties().properties();
 
-    // INSERT INTO table_name (column1, column2, column3, ...) VALUES (value1, value2, value3, ...);
+    // INSERT INTO table_name (column1, column2, column3, ...) VALUES (value1, value2, value3, ...), (...);
 
     unsigned int size = properties.size();
     logdbg  << "SQLGenerator: insertDBUpdateStringBind: creating db string";
@@ -662,30 +802,44 @@ std::string SQLGenerator::insertDBUpdateStringBind(std::shared_ptr<Buffer> buffe
 
     std::string connection_type = db_interface_.connection().type();
 
-    if (connection_type != SQLITE_IDENTIFIER && connection_type != MYSQL_IDENTIFIER)
+    if (connection_type != SQLITE_IDENTIFIER && connection_type != MYSQL_IDENTIFIER
+            && connection_type != DUCKDB_IDENTIFIER)
         throw std::runtime_error ("SQLGenerator: insertDBUpdateStringBind: not yet implemented db type "
                                   + connection_type);
 
-    std::stringstream values_ss;
-    values_ss << "VALUES (";
-
     for (unsigned int cnt=0; cnt < size; cnt++)
     {
         ss << properties.at(cnt).name();
 
-        if (connection_type == SQLITE_IDENTIFIER)
-            values_ss << "@VAR"+std::to_string(cnt+1);
-        else if (connection_type == MYSQL_IDENTIFIER)
-            values_ss << "%"+std::to_string(cnt+1);
-
         if (cnt != size-1)
-        {
             ss << ", ";
-            values_ss << ", ";
+    }
+
+    ss << ") VALUES ";
+
+    for (unsigned int row=0; row < rows; row++)
+    {
+        ss << (row ? ", (" : "(");
+
+        for (unsigned int cnt=0; cnt < size; cnt++)
+        {
+            unsigned int index = row*size+cnt+1;
+
+            if (connection_type == SQLITE_IDENTIFIER)
+                ss << "@VAR"+std::to_string(index);
+            else if (connection_type == MYSQL_IDENTIFIER)
+                ss << "%"+std::to_string(index);
+            else if (connection_type == DUCKDB_IDENTIFIER)
+                ss << "$"+std::to_string(index);
+
+            if (cnt != size-1)
+                ss << ", ";
         }
+
+        ss << ")";
     }
 
-    ss << ") " << values_ss.str() << ");";
+    ss << ";";
 
     logdbg << "SQLGenerator: insertDBUpdateStringBind: var insert string '" << ss.str() << "'";
 
@@ -724,7 +878,8 @@ std::string SQLGenerator::createDBUpdateStringBind(std::shared_ptr<Buffer> buffe
 
     std::string connection_type = db_interface_.connection().type();
 
-    if (connection_type != SQLITE_IDENTIFIER && connection_type != MYSQL_IDENTIFIER)
+    if (connection_type != SQLITE_IDENTIFIER && connection_type != MYSQL_IDENTIFIER
+            && connection_type != DUCKDB_IDENTIFIER)
         throw std::runtime_error ("SQLGenerator: createDBUpdateStringBind: not yet implemented db type "
                                   + connection_type);
 
@@ -744,6 +899,8 @@ std::string SQLGenerator::createDBUpdateStringBind(std::shared_ptr<Buffer> buffe
             ss << "@VAR"+std::to_string(cnt+1);
         else if (connection_type == MYSQL_IDENTIFIER)
             ss << "%"+std::to_string(cnt+1);
+        else if (connection_type == DUCKDB_IDENTIFIER)
+            ss << "$"+std::to_string(cnt+1);
 
         if (cnt != size-2)
         {
@@ -757,6 +914,8 @@ std::string SQLGenerator::createDBUpdateStringBind(std::shared_ptr<Buffer> buffe
         ss << "@VAR" << std::to_string (size);
     else if (connection_type == MYSQL_IDENTIFIER)
         ss << "%" << std::to_string (size);
+    else if (connection_type == DUCKDB_IDENTIFIER)
+        ss << "$" << std::to_string (size);
 
     ss << ";";
 
@@ -888,12 +1047,43 @@ std::string SQLGenerator::createDBUpdateStringBind(std::shared_ptr<Buffer> buffe
 std::shared_ptr<DBCommand> SQLGenerator::getSelectCommand (
         const MetaDBTable &meta_table, DBOVariableSet read_list, const std::string &filter,
         std::vector <DBOVariable*> filtered_variables, bool use_order, DBOVariable *order_variable,
-        bool use_order_ascending, const std::string &limit, bool left_join)
+        bool use_order_ascending, const std::string &limit, bool left_join, bool use_cache)
 {
     logdbg  << "SQLGenerator: getSelectCommand: meta table " << meta_table.name() << " read list size "
             << read_list.getSize();
     assert (read_list.getSize() != 0);
 
+    std::string key = "select#"+meta_table.name()+"#";
+
+    for (auto& sub_it : meta_table.subTableDefinitions()) // joins, also valid after schema edits
+        key += sub_it.first+":"+sub_it.second->mainTableKey()+"="+sub_it.second->subTableKey()+",";
+
+    key += "#";
+
+    for (auto var_it : read_list.getSet ())
+        key += var_it->currentDBColumn().identifier()+":"+std::to_string(static_cast<int>(var_it->dataType()))+",";
+
+    key += "#"+filter+"#";
+
+    for (auto var_it : filtered_variables)
+        key += var_it->currentDBColumn().identifier()+",";
+
+    if (use_order)
+    {
+        assert (order_variable);
+        key += "#"+order_variable->currentDBColumn().identifier()+(use_order_ascending ? " ASC" : " DESC");
+    }
+
+    key += "#"+limit+(left_join ? "#left" : "#");
+
+    std::shared_ptr<DBCommand> cached = use_cache ? cachedCommand(key) : nullptr;
+
+    if (cached)
+    {
+        logdbg  << "SQLGenerator: getSelectCommand: cached command sql '" << cached->get() << "'";
+        return cached;
+    }
+
     std::shared_ptr<DBCommand> command = std::make_shared<DBCommand>(DBCommand());
 
     std::stringstream ss;
@@ -1068,7 +1258,10 @@ std::shared_ptr<DBCommand> SQLGenerator::getSelectCommand (
 
     logdbg  << "SQLGenerator: getSelectCommand: command sql '" << ss.str() << "'";
 
-    return command;
+    if (!use_cache)
+        return command;
+
+    return cacheCommand(key, command);
 }
 
 std::shared_ptr<DBCommand> SQLGenerator::getSelectCommand (const MetaDBTable &meta_table,
@@ -1078,6 +1271,18 @@ std::shared_ptr<DBCommand> SQLGenerator::getSelectCommand (const MetaDBTable &me
             << columns.size();
     assert (columns.size() != 0);
 
+    std::string key = "columns#"+meta_table.name()+"#";
+
+    for (auto col_it : columns)
+        key += col_it->identifier()+":"+std::to_string(static_cast<int>(col_it->propertyType()))+",";
+
+    key += distinct ? "#distinct" : "#";
+
+    std::shared_ptr<DBCommand> cached = cachedCommand(key);
+
+    if (cached)
+        return cached;
+
     std::shared_ptr<DBCommand> command = std::make_shared<DBCommand>(DBCommand());
 
     std::stringstream ss;
@@ -1144,7 +1349,86 @@ std::shared_ptr<DBCommand> SQLGenerator::getSelectCommand (const MetaDBTable &me
 
     logdbg  << "SQLGenerator: getSelectCommand: command sql '" << ss.str() << "'";
 
-    return command;
+    return cacheCommand(key, command);
+}
+
+std::string SQLGenerator::planFilter (const MetaDBTable &meta_table, DBOVariableSet& read_list,
+                                      DBOVariable* order_variable, SQLPredicates predicates,
+                                      DBCommandParameters& parameters, std::vector <DBOVariable*>& filtered_variables)
+{
+    // tables joined anyway
+    std::set <std::string> joined_tables;
+    joined_tables.insert(meta_table.mainTableName());
+
+    for (auto var_it : read_list.getSet ())
+        joined_tables.insert(var_it->currentDBColumn().table().name());
+
+    if (order_variable)
+        joined_tables.insert(meta_table.tableFor(order_variable->currentDBColumn().identifier()).name());
+
+    for (auto& predicate : predicates) // rows without sub-table row could match
+        if (!predicate.null_rejecting_)
+            joined_tables.insert(predicate.table_name_);
+
+    std::stable_sort(predicates.begin(), predicates.end(), [] (const SQLPredicate& a, const SQLPredicate& b)
+                     { return a.selectivity_ < b.selectivity_; });
+
+    std::stringstream ss;
+    std::set <std::string> pushed_tables;
+
+    for (auto& predicate : predicates)
+    {
+        bool pushed = !joined_tables.count(predicate.table_name_)
+                && meta_table.hasSubTable(predicate.table_name_);
+
+        if (pushed && pushed_tables.count(predicate.table_name_)) // already added with first predicate of table
+            continue;
+
+        if (ss.str().size())
+            ss << " AND ";
+
+        if (!pushed)
+        {
+            ss << "(" << predicate.condition_ << ")";
+            parameters.insert(parameters.end(), predicate.parameters_.begin(), predicate.parameters_.end());
+
+            if (std::find (filtered_variables.begin(), filtered_variables.end(), predicate.variable_)
+                    == filtered_variables.end())
+                filtered_variables.push_back(predicate.variable_);
+
+            continue;
+        }
+
+        pushed_tables.insert(predicate.table_name_);
+        auto subtable = meta_table.subTableDefinitions().at(predicate.table_name_);
+
+        ss << meta_table.mainTableName() << "." << subtable->mainTableKey() << " IN (SELECT "
+           << predicate.table_name_ << "." << subtable->subTableKey() << " FROM " << predicate.table_name_
+           << " WHERE ";
+
+        bool first = true;
+
+        for (auto& table_predicate : predicates)
+        {
+            if (table_predicate.table_name_ != predicate.table_name_)
+                continue;
+
+            if (!first)
+                ss << " AND ";
+
+            ss << "(" << table_predicate.condition_ << ")";
+            parameters.insert(parameters.end(), table_predicate.parameters_.begin(),
+                              table_predicate.parameters_.end());
+            first = false;
+        }
+
+        ss << ")";
+    }
+
+    logdbg << "SQLGenerator: planFilter: meta table " << meta_table.name() << " " << predicates.size()
+           << " predicates, " << pushed_tables.size() << " sub-tables pushed down, filter '" << ss.str() << "'";
+
+    return ss.str();
 }
 
 std::string SQLGenerator::subTablesWhereClause(const MetaDBTable &meta_table,
@@ -1221,3 +1505,10 @@ std::string SQLGenerator::subTableKeyClause (const MetaDBTable &meta_table, cons
 //    return "SHOW DATABASES LIKE 'job%';"; // wow so hard so many dabes
 //}
 
+std::string SQLGenerator::replaceInto ()
+{
+    if (db_interface_.connection().type() == DUCKDB_IDENTIFIER)
+        return "INSERT OR REPLACE INTO ";
+
+    return "REPLACE INTO ";
+}
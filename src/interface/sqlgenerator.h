@@ -18,23 +18,29 @@
 #ifndef SQLGENERATOR_H_
 #define SQLGENERATOR_H_
 
+#include <map>
 #include <memory>
 
+#include <QMutex>
+
 #include "dbovariableset.h"
+#include "dbcommand.h"
+#include "sqlpredicate.h"
 
 class Buffer;
-class DBCommand;
 class DBCommandList;
 class DBInterface;
 class MetaDBTable;
 class DBTableColumn;
 class DBObject;
 class DBTable;
+class DBTableIndex;
 
 /**
  * @brief Creates SQL statements
  *
  * Returns SQL strings and commands for database functions. All DBCommands and DBCommandLists have to be deleted by the caller.
+ * Select commands are cached by their arguments, the cache has to be cleared when table definitions change.
  *
  * \todo Generalize stuff
  */
@@ -46,9 +52,15 @@ public:
     /// @brief Destructor
     virtual ~SQLGenerator();
 
+    /// @brief Removes all cached commands
+    void clearCache ();
+
     std::string getCreateTableStatement (const DBTable& table);
-    /// @brief Returns statement to bind variables for buffer contents
-    std::string insertDBUpdateStringBind(std::shared_ptr<Buffer> buffer, std::string tablename);
+    /// @brief Returns statement creating a secondary index
+    std::string getCreateIndexStatement (const DBTableIndex& index);
+    /// @brief Returns statement to bind variables for buffer contents, for rows rows with consecutive indexes
+    std::string insertDBUpdateStringBind(std::shared_ptr<Buffer> buffer, std::string tablename,
+                                         unsigned int rows=1);
 //    std::string createDBInsertStringBind(Buffer *buffer, const std::string &tablename);
     /// @brief Returns statement to bind variables for buffer contents
     std::string createDBUpdateStringBind(std::shared_ptr<Buffer> buffer, const DBTableColumn& key_col,
@@ -56,14 +68,23 @@ public:
 //    /// @brief Returns statement to create table for buffer contents
 //    std::string createDBCreateString (Buffer *buffer, const std::string &tablename);
 
-    /// @brief Returns general select statement
+    /// @brief Returns general select statement, cached unless use_cache is false, e.g. for one-off filters
     std::shared_ptr<DBCommand> getSelectCommand (const MetaDBTable &meta_table, DBOVariableSet read_list,
             const std::string &filter, std::vector <DBOVariable *> filtered_variables, bool use_order=false,
                                                  DBOVariable *order_variable=nullptr, bool use_order_ascending=false,
-            const std::string &limit="", bool left_join=false);
+            const std::string &limit="", bool left_join=false, bool use_cache=true);
 
     std::shared_ptr<DBCommand> getSelectCommand (const MetaDBTable &meta_table,
                                                  std::vector <const DBTableColumn*> columns, bool distinct=false);
+
+    /// @brief Returns filter clause of AND-connected predicates for a read, most selective first
+    ///
+    /// Predicates on sub-tables not needed for read list or order are pushed into subqueries on the sub-table key
+    /// instead of joining the sub-table. Sets the parameters in placeholder order and the variables still filtered
+    /// in joined tables, to be passed to getSelectCommand.
+    std::string planFilter (const MetaDBTable &meta_table, DBOVariableSet& read_list, DBOVariable* order_variable,
+                            SQLPredicates predicates, DBCommandParameters& parameters,
+                            std::vector <DBOVariable*>& filtered_variables);
     ///@brief Returns command for all data sources select for dbo
     std::shared_ptr<DBCommand> getDataSourcesSelectCommand (DBObject &object);
 
@@ -76,8 +97,19 @@ public:
 //    std::string getContainsStatement (const std::string &table_name);
     /// @brief Returns statement to query number of records
     std::string getCountStatement (const std::string &table);
+    /// @brief Returns command for minimum/maximum SQLite rowid of the main table, as "min" and "max"
+    std::shared_ptr<DBCommand> getRowIdMinMaxCommand (const MetaDBTable &meta_table);
+    /// @brief Returns filter clause for main table SQLite rowids in [from, to]
+    std::string getRowIdRangeClause (const MetaDBTable &meta_table, long int from, long int to);
     //DBCommand *getCountStatement (const DBObject &object, unsigned int sensor_number);
 
+    /// @brief Returns filter clause matching column against the keys of the getKeySetParameter placeholder
+    ///
+    /// Keys are bound as one JSON array, so the statement stays the same for any number of keys.
+    std::string getKeySetClause (const std::string& column_identifier);
+    /// @brief Returns parameter of keys for getKeySetClause
+    DBCommandParameter getKeySetParameter (const std::vector<int>& keys);
+
     /// @brief Returns minimum/maximum table creation statement
     std::string getTableMinMaxCreateStatement ();
     /// @brief Returns properties table creation statement
@@ -124,10 +156,23 @@ protected:
     /// Properties table create SQL statement
     std::string table_properties_create_statement_;
 
+    /// Generated select commands by fingerprint of their arguments, copies are returned
+    std::map <std::string, std::shared_ptr<DBCommand>> command_cache_;
+    static const size_t MAX_CACHED_COMMANDS = 256;
+    /// Protects command_cache_, select commands are also generated for concurrent reads
+    QMutex command_cache_mutex_;
+
+    /// @brief Returns copy of cached command for key, nullptr if not cached
+    std::shared_ptr<DBCommand> cachedCommand (const std::string& key);
+    /// @brief Adds command to cache, returns copy of it
+    std::shared_ptr<DBCommand> cacheCommand (const std::string& key, std::shared_ptr<DBCommand> command);
+
     /// @brief Returns SQL where clause with all used meta sub-tables
     std::string subTablesWhereClause (const MetaDBTable &meta_table, const std::vector <std::string> &used_tables);
     /// @brief Returns SQL key clause for a give meta sub-table
     std::string subTableKeyClause (const MetaDBTable &meta_table, const std::string &sub_table_name);
+    /// @brief Returns insert-or-replace clause of the connection type, with trailing space
+    std::string replaceInto ();
 };
 
 #endif /* SQLGENERATOR_H_ */
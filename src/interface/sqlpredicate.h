@@ -0,0 +1,51 @@
+/*
+ * This file is part of ATSDB.
+ *
+ * ATSDB is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * ATSDB is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with ATSDB.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef SQLPREDICATE_H_
+#define SQLPREDICATE_H_
+
+#include <string>
+#include <vector>
+
+#include "dbcommand.h"
+
+class DBOVariable;
+
+/**
+ * @brief Condition of a read filter on the columns of one table, all predicates of a filter are AND-connected
+ *
+ * Used by SQLGenerator::planFilter to decide which meta sub-tables are joined and which are only filtered.
+ */
+struct SQLPredicate
+{
+    /// Filtered variable
+    DBOVariable* variable_ {nullptr};
+    /// Name of the database table of the filtered column
+    std::string table_name_;
+    /// SQL condition, columns qualified with the table name
+    std::string condition_;
+    /// Values of the placeholders in condition_
+    DBCommandParameters parameters_;
+    /// If rows without a matching sub-table row can not fulfill the condition, e.g. not for IS NULL
+    bool null_rejecting_ {true};
+    /// Estimated fraction of matching rows, 1 if unknown
+    double selectivity_ {1.0};
+};
+
+using SQLPredicates = std::vector<SQLPredicate>;
+
+#endif /* SQLPREDICATE_H_ */
@@ -0,0 +1,49 @@
+/*
+ * This file is part of ATSDB.
+ *
+ * ATSDB is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * ATSDB is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with ATSDB.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include "dboreadcachejob.h"
+#include "buffer.h"
+#include "logger.h"
+
+DBOReadCacheJob::DBOReadCacheJob(const BufferCache& cache, const std::string& dbo_name)
+    : Job("DBOReadCacheJob"), cache_(cache), dbo_name_(dbo_name)
+{
+}
+
+DBOReadCacheJob::~DBOReadCacheJob()
+{
+
+}
+
+void DBOReadCacheJob::run ()
+{
+    logdbg << "DBOReadCacheJob: run: " << dbo_name_ << ": start";
+    started_ = true;
+
+    if (obsolete_)
+    {
+        logdbg << "DBOReadCacheJob: run: " << dbo_name_ << ": obsolete before reading";
+        done_=true;
+        return;
+    }
+
+    buffer_ = cache_.read(dbo_name_);
+
+    logdbg << "DBOReadCacheJob: run: " << dbo_name_ << ": done, read " << (buffer_ ? buffer_->size() : 0);
+    done_=true;
+}
@@ -15,35 +15,34 @@
  * along with ATSDB.  If not, see <http://www.gnu.org/licenses/>.
  */
 
-#ifndef FINALIZEDBOREADJOB_H_
-#define FINALIZEDBOREADJOB_H_
+
+#ifndef DBOREADCACHEJOB_H_
+#define DBOREADCACHEJOB_H_
 
 #include "job.h"
-#include "global.h"
-#include "dbovariableset.h"
+#include "buffercache.h"
 
-class DBObject;
 class Buffer;
 
 /**
- * @brief Finalizes read DBObject data from DBOReadDBJob
+ * @brief DBO reading job from a BufferCache file
  *
- * Uses finalizeDBData() from Util.
+ * Buffer is nullptr after run if the cache file could not be read.
  */
-class FinalizeDBOReadJob : public Job
+class DBOReadCacheJob : public Job
 {
 public:
-    FinalizeDBOReadJob (DBObject &dbobject, DBOVariableSet &read_list, std::shared_ptr<Buffer> buffer);
-    virtual ~FinalizeDBOReadJob();
+    DBOReadCacheJob (const BufferCache& cache, const std::string& dbo_name);
+    virtual ~DBOReadCacheJob();
 
     virtual void run ();
 
-    std::shared_ptr<Buffer> buffer () { assert (buffer_); return buffer_; }
+    std::shared_ptr<Buffer> buffer () { return buffer_; }
 
 protected:
-    DBObject &dbobject_;
-    DBOVariableSet read_list_;
+    BufferCache cache_;
+    std::string dbo_name_;
     std::shared_ptr<Buffer> buffer_;
 };
 
-#endif /* FINALIZEDBOREADJOB_H_ */
+#endif /* DBOREADCACHEJOB_H_ */
@@ -21,16 +21,21 @@
 #include "propertylist.h"
 #include "dbinterface.h"
 #include "buffer.h"
+#include "bufferpool.h"
 #include "logger.h"
 
+#include <algorithm>
+#include <thread>
+
 DBOReadDBJob::DBOReadDBJob(DBInterface &db_interface, DBObject &dbobject, DBOVariableSet read_list,
-                           std::string custom_filter_clause, std::vector <DBOVariable*> filtered_variables,
-                           bool use_order, DBOVariable *order_variable, bool use_order_ascending,
-                           const std::string &limit_str)
+                           std::string custom_filter_clause, const DBCommandParameters& parameters,
+                           std::vector <DBOVariable*> filtered_variables, bool use_order,
+                           DBOVariable *order_variable, bool use_order_ascending, const std::string &limit_str)
 : Job("DBOReadDBJob"), db_interface_(db_interface), dbobject_(dbobject), read_list_(read_list),
-  custom_filter_clause_ (custom_filter_clause), filtered_variables_(filtered_variables),
+  custom_filter_clause_ (custom_filter_clause), parameters_(parameters), filtered_variables_(filtered_variables),
   use_order_(use_order), order_variable_(order_variable), use_order_ascending_(use_order_ascending),
-  limit_str_(limit_str)
+  limit_str_(limit_str), buffer_pool_(std::make_shared<BufferPool>()),
+  prefetch_depth_(std::max (1u, db_interface_.readPrefetchDepth()))
 {
     assert (dbobject_.existsInDB());
 
@@ -63,37 +68,75 @@ void DBOReadDBJob::run ()
 
     start_time_ = boost::posix_time::microsec_clock::local_time();
 
-    db_interface_.prepareRead (dbobject_, read_list_, custom_filter_clause_, filtered_variables_, use_order_,
-                               order_variable_, use_order_ascending_, limit_str_);
+    unsigned int read_id = db_interface_.prepareRead (dbobject_, read_list_, custom_filter_clause_, parameters_,
+                                                      filtered_variables_, use_order_, order_variable_,
+                                                      use_order_ascending_, limit_str_);
+
+    // the shared connection is locked until finalized, waiting on the GUI merge there would block its queries
+    bool own_connection = read_id != 0;
+
+    std::thread transform_thread (&DBOReadDBJob::transform, this);
 
-    unsigned int cnt=0;
     unsigned int row_count=0;
-    while (!done_)
+
+    try
     {
-        std::shared_ptr<Buffer> buffer = db_interface_.readDataChunk(dbobject_);
-        assert (buffer);
+        unsigned int cnt=0;
 
-        cnt++;
+        while (!obsolete_)
+        {
+            std::shared_ptr<Buffer> buffer = db_interface_.readDataChunk(dbobject_, read_id, buffer_pool_);
+            assert (buffer);
+            assert (buffer->dboName() == dbobject_.name());
+
+            cnt++;
+            row_count += buffer->size();
+            bool last_one = buffer->lastOne();
+
+            logdbg << "DBOReadDBJob: run: " << dbobject_.name() << ": read #buffers " << cnt << " last one "
+                   << last_one;
+
+            {
+                std::unique_lock<std::mutex> lock (pipeline_mutex_);
+                pipeline_condition_.wait(lock, [this, own_connection]
+                { return obsolete_ || !own_connection || read_queue_.size() < prefetch_depth_; });
+                read_queue_.push_back(buffer);
+            }
+            pipeline_condition_.notify_all();
+
+            if (last_one)
+                break;
+        }
+    }
+    catch (std::exception& e) // transform thread has to be joined before unwinding
+    {
+        logerr << "DBOReadDBJob: run: " << dbobject_.name() << ": read failed with '" << e.what() << "'";
 
-        if (obsolete_)
         {
-            loginf << "DBOReadDBJob: run: " << dbobject_.name() << ": obsolete after prepared";
-            break;
+            std::lock_guard<std::mutex> lock (pipeline_mutex_);
+            reading_done_ = true;
         }
+        pipeline_condition_.notify_all();
 
-        assert (buffer->dboName() == dbobject_.name());
+        transform_thread.join();
+        db_interface_.finalizeReadStatement(dbobject_, read_id);
 
-        logdbg << "DBOReadDBJob: run: " << dbobject_.name() << ": intermediate signal, #buffers "
-               << cnt << " last one " << buffer->lastOne();
-        row_count += buffer->size();
-        emit intermediateSignal(buffer);
+        throw;
+    }
 
-        if (buffer->lastOne())
-            break;
+    if (obsolete_)
+        loginf << "DBOReadDBJob: run: " << dbobject_.name() << ": obsolete after prepared";
+
+    {
+        std::lock_guard<std::mutex> lock (pipeline_mutex_);
+        reading_done_ = true;
     }
+    pipeline_condition_.notify_all();
 
     loginf << "DBOReadDBJob: run: " << dbobject_.name() << ": finalizing statement";
-    db_interface_.finalizeReadStatement(dbobject_);
+    db_interface_.finalizeReadStatement(dbobject_, read_id); // remaining chunks are transformed without the database
+
+    transform_thread.join();
 
     stop_time_ = boost::posix_time::microsec_clock::local_time();
     boost::posix_time::time_duration diff = stop_time_ - start_time_;
@@ -108,3 +151,58 @@ void DBOReadDBJob::run ()
     loginf << "DBOReadDBJob: run: " << dbobject_.name() << ": done";
     return;
 }
+
+void DBOReadDBJob::setObsolete ()
+{
+    {
+        std::lock_guard<std::mutex> lock (pipeline_mutex_);
+        Job::setObsolete();
+    }
+    pipeline_condition_.notify_all(); // wakes waiting stages
+}
+
+void DBOReadDBJob::bufferMerged ()
+{
+    {
+        std::lock_guard<std::mutex> lock (pipeline_mutex_);
+        assert (unmerged_);
+        --unmerged_;
+    }
+    pipeline_condition_.notify_all();
+}
+
+void DBOReadDBJob::transform ()
+{
+    while (true)
+    {
+        std::shared_ptr<Buffer> buffer;
+
+        {
+            std::unique_lock<std::mutex> lock (pipeline_mutex_);
+            pipeline_condition_.wait(lock, [this] { return obsolete_ || reading_done_ || read_queue_.size(); });
+
+            if (obsolete_ || read_queue_.empty()) // all read chunks emitted
+                break;
+
+            buffer = read_queue_.front();
+            read_queue_.pop_front();
+        }
+        pipeline_condition_.notify_all(); // space for next chunk
+
+        buffer->transformVariables(read_list_, true);
+
+        {
+            std::unique_lock<std::mutex> lock (pipeline_mutex_);
+            pipeline_condition_.wait(lock, [this] { return obsolete_ || unmerged_ < prefetch_depth_; });
+
+            if (obsolete_)
+                break;
+
+            ++unmerged_;
+        }
+
+        logdbg << "DBOReadDBJob: transform: " << dbobject_.name() << ": intermediate signal, size "
+               << buffer->size();
+        emit intermediateSignal(buffer);
+    }
+}
@@ -20,10 +20,16 @@
 
 #include "boost/date_time/posix_time/posix_time.hpp"
 
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+
 #include "job.h"
 #include "dbovariableset.h"
+#include "dbcommand.h"
 
 class Buffer;
+class BufferPool;
 class DBObject;
 class DBInterface;
 
@@ -32,6 +38,11 @@ class DBInterface;
  *
  * Incrementally reads data record from DBO tables and writes the results into a DBDataSet.
  *
+ * Runs as a pipeline: the job thread reads chunks, an own thread transforms them to DBO variables and emits
+ * them, DBObject merges them in the GUI thread and calls bufferMerged. Each stage runs at most the prefetch
+ * depth of chunks ahead of the next one, so chunk N+1 is read while chunk N is transformed and memory stays
+ * bounded if merging is slow. Reads on the shared connection are not bounded, they release the connection
+ * before waiting on the GUI thread.
  */
 class DBOReadDBJob : public Job
 {
@@ -41,11 +52,16 @@ signals:
 
 public:
     DBOReadDBJob(DBInterface &db_interface, DBObject &dbobject, DBOVariableSet read_list, std::string custom_filter_clause,
-                 std::vector <DBOVariable *> filtered_variables, bool use_order, DBOVariable *order_variable,
-                 bool use_order_ascending, const std::string &limit_str);
+                 const DBCommandParameters& parameters, std::vector <DBOVariable *> filtered_variables,
+                 bool use_order, DBOVariable *order_variable, bool use_order_ascending, const std::string &limit_str);
     virtual ~DBOReadDBJob();
 
     virtual void run ();
+    virtual bool readOnly () const { return true; }
+    virtual void setObsolete ();
+
+    /// @brief Called after a buffer of intermediateSignal was merged, allows further ones to be emitted
+    void bufferMerged ();
 
     DBOVariableSet &readList () { return read_list_; }
 
@@ -54,12 +70,30 @@ protected:
     DBObject &dbobject_;
     DBOVariableSet read_list_;
     std::string custom_filter_clause_;
+    DBCommandParameters parameters_;
     std::vector <DBOVariable *> filtered_variables_;
     bool use_order_;
     DBOVariable *order_variable_;
     bool use_order_ascending_;
     std::string limit_str_;
 
+    /// Recycled chunk storage of this read
+    std::shared_ptr<BufferPool> buffer_pool_;
+
+    /// Maximum number of chunks waiting for transformation, and of emitted chunks waiting to be merged
+    unsigned int prefetch_depth_;
+    /// Protects the pipeline state and obsolete_
+    std::mutex pipeline_mutex_;
+    std::condition_variable pipeline_condition_;
+    /// Read chunks not yet transformed
+    std::deque<std::shared_ptr<Buffer>> read_queue_;
+    bool reading_done_ {false};
+    /// Number of emitted chunks not yet merged
+    unsigned int unmerged_ {0};
+
+    /// @brief Transformation stage, runs in own thread until all read chunks are emitted
+    void transform ();
+
     boost::posix_time::ptime start_time_;
     boost::posix_time::ptime stop_time_;
 };
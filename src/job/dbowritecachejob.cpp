@@ -15,32 +15,33 @@
  * along with ATSDB.  If not, see <http://www.gnu.org/licenses/>.
  */
 
-#include <QThread>
 
-#include "finalizedboreadjob.h"
-#include "dbobject.h"
-#include "dbovariableset.h"
+#include "dbowritecachejob.h"
 #include "buffer.h"
+#include "logger.h"
 
-FinalizeDBOReadJob::FinalizeDBOReadJob(DBObject &dbobject, DBOVariableSet &read_list, std::shared_ptr<Buffer> buffer)
-    : Job("FinalizeDBOReadJob"), dbobject_(dbobject), read_list_(read_list), buffer_ (buffer)
+DBOWriteCacheJob::DBOWriteCacheJob(const BufferCache& cache, std::shared_ptr<Buffer> buffer,
+                                   size_t max_cache_bytes)
+    : Job("DBOWriteCacheJob"), cache_(cache), buffer_(buffer), max_cache_bytes_(max_cache_bytes)
 {
     assert (buffer_);
 }
 
-FinalizeDBOReadJob::~FinalizeDBOReadJob()
+DBOWriteCacheJob::~DBOWriteCacheJob()
 {
 
 }
 
-void FinalizeDBOReadJob::run ()
+void DBOWriteCacheJob::run ()
 {
-    logdbg << "FinalizeDBOReadJob: run: read_list size " << read_list_.getSize();
+    logdbg << "DBOWriteCacheJob: run: " << cache_.fileName() << ": start";
     started_ = true;
 
-    buffer_->transformVariables(read_list_, true);
+    if (cache_.write(*buffer_))
+        cache_.limitDirectory(max_cache_bytes_);
 
-    logdbg << "FinalizeDBOReadJob: run: done";
+    buffer_ = nullptr; // releases shared data
+
+    logdbg << "DBOWriteCacheJob: run: " << cache_.fileName() << ": done";
     done_=true;
 }
-
@@ -0,0 +1,46 @@
+/*
+ * This file is part of ATSDB.
+ *
+ * ATSDB is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * ATSDB is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with ATSDB.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef DBOWRITECACHEJOB_H_
+#define DBOWRITECACHEJOB_H_
+
+#include "job.h"
+#include "buffercache.h"
+
+class Buffer;
+
+/**
+ * @brief Writes loaded DBO data to a BufferCache file, then limits the size of the cache directory
+ *
+ * Buffer must not be accessed by other threads while running, e.g. a partial copy sharing the loaded data.
+ */
+class DBOWriteCacheJob : public Job
+{
+public:
+    DBOWriteCacheJob (const BufferCache& cache, std::shared_ptr<Buffer> buffer, size_t max_cache_bytes);
+    virtual ~DBOWriteCacheJob();
+
+    virtual void run ();
+
+protected:
+    BufferCache cache_;
+    std::shared_ptr<Buffer> buffer_;
+    size_t max_cache_bytes_;
+};
+
+#endif /* DBOWRITECACHEJOB_H_ */
@@ -53,13 +53,16 @@ public:
     bool done () { return done_; }
     void emitDone () { emit doneSignal(); }
     // @brief Sets obsolete flag
-    void setObsolete () { obsolete_=true; }
+    virtual void setObsolete () { obsolete_=true; }
     // @brief Returns obsolete flag
     bool obsolete () { return obsolete_; }
     void emitObsolete () { emit doneSignal(); }
 
     const std::string &name() { return name_; }
 
+    /// @brief Returns if job only reads the database, such DB jobs may run concurrently
+    virtual bool readOnly () const { return false; }
+
 protected:
     std::string name_;
     ///
@@ -32,6 +32,8 @@ JobManager::JobManager()
       widget_(nullptr)
 {
     logdbg  << "JobManager: constructor";
+
+    registerParameter ("max_concurrent_db_reads", &max_concurrent_db_reads_, 4);
 }
 
 JobManager::~JobManager()
@@ -76,7 +78,19 @@ void JobManager::cancelJob (std::shared_ptr<Job> job)
 
 bool JobManager::noJobs ()
 {
-    return jobs_.empty() && non_blocking_jobs_.empty() && !active_db_job_ && queued_db_jobs_.empty();
+    QMutexLocker locker(&active_db_jobs_mutex_);
+    return jobs_.empty() && non_blocking_jobs_.empty() && active_db_jobs_.empty() && pending_db_jobs_.empty()
+            && queued_db_jobs_.empty();
+}
+
+bool JobManager::canStartDBJob (const Job& job)
+{
+    if (active_db_jobs_.empty())
+        return true;
+
+    // writing jobs run alone, all active are read-only if the first one is
+    return job.readOnly() && active_db_jobs_.front()->readOnly()
+            && active_db_jobs_.size() < max_concurrent_db_reads_;
 }
 
 /**
@@ -192,49 +206,58 @@ void JobManager::run()
         //            }
         //        }
 
-        if (active_db_job_)
+        active_db_jobs_mutex_.lock();
+
+        for (auto it = active_db_jobs_.begin(); it != active_db_jobs_.end();)
         {
-            // see if active db job done or obsolete
-            if(active_db_job_->obsolete())
+            // see if active db job done or obsolete, obsolete ones flushed after finish
+            std::shared_ptr<Job> current = *it;
+
+            if (!current->done())
             {
-                logdbg << "JobManager: run: flushing db obsolete job";
+                ++it;
+                continue;
+            }
 
-                while (!active_db_job_->done()) // wait for finish
-                {
-                    logdbg << "JobManager: run: waiting to obsolete finish";
-                    //QCoreApplication::processEvents(QEventLoop::ExcludeUserInputEvents);
-                    msleep(10);
-                }
+            if(current->obsolete())
+            {
+                logdbg << "JobManager: run: flushing db obsolete job";
 
                 if (!stop_requested_)
-                    active_db_job_->emitObsolete();
-
-                active_db_job_ = nullptr;
-                changed = true;
+                    current->emitObsolete();
             }
-            else if (active_db_job_->done())
+            else
             {
                 logdbg << "JobManager: run: flushing db done job";
 
                 if (!stop_requested_)
-                    active_db_job_->emitDone();
-
+                    current->emitDone();
 
-                active_db_job_ = nullptr;
-                changed = true;
                 really_update_widget = true;
             }
+
+            it = active_db_jobs_.erase(it);
+            changed = true;
         }
 
-        while (!active_db_job_ && !queued_db_jobs_.empty())
+        std::shared_ptr<Job> queued;
+
+        while (queued_db_jobs_.try_pop(queued)) // queue is pushed from other threads, only popped here
+            pending_db_jobs_.push_back(queued);
+
+        while (!pending_db_jobs_.empty())
         {
-            // start a new one if needed
-            std::shared_ptr<Job> current;
-            queued_db_jobs_.try_pop(current);
+            // start new ones if possible, in order of addition
+            std::shared_ptr<Job> current = pending_db_jobs_.front();
 
             assert (current);
             assert (!current->done());
 
+            if (!current->obsolete() && !canStartDBJob(*current))
+                break;
+
+            pending_db_jobs_.pop_front();
+
             if (current->obsolete())
             {
                 if (!stop_requested_)
@@ -243,16 +266,19 @@ void JobManager::run()
                 continue;
             }
 
-            logdbg << "JobManager: run: starting dbjob " << current->name();
-            active_db_job_ = current;
+            logdbg << "JobManager: run: starting dbjob " << current->name() << " read-only " << current->readOnly()
+                   << " active " << active_db_jobs_.size();
+            active_db_jobs_.push_back(current);
 
-            QThreadPool::globalInstance()->start(active_db_job_.get());
+            QThreadPool::globalInstance()->start(current.get());
             changed = true;
-
-            break;
         }
 
-        if (!stop_requested_ && changed && !active_db_job_ && queued_db_jobs_.empty())
+        bool db_idle = active_db_jobs_.empty() && pending_db_jobs_.empty() && queued_db_jobs_.empty();
+
+        active_db_jobs_mutex_.unlock();
+
+        if (!stop_requested_ && changed && db_idle)
             emit databaseIdle();
 
         if (!stop_requested_ && changed)
@@ -264,7 +290,8 @@ void JobManager::run()
 
     assert (jobs_.empty());
     assert (non_blocking_jobs_.empty());
-    assert (!active_db_job_);
+    assert (active_db_jobs_.empty());
+    assert (pending_db_jobs_.empty());
     assert (queued_db_jobs_.empty());
 
     stopped_=true;
@@ -277,11 +304,20 @@ void JobManager::shutdown ()
 
     stop_requested_ = true;
 
-    if (active_db_job_)
-        active_db_job_->setObsolete();
+    active_db_jobs_mutex_.lock();
 
-    for (auto job_it = queued_db_jobs_.unsafe_begin(); job_it != queued_db_jobs_.unsafe_end(); ++job_it)
-        (*job_it)->setObsolete ();
+    for (auto& job_it : active_db_jobs_)
+        job_it->setObsolete();
+
+    std::shared_ptr<Job> queued;
+
+    while (queued_db_jobs_.try_pop(queued))
+        pending_db_jobs_.push_back(queued);
+
+    for (auto& job_it : pending_db_jobs_)
+        job_it->setObsolete();
+
+    active_db_jobs_mutex_.unlock();
 
     for (auto job_it = jobs_.unsafe_begin(); job_it != jobs_.unsafe_end(); ++job_it)
         (*job_it)->setObsolete ();
@@ -291,10 +327,10 @@ void JobManager::shutdown ()
 
     loginf  << "JobManager: shutdown: waiting on jobs to quit";
 
-    while (!queued_db_jobs_.empty() || active_db_job_ || !jobs_.empty() || !non_blocking_jobs_.empty())
+    while (!noJobs())
     {
         loginf  << "JobManager: shutdown: waiting on jobs to finish: empty queued " << !queued_db_jobs_.empty()
-                << " db " << (active_db_job_ != nullptr) << " jobs " << !jobs_.empty()
+                << " db " << numDBJobs() << " jobs " << !jobs_.empty()
                                                        << " non-locking " << !non_blocking_jobs_.empty();
 
         msleep(1000);
@@ -336,7 +372,8 @@ unsigned int JobManager::numJobs ()
 
 unsigned int JobManager::numDBJobs ()
 {
-    return active_db_job_ ? queued_db_jobs_.unsafe_size()+1 : queued_db_jobs_.unsafe_size();
+    QMutexLocker locker(&active_db_jobs_mutex_);
+    return queued_db_jobs_.unsafe_size() + pending_db_jobs_.size() + active_db_jobs_.size();
 }
 
 int JobManager::numThreads ()
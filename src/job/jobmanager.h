@@ -84,8 +84,14 @@ protected:
     tbb::concurrent_queue <std::shared_ptr<Job>> jobs_;
     tbb::concurrent_queue <std::shared_ptr<Job>> non_blocking_jobs_;
 
-    std::shared_ptr<Job> active_db_job_;
+    /// Running DB jobs, either one writing or up to max_concurrent_db_reads_ read-only ones
+    std::list<std::shared_ptr<Job>> active_db_jobs_;
+    /// DB jobs taken from queued_db_jobs_ but not started yet, in order of addition
+    std::list<std::shared_ptr<Job>> pending_db_jobs_;
+    /// Protects active_db_jobs_ and pending_db_jobs_
+    QMutex active_db_jobs_mutex_;
     tbb::concurrent_queue <std::shared_ptr<Job>> queued_db_jobs_;
+    unsigned int max_concurrent_db_reads_;
 
     JobManagerWidget *widget_;
 
@@ -97,6 +103,8 @@ protected:
     void updateWidget (bool really=false);
 private:
     void run ();
+    /// @brief Returns if queued DB job can be started next to the active ones, locked by caller
+    bool canStartDBJob (const Job& job);
 
 };
 
@@ -4,8 +4,10 @@
 #include "dbobject.h"
 
 JSONMappingJob::JSONMappingJob(std::vector<nlohmann::json>&& json_objects,
-                               const std::map <std::string, JSONObjectParser>& mappings, size_t key_count)
-    : Job ("JSONMappingJob"), json_objects_(json_objects), parsers_(mappings), key_count_(key_count)
+                               const std::map <std::string, JSONObjectParser>& mappings, size_t key_count,
+                               std::shared_ptr<BufferPool> buffer_pool)
+    : Job ("JSONMappingJob"), json_objects_(json_objects), parsers_(mappings), key_count_(key_count),
+      buffer_pool_(buffer_pool)
 {
 
 }
@@ -22,7 +24,7 @@ void JSONMappingJob::run ()
     started_ = true;
 
     for (auto& parser_it : parsers_)
-        buffers_[parser_it.second.dbObject().name()] = parser_it.second.getNewBuffer();
+        buffers_[parser_it.second.dbObject().name()] = parser_it.second.getNewBuffer(buffer_pool_);
 
     bool parsed;
     bool parsed_any = false;
@@ -9,12 +9,13 @@
 
 class JSONObjectParser;
 class Buffer;
+class BufferPool;
 
 class JSONMappingJob : public Job
 {
 public:
     JSONMappingJob(std::vector<nlohmann::json>&& json_objects, const std::map <std::string, JSONObjectParser>& mappings,
-                   size_t key_count);
+                   size_t key_count, std::shared_ptr<BufferPool> buffer_pool=nullptr);
     // json obj moved, mappings referenced
     virtual ~JSONMappingJob();
 
@@ -36,6 +37,7 @@ private:
     std::vector<nlohmann::json> json_objects_;
     const std::map <std::string, JSONObjectParser>& parsers_;
     size_t key_count_;
+    std::shared_ptr<BufferPool> buffer_pool_;
 
     std::map<std::string, std::shared_ptr<Buffer>> buffers_;
 };
@@ -0,0 +1,635 @@
+/*
+ * This file is part of ATSDB.
+ *
+ * ATSDB is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * ATSDB is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with ATSDB.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include "sqlimportjob.h"
+#include "mysqlserver.h"
+#include "stringconv.h"
+#include "logger.h"
+
+#include <mysql.h>
+#include <archive.h>
+#include <archive_entry.h>
+
+#include <algorithm>
+#include <cctype>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+
+using namespace Utils;
+
+/**
+ * @brief Executes statements of an SQLImportJob on an own connection and thread
+ *
+ * Statements are queued in order of addition, up to MAX_QUEUED ones. Transactional ones are executed in
+ * transactions of up to statements_per_transaction statements, a transaction is also committed when the queue runs
+ * empty or before a non-transactional statement (e.g. DDL, which commits implicitly) is executed on its own.
+ */
+class SQLImportWorker
+{
+public:
+    SQLImportWorker (MYSQL* connection, unsigned int statements_per_transaction,
+                     std::atomic<size_t>& statements_executed, std::atomic<size_t>& error_count)
+        : connection_(connection), statements_per_transaction_(statements_per_transaction),
+          statements_executed_(statements_executed), error_count_(error_count)
+    {
+        assert (connection_);
+        thread_ = std::thread (&SQLImportWorker::run, this);
+    }
+
+    ~SQLImportWorker ()
+    {
+        {
+            std::lock_guard<std::mutex> lock (mutex_);
+            stop_ = true;
+        }
+        work_.notify_all();
+        thread_.join();
+
+        mysql_close(connection_);
+    }
+
+    /// @brief Adds statement, waits while the queue is full
+    void add (std::string&& statement, bool transactional)
+    {
+        std::unique_lock<std::mutex> lock (mutex_);
+        space_.wait(lock, [this] { return queue_.size() < MAX_QUEUED; });
+
+        queue_.emplace_back(std::move(statement), transactional);
+        work_.notify_one();
+    }
+
+    /// @brief Waits until all added statements are executed and committed
+    void drain ()
+    {
+        std::unique_lock<std::mutex> lock (mutex_);
+        idle_.wait(lock, [this] { return queue_.empty() && !busy_; });
+    }
+
+    /// @brief Removes all statements not yet executed
+    void clear ()
+    {
+        std::lock_guard<std::mutex> lock (mutex_);
+        queue_.clear();
+        space_.notify_all();
+    }
+
+    static const size_t MAX_QUEUED = 64;
+
+private:
+    MYSQL* connection_;
+    unsigned int statements_per_transaction_;
+    std::atomic<size_t>& statements_executed_;
+    std::atomic<size_t>& error_count_;
+
+    std::thread thread_;
+    std::mutex mutex_;
+    std::condition_variable work_;
+    std::condition_variable space_;
+    std::condition_variable idle_;
+    /// Statements with transactional flag
+    std::deque<std::pair<std::string, bool>> queue_;
+    bool stop_ {false};
+    bool busy_ {false};
+    /// Number of statements in open transaction
+    unsigned int transaction_size_ {0};
+
+    void run ()
+    {
+        std::unique_lock<std::mutex> lock (mutex_);
+
+        while (true)
+        {
+            work_.wait(lock, [this] { return stop_ || !queue_.empty(); });
+
+            if (queue_.empty()) // stopped
+                break;
+
+            std::string statement = std::move(queue_.front().first);
+            bool transactional = queue_.front().second;
+            queue_.pop_front();
+            busy_ = true;
+            space_.notify_one();
+            lock.unlock();
+
+            if (!transactional && transaction_size_)
+            {
+                execute ("COMMIT");
+                transaction_size_ = 0;
+            }
+
+            if (transactional && !transaction_size_)
+                execute ("START TRANSACTION");
+
+            if (execute (statement))
+                ++statements_executed_;
+
+            if (transactional)
+                ++transaction_size_;
+
+            lock.lock();
+
+            if (transaction_size_ && (transaction_size_ >= statements_per_transaction_ || queue_.empty()))
+            {
+                lock.unlock();
+                execute ("COMMIT");
+                transaction_size_ = 0;
+                lock.lock();
+            }
+
+            busy_ = false;
+
+            if (queue_.empty())
+                idle_.notify_all();
+        }
+    }
+
+    bool execute (const std::string& sql)
+    {
+        if (mysql_real_query(connection_, sql.c_str(), sql.size()))
+        {
+            logwrn << "SQLImportWorker: execute: sql error '" << mysql_error(connection_) << "' in '"
+                   << sql.substr(0, 200) << "'";
+            ++error_count_;
+            return false;
+        }
+
+        if (MYSQL_RES* result = mysql_store_result(connection_)) // discard returned data
+            mysql_free_result(result);
+
+        return true;
+    }
+};
+
+namespace
+{
+
+const size_t READ_BLOCK_SIZE = 1 << 20;
+
+/// Returns upper case begin of statement, without leading whitespace and MySQL version comment prefix
+std::string statementStart (const std::string& statement)
+{
+    size_t pos = statement.find_first_not_of(" \t\r\n");
+
+    if (pos == std::string::npos)
+        return "";
+
+    if (statement.compare(pos, 3, "/*!") == 0) // e.g. "/*!40101 SET ..."
+    {
+        pos += 3;
+
+        while (pos < statement.size() && std::isdigit(statement[pos]))
+            ++pos;
+
+        pos = statement.find_first_not_of(" \t\r\n", pos);
+
+        if (pos == std::string::npos)
+            return "";
+    }
+
+    std::string start = statement.substr(pos, 128);
+    std::transform(start.begin(), start.end(), start.begin(), ::toupper);
+
+    return start;
+}
+
+inline bool startsWith (const std::string& str, const std::string& begin)
+{
+    return str.compare(0, begin.size(), begin) == 0;
+}
+
+/// Returns table name at pos of statement start without quotes, qualified by database if given, and sets pos after it
+std::string tableName (const std::string& start, size_t& pos)
+{
+    std::string name;
+
+    while (true)
+    {
+        pos = start.find_first_not_of(" \t\r\n", pos);
+
+        if (pos == std::string::npos)
+            return "";
+
+        size_t end;
+
+        if (start[pos] == '`')
+        {
+            end = start.find('`', pos+1);
+
+            if (end == std::string::npos) // longer than statement start
+                return "";
+
+            name += start.substr(pos+1, end-pos-1);
+            ++end;
+        }
+        else
+        {
+            end = std::min(start.find_first_of(" \t\r\n(,;.", pos), start.size());
+            name += start.substr(pos, end-pos);
+        }
+
+        pos = end;
+
+        if (pos >= start.size() || start[pos] != '.')
+            return name;
+
+        name += '.';
+        ++pos;
+    }
+}
+
+/// Returns table of a statement only affecting one table, as mysqldump's DROP, CREATE and ALTER ... KEYS, or ""
+std::string singleTable (const std::string& start, const std::string& statement)
+{
+    size_t pos;
+
+    if (startsWith(start, "DROP TABLE IF EXISTS "))
+        pos = 21;
+    else if (startsWith(start, "DROP TABLE "))
+        pos = 11;
+    else if (startsWith(start, "CREATE TABLE IF NOT EXISTS "))
+        pos = 27;
+    else if (startsWith(start, "CREATE TABLE "))
+        pos = 13;
+    else if (startsWith(start, "ALTER TABLE "))
+        pos = 12;
+    else
+        return "";
+
+    std::string table = tableName(start, pos);
+
+    if (!table.size())
+        return "";
+
+    pos = start.find_first_not_of(" \t\r\n", pos);
+    std::string rest = pos != std::string::npos ? start.substr(pos) : "";
+
+    if (startsWith(start, "DROP TABLE ")) // not a list of tables
+        return rest.empty() || startsWith(rest, ";") || startsWith(rest, "*/") ? table : "";
+
+    if (startsWith(start, "CREATE TABLE ")) // column definitions, not LIKE, SELECT or REFERENCES to others
+    {
+        if (!startsWith(rest, "("))
+            return "";
+
+        std::string definition = statement;
+        std::transform(definition.begin(), definition.end(), definition.begin(), ::toupper);
+
+        return definition.find("SELECT") == std::string::npos && definition.find("REFERENCES") == std::string::npos
+                ? table : "";
+    }
+
+    return startsWith(rest, "DISABLE KEYS") || startsWith(rest, "ENABLE KEYS") ? table : "";
+}
+
+}
+
+SQLImportJob::SQLImportJob (const MySQLServer& server, const std::string& database, const std::string& file_name,
+                            bool archive, unsigned int num_connections, unsigned int statements_per_transaction)
+    : Job("SQLImportJob"), host_(server.host()), user_(server.user()), password_(server.password()),
+      port_(server.port()), database_(database), file_name_(file_name), archive_(archive),
+      num_connections_(std::max (1u, num_connections)),
+      statements_per_transaction_(std::max (1u, statements_per_transaction))
+{
+}
+
+SQLImportJob::~SQLImportJob()
+{
+    workers_.clear();
+    closeFile();
+}
+
+void SQLImportJob::run ()
+{
+    loginf << "SQLImportJob: run: importing " << file_name_ << " archive " << archive_ << " with "
+           << num_connections_ << " connections";
+
+    started_ = true;
+
+    try
+    {
+        for (unsigned int cnt=0; cnt < num_connections_; ++cnt)
+        {
+            MYSQL* connection = mysql_init(nullptr);
+
+            if (!connection)
+                throw std::runtime_error ("SQLImportJob: run: connection init failed");
+
+            if (!mysql_real_connect(connection, host_.c_str(), user_.c_str(), password_.c_str(), database_.c_str(),
+                                    port_, nullptr, 0))
+            {
+                std::string error = mysql_error(connection);
+                mysql_close(connection);
+                throw std::runtime_error ("SQLImportJob: run: connect failed with error "+error);
+            }
+
+            workers_.emplace_back(new SQLImportWorker (connection, statements_per_transaction_,
+                                                       statements_executed_, error_count_));
+        }
+
+        openFile();
+
+        std::string block;
+        std::string line;
+
+        while (!obsolete_ && error_count_ <= MAX_ERRORS && readBlock(block))
+        {
+            size_t begin = 0;
+            size_t end;
+
+            while (!obsolete_ && error_count_ <= MAX_ERRORS
+                   && (end = block.find('\n', begin)) != std::string::npos)
+            {
+                line.append(block, begin, end-begin);
+                processLine(line);
+                line.clear();
+
+                begin = end+1;
+            }
+
+            line.append(block, begin, std::string::npos); // incomplete, continued in next block
+        }
+
+        if (!obsolete_ && error_count_ <= MAX_ERRORS)
+        {
+            if (line.size())
+                processLine(line);
+
+            if (statementStart(statement_).size()) // without delimiter at end of file
+            {
+                statement_.resize(statement_.find_last_not_of(" \t\n")+1);
+                dispatch(std::move(statement_));
+            }
+        }
+        else
+        {
+            logwrn << "SQLImportJob: run: stopped " << (obsolete_ ? "on request" : "after too many errors");
+
+            for (auto& worker : workers_)
+                worker->clear();
+        }
+
+        drainWorkers();
+    }
+    catch (std::exception& e)
+    {
+        logerr << "SQLImportJob: run: error '" << e.what() << "'";
+        ++error_count_;
+
+        for (auto& worker : workers_)
+            worker->clear();
+    }
+
+    workers_.clear();
+    closeFile();
+
+    loginf << "SQLImportJob: run: done with " << statements_executed_ << " statements and " << error_count_
+           << " errors";
+
+    done_ = true;
+}
+
+float SQLImportJob::getStatusPercent () const
+{
+    if (!bytes_to_read_)
+        return 0;
+
+    return 100.0 * bytes_read_ / bytes_to_read_;
+}
+
+void SQLImportJob::openFile ()
+{
+    std::ifstream size_stream (file_name_, std::ios::binary | std::ios::ate);
+    bytes_to_read_ = size_stream.tellg(); // for archives compared to compressed bytes read
+
+    if (archive_)
+    {
+        // if gz or bz2 but not tar.gz or tar.bz2
+        bool raw = (String::hasEnding (file_name_, ".gz") && !String::hasEnding (file_name_, ".tar.gz"))
+                || (String::hasEnding (file_name_, ".bz2") && !String::hasEnding (file_name_, ".tar.bz2"));
+
+        archive_handle_ = archive_read_new();
+
+        if (raw)
+        {
+            archive_read_support_filter_gzip(archive_handle_);
+            archive_read_support_filter_bzip2(archive_handle_);
+            archive_read_support_format_raw(archive_handle_);
+        }
+        else
+        {
+            archive_read_support_filter_all(archive_handle_);
+            archive_read_support_format_all(archive_handle_);
+        }
+
+        if (archive_read_open_filename(archive_handle_, file_name_.c_str(), READ_BLOCK_SIZE) != ARCHIVE_OK)
+            throw std::runtime_error("SQLImportJob: openFile: archive error: "
+                                     +std::string(archive_error_string(archive_handle_)));
+    }
+    else
+    {
+        file_stream_.open(file_name_, std::ios::binary);
+
+        if (!file_stream_.is_open())
+            throw std::runtime_error("SQLImportJob: openFile: unable to open "+file_name_);
+    }
+}
+
+void SQLImportJob::closeFile ()
+{
+    if (archive_handle_)
+    {
+        if (archive_read_free(archive_handle_) != ARCHIVE_OK) // also closes
+            logerr << "SQLImportJob: closeFile: archive read free error";
+
+        archive_handle_ = nullptr;
+    }
+
+    if (file_stream_.is_open())
+        file_stream_.close();
+}
+
+bool SQLImportJob::readBlock (std::string& block)
+{
+    if (!archive_)
+    {
+        block.resize(READ_BLOCK_SIZE);
+        file_stream_.read(&block[0], READ_BLOCK_SIZE);
+        block.resize(file_stream_.gcount());
+
+        bytes_read_ += block.size();
+        return block.size();
+    }
+
+    assert (archive_handle_);
+
+    struct archive_entry* entry;
+    const void* buff;
+    size_t size;
+    int64_t offset;
+    int r;
+
+    while (true)
+    {
+        if (!entry_open_)
+        {
+            r = archive_read_next_header(archive_handle_, &entry);
+
+            if (r == ARCHIVE_EOF)
+                return false;
+
+            if (r == ARCHIVE_WARN)
+                logwrn << "SQLImportJob: readBlock: header warning: " << archive_error_string(archive_handle_);
+            else if (r != ARCHIVE_OK)
+                throw std::runtime_error("SQLImportJob: readBlock: header error: "
+                                         +std::string(archive_error_string(archive_handle_)));
+
+            loginf << "SQLImportJob: readBlock: archive entry " << archive_entry_pathname(entry);
+            entry_open_ = true;
+        }
+
+        r = archive_read_data_block(archive_handle_, &buff, &size, &offset);
+
+        if (r == ARCHIVE_EOF)
+        {
+            entry_open_ = false;
+            block = "\n"; // ends last line of entry
+            return true;
+        }
+
+        if (r == ARCHIVE_WARN)
+            logwrn << "SQLImportJob: readBlock: data block warning: " << archive_error_string(archive_handle_);
+        else if (r != ARCHIVE_OK)
+            throw std::runtime_error("SQLImportJob: readBlock: data block error: "
+                                     +std::string(archive_error_string(archive_handle_)));
+
+        bytes_read_ = archive_filter_bytes(archive_handle_, -1); // compressed bytes
+
+        if (size)
+        {
+            block.assign(reinterpret_cast<const char*>(buff), size);
+            return true;
+        }
+    }
+}
+
+void SQLImportJob::processLine (const std::string& line)
+{
+    size_t length = line.size();
+
+    if (length && line[length-1] == '\r')
+        --length;
+
+    if (statement_.empty())
+    {
+        size_t pos = line.find_first_not_of(" \t");
+
+        if (pos == std::string::npos || pos >= length) // empty
+            return;
+
+        if (line.compare(pos, 2, "--") == 0 || line[pos] == '#') // comment
+            return;
+
+        std::string keyword = line.substr(pos, 10);
+        std::transform(keyword.begin(), keyword.end(), keyword.begin(), ::toupper);
+
+        if (keyword == "DELIMITER ") // client command
+        {
+            size_t begin = line.find_first_not_of(" \t", pos+10);
+            size_t end = line.find_last_not_of(" \t", length-1);
+
+            if (begin == std::string::npos || begin > end)
+                throw std::runtime_error("SQLImportJob: processLine: empty delimiter");
+
+            delimiter_ = line.substr(begin, end-begin+1);
+            logdbg << "SQLImportJob: processLine: delimiter '" << delimiter_ << "'";
+            return;
+        }
+    }
+
+    statement_.append(line, 0, length);
+
+    size_t end = statement_.find_last_not_of(" \t");
+
+    if (end != std::string::npos && end+1 >= delimiter_.size()
+            && statement_.compare(end+1-delimiter_.size(), delimiter_.size(), delimiter_) == 0)
+    {
+        statement_.resize(end+1-delimiter_.size());
+        dispatch(std::move(statement_));
+        statement_.clear();
+    }
+    else
+        statement_ += '\n';
+}
+
+void SQLImportJob::dispatch (std::string&& statement)
+{
+    assert (workers_.size());
+
+    std::string start = statementStart(statement);
+
+    if (!start.size())
+        return;
+
+    if (startsWith(start, "INSERT INTO ") || startsWith(start, "REPLACE INTO ")) // by table, in parallel
+    {
+        size_t pos = start.find(" INTO ")+6;
+        tableWorker(tableName(start, pos)).add(std::move(statement), true);
+        return;
+    }
+
+    std::string table = singleTable(start, statement);
+
+    if (table.size()) // in order with the table's inserts, other tables continue
+    {
+        logdbg << "SQLImportJob: dispatch: table " << table << " '" << statement.substr(0, 100) << "'";
+        tableWorker(table).add(std::move(statement), false);
+        return;
+    }
+
+    if (startsWith(start, "LOCK TABLES") || startsWith(start, "UNLOCK TABLES")) // would block other connections
+    {
+        logdbg << "SQLImportJob: dispatch: skipping '" << statement.substr(0, 100) << "'";
+        return;
+    }
+
+    if (startsWith(start, "SET ")) // session state, in order with the statements of each connection
+    {
+        for (auto& worker : workers_)
+            worker->add(std::string(statement), false);
+
+        return;
+    }
+
+    drainWorkers(); // may depend on or affect several tables
+    workers_.at(0)->add(std::move(statement), false);
+    drainWorkers();
+}
+
+SQLImportWorker& SQLImportJob::tableWorker (const std::string& table)
+{
+    return *workers_.at(std::hash<std::string>()(table) % workers_.size());
+}
+
+void SQLImportJob::drainWorkers ()
+{
+    for (auto& worker : workers_)
+        worker->drain();
+}
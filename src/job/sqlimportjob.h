@@ -0,0 +1,104 @@
+/*
+ * This file is part of ATSDB.
+ *
+ * ATSDB is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * ATSDB is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with ATSDB.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef SQLIMPORTJOB_H_
+#define SQLIMPORTJOB_H_
+
+#include <atomic>
+#include <fstream>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "job.h"
+
+class MySQLServer;
+class SQLImportWorker;
+
+/**
+ * @brief Imports an SQL dump into a MySQL database
+ *
+ * Streams the file, either plain or through libarchive (.gz, .bz2, .tar.gz, ...), and splits it into statements,
+ * following DELIMITER changes. INSERT statements are distributed by table over a number of own connections,
+ * which execute them in transactions of a number of statements. Statements only affecting one table, as
+ * mysqldump's DROP TABLE, CREATE TABLE and ALTER TABLE ... DISABLE/ENABLE KEYS, are executed in order with that
+ * table's inserts. SET statements are added to all connections. All other statements are executed after all
+ * previous ones are done, LOCK TABLES statements are skipped.
+ */
+class SQLImportJob : public Job
+{
+public:
+    /// @brief Constructor, connects to database on server when run
+    SQLImportJob (const MySQLServer& server, const std::string& database, const std::string& file_name, bool archive,
+                  unsigned int num_connections, unsigned int statements_per_transaction);
+    virtual ~SQLImportJob();
+
+    virtual void run ();
+
+    size_t bytesRead () const { return bytes_read_; }
+    size_t bytesToRead () const { return bytes_to_read_; }
+    float getStatusPercent () const;
+
+    size_t statementsExecuted () const { return statements_executed_; }
+    size_t errorCount () const { return error_count_; }
+
+    /// Number of errors after which the import is stopped
+    static const size_t MAX_ERRORS = 3;
+
+protected:
+    std::string host_;
+    std::string user_;
+    std::string password_;
+    unsigned int port_;
+    std::string database_;
+
+    std::string file_name_;
+    bool archive_ {false};
+    unsigned int num_connections_;
+    unsigned int statements_per_transaction_;
+
+    std::atomic<size_t> bytes_read_ {0};
+    std::atomic<size_t> bytes_to_read_ {0};
+    std::atomic<size_t> statements_executed_ {0};
+    std::atomic<size_t> error_count_ {0};
+
+    std::ifstream file_stream_;
+    struct archive* archive_handle_ {nullptr};
+    bool entry_open_ {false};
+
+    std::vector<std::unique_ptr<SQLImportWorker>> workers_;
+
+    /// Current statement delimiter
+    std::string delimiter_ {";"};
+    /// Statement read so far
+    std::string statement_;
+
+    void openFile ();
+    void closeFile ();
+    /// @brief Sets next block of data, returns false at end of file
+    bool readBlock (std::string& block);
+
+    void processLine (const std::string& line);
+    void dispatch (std::string&& statement);
+    /// @brief Returns worker executing statements of table
+    SQLImportWorker& tableWorker (const std::string& table);
+    /// @brief Waits until all workers executed all added statements
+    void drainWorkers ();
+};
+
+#endif /* SQLIMPORTJOB_H_ */
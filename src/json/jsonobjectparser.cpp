@@ -191,11 +191,11 @@ void JSONObjectParser::initialize ()
     }
 }
 
-std::shared_ptr<Buffer> JSONObjectParser::getNewBuffer () const
+std::shared_ptr<Buffer> JSONObjectParser::getNewBuffer (std::shared_ptr<BufferPool> buffer_pool) const
 {
     assert (initialized_);
     assert (db_object_);
-    return std::shared_ptr<Buffer> {new Buffer (list_, db_object_->name())};
+    return std::shared_ptr<Buffer> {new Buffer (list_, db_object_->name(), buffer_pool)};
 }
 
 bool JSONObjectParser::parseJSON (nlohmann::json& j, std::shared_ptr<Buffer> buffer) const
@@ -33,6 +33,7 @@
 class DBObject;
 class DBOVariable;
 class Buffer;
+class BufferPool;
 
 class JSONObjectParser : public Configurable
 {
@@ -77,7 +78,7 @@ public:
     bool initialized() const { return initialized_; }
     void initialize ();
 
-    std::shared_ptr<Buffer> getNewBuffer () const;
+    std::shared_ptr<Buffer> getNewBuffer (std::shared_ptr<BufferPool> buffer_pool=nullptr) const;
 
     virtual void generateSubConfigurable (const std::string& class_id, const std::string& instance_id);
 
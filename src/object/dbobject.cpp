@@ -17,8 +17,11 @@
 
 #include <algorithm>
 #include <memory>
+#include <sstream>
+#include <functional>
 
 #include "dbtable.h"
+#include "dbtablecolumn.h"
 #include "dbschema.h"
 #include "dbschemamanager.h"
 #include "dbobject.h"
@@ -32,7 +35,11 @@
 #include "propertylist.h"
 #include "metadbtable.h"
 #include "dboreaddbjob.h"
-#include "finalizedboreadjob.h"
+#include "dboreadcachejob.h"
+#include "dbowritecachejob.h"
+#include "buffercache.h"
+#include "dbconnection.h"
+#include "files.h"
 #include "atsdb.h"
 #include "dbinterface.h"
 #include "jobmanager.h"
@@ -729,8 +736,6 @@ std::string DBObject::status ()
                 return "Queued";
         }
     }
-    else if (finalize_jobs_.size() > 0)
-        return "Post-processing";
     else
         return "Idle";
 
@@ -844,18 +849,23 @@ void DBObject::load (DBOVariableSet& read_set, bool use_filters, bool use_order,
     }
     read_job_data_.clear();
 
-    for (auto job_it : finalize_jobs_)
-        JobManager::instance().cancelJob(job_it);
-    finalize_jobs_.clear();
+    if (read_cache_job_)
+    {
+        JobManager::instance().cancelJob(read_cache_job_);
+        read_cache_job_ = nullptr;
+    }
 
     clearData ();
 
     std::string custom_filter_clause;
+    DBCommandParameters parameters;
     std::vector <DBOVariable*> filtered_variables;
 
-    if (use_filters)
+    if (use_filters) // values bound if supported, so the statement is reused while filter values change
     {
-        custom_filter_clause = ATSDB::instance().filterManager().getSQLCondition (name_, filtered_variables);
+        custom_filter_clause = ATSDB::instance().filterManager().getReadSQLCondition (
+                    name_, read_set, use_order ? order_variable : nullptr, filtered_variables,
+                    ATSDB::instance().interface().supportsParameters() ? &parameters : nullptr);
     }
 
     for (auto& var_it : filtered_variables)
@@ -865,7 +875,7 @@ void DBObject::load (DBOVariableSet& read_set, bool use_filters, bool use_order,
     //    DBOVariable *order, const std::string &limit_str
 
     read_job_ = std::shared_ptr<DBOReadDBJob> (new DBOReadDBJob (ATSDB::instance().interface(), *this,
-                                                                 read_set, custom_filter_clause,
+                                                                 read_set, custom_filter_clause, parameters,
                                                                  filtered_variables, use_order, order_variable,
                                                                  use_order_ascending, limit_str));
 
@@ -874,6 +884,24 @@ void DBObject::load (DBOVariableSet& read_set, bool use_filters, bool use_order,
     connect (read_job_.get(), SIGNAL(obsoleteSignal()), this, SLOT(readJobObsoleteSlot()), Qt::QueuedConnection);
     connect (read_job_.get(), SIGNAL(doneSignal()), this, SLOT(readJobDoneSlot()), Qt::QueuedConnection);
 
+    load_cache_ = loadCache (read_set, custom_filter_clause, parameters, use_order, order_variable,
+                             use_order_ascending, limit_str);
+
+    if (load_cache_ && load_cache_->valid()) // read job only started if cache read fails
+    {
+        loginf << "DBObject: " << name_ << " load: reading from cache " << load_cache_->fileName();
+
+        read_cache_job_ = std::make_shared<DBOReadCacheJob> (*load_cache_, name_);
+        connect (read_cache_job_.get(), SIGNAL(doneSignal()), this, SLOT(readCacheJobDoneSlot()),
+                 Qt::QueuedConnection);
+
+        if (info_widget_)
+            info_widget_->updateSlot();
+
+        JobManager::instance().addJob(read_cache_job_);
+        return;
+    }
+
     if (info_widget_)
         info_widget_->updateSlot();
 
@@ -882,6 +910,19 @@ void DBObject::load (DBOVariableSet& read_set, bool use_filters, bool use_order,
 
 void DBObject::quitLoading ()
 {
+    load_cache_ = nullptr; // incomplete data not cached
+
+    if (read_cache_job_) // read job not yet added, nothing else to wait for
+    {
+        JobManager::instance().cancelJob(read_cache_job_);
+        read_cache_job_ = nullptr;
+
+        if (read_job_)
+            readJobObsoleteSlot();
+
+        return;
+    }
+
     if (read_job_)
     {
         read_job_->setObsolete();
@@ -969,23 +1010,37 @@ std::map<int, std::string> DBObject::loadLabelData (std::vector<int> rec_nums, i
     assert (existsInDB());
 
     std::string custom_filter_clause;
-    bool first=true;
+    DBCommandParameters parameters;
+
+    DBInterface& db_interface = ATSDB::instance().interface ();
 
     // TODO rework to key variable
     assert (hasVariable("rec_num"));
     assert (variable("rec_num").existsInDB());
 
-    custom_filter_clause = variable("rec_num").currentDBColumn().identifier()+" in (";
-    for (auto& rec_num : rec_nums)
+    const std::string& rec_num_identifier = variable("rec_num").currentDBColumn().identifier();
+
+    if (db_interface.supportsParameters()) // one bound key set instead of a literal list
     {
-        if (first)
-            first=false;
-        else
-            custom_filter_clause += ",";
+        custom_filter_clause = db_interface.keySetClause(rec_num_identifier);
+        parameters.push_back(db_interface.keySetParameter(rec_nums));
+    }
+    else
+    {
+        bool first=true;
+
+        custom_filter_clause = rec_num_identifier+" in (";
+        for (auto& rec_num : rec_nums)
+        {
+            if (first)
+                first=false;
+            else
+                custom_filter_clause += ",";
 
-        custom_filter_clause += std::to_string(rec_num);
+            custom_filter_clause += std::to_string(rec_num);
+        }
+        custom_filter_clause += ")";
     }
-    custom_filter_clause += ")";
 
     DBOVariableSet read_list = label_definition_->readList();
 
@@ -997,14 +1052,14 @@ std::map<int, std::string> DBObject::loadLabelData (std::vector<int> rec_nums, i
 
     boost::posix_time::ptime start_time = boost::posix_time::microsec_clock::local_time();
 
-    DBInterface& db_interface = ATSDB::instance().interface ();
-
-    db_interface.prepareRead (*this, read_list, custom_filter_clause, {}, false, nullptr, false, "");
-    std::shared_ptr<Buffer> buffer = db_interface.readDataChunk(*this);
-    db_interface.finalizeReadStatement(*this);
+    unsigned int read_id = db_interface.prepareRead (*this, read_list, custom_filter_clause, parameters, {}, false,
+                                                     nullptr, false, "");
+    std::shared_ptr<Buffer> buffer = db_interface.readDataChunk(*this, read_id);
+    db_interface.finalizeReadStatement(*this, read_id);
 
     if (buffer->size() != rec_nums.size())
-        throw std::runtime_error ("DBObject "+name_+": loadLabelData: failed to load label for "+custom_filter_clause);
+        throw std::runtime_error ("DBObject "+name_+": loadLabelData: failed to load label for "
+                                  +std::to_string(rec_nums.size())+" rec nums");
 
     assert (buffer->size() == rec_nums.size());
 
@@ -1032,34 +1087,29 @@ void DBObject::readJobIntermediateSlot (std::shared_ptr<Buffer> buffer)
         logwrn << "DBObject: readJobIntermediateSlot: null sender, event on the loose";
         return;
     }
-    assert (sender == read_job_.get());
-
-    std::vector <DBOVariable*>& variables = sender->readList().getSet ();
-    const PropertyList &properties = buffer->properties();
 
-    for (auto var_it : variables)
+    if (sender != read_job_.get())
     {
-        const DBTableColumn &column = var_it->currentDBColumn ();
-        assert (properties.hasProperty(column.name()));
-        const Property &property = properties.get(column.name());
-        assert (property.dataType() == var_it->dataType());
+        logdbg << "DBObject: " << name_ << " readJobIntermediateSlot: ignoring buffer of canceled read";
+        return;
     }
 
-    logdbg << "DBObject: " << name_ << " readJobIntermediateSlot: got buffer with size " << buffer->size();
-
     read_job_data_.push_back(buffer);
 
-    FinalizeDBOReadJob* job = new FinalizeDBOReadJob (*this, sender->readList(), buffer);
+    // transformed by the read job
+    if (!data_)
+        data_ = buffer;
+    else
+        data_->seizeBuffer (*buffer.get());
 
-    std::shared_ptr<FinalizeDBOReadJob> job_ptr = std::shared_ptr<FinalizeDBOReadJob> (job);
-    connect (job, SIGNAL(doneSignal()), this, SLOT(finalizeReadJobDoneSlot()), Qt::QueuedConnection);
-    finalize_jobs_.push_back(job_ptr);
+    sender->bufferMerged();
 
-    JobManager::instance().addJob(job_ptr);
+    logdbg << "DBObject: " << name_ << " readJobIntermediateSlot: merged buffer, size " << data_->size();
 
     if (info_widget_)
         info_widget_->updateSlot();
 
+    emit newDataSignal(*this);
 }
 
 void DBObject::readJobObsoleteSlot ()
@@ -1067,6 +1117,7 @@ void DBObject::readJobObsoleteSlot ()
     logdbg << "DBObject: " << name_ << " readJobObsoleteSlot";
     read_job_ = nullptr;
     read_job_data_.clear();
+    load_cache_ = nullptr;
 
     if (info_widget_)
         info_widget_->updateSlot();
@@ -1085,53 +1136,57 @@ void DBObject::readJobDoneSlot()
     if (!isLoading())
     {
         loginf << "DBObject: " << name_ << " readJobDoneSlot: no jobs left, done";
+        writeLoadCache();
         emit loadingDoneSignal(*this);
     }
 }
 
-void DBObject::finalizeReadJobDoneSlot()
+void DBObject::readCacheJobDoneSlot()
 {
-    logdbg << "DBObject: " << name_ << " finalizeReadJobDoneSlot";
-
-    FinalizeDBOReadJob* sender = dynamic_cast <FinalizeDBOReadJob*> (QObject::sender());
+    DBOReadCacheJob* sender = dynamic_cast <DBOReadCacheJob*> (QObject::sender());
 
     if (!sender)
     {
-        logwrn << "DBObject: finalizeReadJobDoneSlot: null sender, event on the loose";
+        logwrn << "DBObject: readCacheJobDoneSlot: null sender, event on the loose";
+        return;
+    }
+
+    if (sender != read_cache_job_.get())
+    {
+        logdbg << "DBObject: " << name_ << " readCacheJobDoneSlot: ignoring result of canceled cache read";
         return;
     }
 
-    std::shared_ptr<Buffer> buffer = sender->buffer();
+    std::shared_ptr<Buffer> buffer = read_cache_job_->buffer();
+    read_cache_job_ = nullptr;
 
-    bool found=false;
-    for (auto final_it : finalize_jobs_)
+    assert (read_job_);
+
+    if (!buffer) // fall back to database, cache rewritten afterwards
     {
-        if (final_it.get() == sender)
+        logwrn << "DBObject: " << name_ << " readCacheJobDoneSlot: cache read failed, reading from database";
+
+        if (read_job_->obsolete())
         {
-            finalize_jobs_.erase(std::find(finalize_jobs_.begin(), finalize_jobs_.end(), final_it));
-            found=true;
-            break;
+            readJobObsoleteSlot();
+            return;
         }
+
+        JobManager::instance().addDBJob(read_job_);
+        return;
     }
-    assert (found);
 
-    if (!data_)
-        data_ = buffer;
-    else
-        data_->seizeBuffer (*buffer.get());
+    loginf << "DBObject: " << name_ << " readCacheJobDoneSlot: read " << buffer->size() << " from cache";
 
-    logdbg << "DBObject: " << name_ << " finalizeReadJobDoneSlot: got buffer with size " << data_->size();
+    read_job_ = nullptr;
+    load_cache_ = nullptr;
+    data_ = buffer;
 
     if (info_widget_)
         info_widget_->updateSlot();
 
     emit newDataSignal(*this);
-
-    if (!isLoading())
-    {
-        loginf << "DBObject: " << name_ << " finalizeReadJobDoneSlot: no jobs left, done";
-        emit loadingDoneSignal(*this);
-    }
+    emit loadingDoneSignal(*this);
 }
 
 
@@ -1169,7 +1224,7 @@ void DBObject::databaseContentChangedSlot ()
 
 bool DBObject::isLoading ()
 {
-    return read_job_ || finalize_jobs_.size();
+    return read_job_ || read_cache_job_;
 }
 
 bool DBObject::hasData ()
@@ -1246,3 +1301,66 @@ void DBObject::print ()
     loginf << "DBObject " << name() << ":\n" << ss.str();
 
 }
+
+std::shared_ptr <BufferCache> DBObject::loadCache (DBOVariableSet& read_set, const std::string& custom_filter_clause,
+                                                   const DBCommandParameters& parameters, bool use_order,
+                                                   DBOVariable* order_variable, bool use_order_ascending,
+                                                   const std::string &limit_str)
+{
+    if (!ATSDB::instance().objectManager().useColumnCache())
+        return nullptr;
+
+    DBConnection& connection = ATSDB::instance().interface().connection();
+    long long source_time = connection.modificationTime();
+
+    if (!source_time) // no validation possible
+        return nullptr;
+
+    std::stringstream key;
+
+    key << connection.identifier() << ";" << name_ << ";";
+
+    for (auto var_it : read_set.getSet()) // cached data is transformed to variable type and unit
+    {
+        const DBTableColumn& column = var_it->currentDBColumn();
+
+        key << var_it->name() << ":" << var_it->dataTypeString() << ":" << var_it->dimensionConst()
+            << ":" << var_it->unitConst() << ":" << column.identifier() << ":" << column.type() << ":"
+            << column.unit() << ",";
+    }
+
+    key << ";" << custom_filter_clause << ";";
+
+    for (auto& parameter : parameters)
+        key << parameter.value_ << ",";
+
+    key << ";" << use_order << ";" << (order_variable ? order_variable->name() : "")
+        << ";" << use_order_ascending << ";" << limit_str;
+
+    if (!QDir().mkpath(QString::fromStdString(HOME_CACHE_DIRECTORY)))
+    {
+        logerr << "DBObject: " << name_ << " loadCache: unable to create directory " << HOME_CACHE_DIRECTORY;
+        return nullptr;
+    }
+
+    std::string file_name = HOME_CACHE_DIRECTORY+name_+"_"+std::to_string(std::hash<std::string>()(key.str()))
+            +".cache";
+
+    return std::make_shared<BufferCache> (file_name, key.str(), source_time);
+}
+
+void DBObject::writeLoadCache ()
+{
+    if (!load_cache_ || !data_ || !data_->size())
+        return;
+
+    loginf << "DBObject: " << name_ << " writeLoadCache: writing " << load_cache_->fileName();
+
+    // own copy for the job thread, storage is copied if data_ is written before the job is done
+    std::shared_ptr<Buffer> data = data_->getPartialCopy(data_->properties());
+    size_t max_cache_bytes = (size_t) ATSDB::instance().objectManager().columnCacheMaxSize() * 1024 * 1024;
+
+    JobManager::instance().addNonBlockingJob(std::make_shared<DBOWriteCacheJob> (*load_cache_, data,
+                                                                                 max_cache_bytes));
+    load_cache_ = nullptr;
+}
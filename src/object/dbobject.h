@@ -24,6 +24,7 @@
 
 #include "global.h"
 #include "dbovariableset.h"
+#include "dbcommand.h"
 #include "dbodatasource.h"
 #include "dbodatasourcedefinition.h"
 #include "storeddbodatasource.h"
@@ -70,9 +71,10 @@ class DBOEditDataSourcesWidget;
 class Buffer;
 class Job;
 class DBOReadDBJob;
+class DBOReadCacheJob;
+class BufferCache;
 class InsertBufferDBJob;
 class UpdateBufferDBJob;
-class FinalizeDBOReadJob;
 class DBOVariableSet;
 class DBOLabelDefinition;
 class DBOLabelDefinitionWidget;
@@ -127,7 +129,7 @@ public slots:
     void readJobIntermediateSlot (std::shared_ptr<Buffer> buffer);
     void readJobObsoleteSlot ();
     void readJobDoneSlot();
-    void finalizeReadJobDoneSlot();
+    void readCacheJobDoneSlot();
 
     void insertProgressSlot (float percent);
     void insertDoneSlot ();
@@ -292,7 +294,9 @@ protected:
 
     std::shared_ptr <DBOReadDBJob> read_job_ {nullptr};
     std::vector <std::shared_ptr<Buffer>> read_job_data_;
-    std::vector <std::shared_ptr <FinalizeDBOReadJob>> finalize_jobs_;
+    std::shared_ptr <DBOReadCacheJob> read_cache_job_ {nullptr};
+    /// Column cache of the current load, written when read from the database
+    std::shared_ptr <BufferCache> load_cache_;
 
     std::shared_ptr <InsertBufferDBJob> insert_job_ {nullptr};
     std::shared_ptr <UpdateBufferDBJob> update_job_ {nullptr};
@@ -323,6 +327,14 @@ protected:
 
     ///@brief Generates data sources information from previous post-processing.
     void buildDataSources();
+
+    /// @brief Returns column cache for a load, nullptr if not to be used
+    std::shared_ptr <BufferCache> loadCache (DBOVariableSet& read_set, const std::string& custom_filter_clause,
+                                             const DBCommandParameters& parameters, bool use_order,
+                                             DBOVariable* order_variable, bool use_order_ascending,
+                                             const std::string &limit_str);
+    /// @brief Writes loaded data to load_cache_ if set
+    void writeLoadCache ();
 };
 
 #endif /* DBOBJECT_H_ */
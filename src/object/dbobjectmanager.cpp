@@ -50,6 +50,9 @@ DBObjectManager::DBObjectManager(const std::string& class_id, const std::string&
     registerParameter("limit_min", &limit_min_, 0);
     registerParameter("limit_max", &limit_max_, 100000);
 
+    registerParameter("use_column_cache", &use_column_cache_, false);
+    registerParameter("column_cache_max_size", &column_cache_max_size_, 4096);
+
     createSubConfigurables ();
 
     lock();
@@ -253,6 +256,17 @@ void DBObjectManager::useOrder(bool use_order)
     use_order_ = use_order;
 }
 
+bool DBObjectManager::useColumnCache() const
+{
+    return use_column_cache_;
+}
+
+void DBObjectManager::useColumnCache(bool use_column_cache)
+{
+    use_column_cache_ = use_column_cache;
+    loginf << "DBObjectManager: useColumnCache: " << use_column_cache_;
+}
+
 bool DBObjectManager::useOrderAscending() const
 {
     return use_order_ascending_;
@@ -108,6 +108,12 @@ public:
     bool useOrderAscending() const;
     void useOrderAscending(bool useOrderAscending);
 
+    /// @brief Returns if loaded data is cached in and read from column cache files
+    bool useColumnCache() const;
+    void useColumnCache(bool use_column_cache);
+    /// @brief Returns maximum size of all column cache files in MB, least recently used ones are removed
+    unsigned int columnCacheMaxSize() const { return column_cache_max_size_; }
+
     bool hasOrderVariable ();
     DBOVariable& orderVariable ();
     void orderVariable(DBOVariable& variable);
@@ -133,6 +139,9 @@ protected:
     unsigned int limit_min_ {0};
     unsigned int limit_max_ {100000};
 
+    bool use_column_cache_ {false};
+    unsigned int column_cache_max_size_ {4096};
+
     bool locked_ {false};
 
     /// Container with all DBOs (DBO name -> DBO pointer)
@@ -130,6 +130,12 @@ DBObjectManagerLoadWidget::DBObjectManagerLoadWidget(DBObjectManager &object_man
     limit_layout->addWidget(limit_max_edit_, 1, 1);
 
     main_layout->addLayout(limit_layout);
+
+    column_cache_check_ = new QCheckBox ("Use Column Cache");
+    column_cache_check_->setChecked(object_manager_.useColumnCache());
+    connect (column_cache_check_, SIGNAL(toggled(bool)), this, SLOT(toggleUseColumnCache()));
+    main_layout->addWidget(column_cache_check_);
+
     main_layout->addStretch();
 
     // load
@@ -195,6 +201,13 @@ void DBObjectManagerLoadWidget::toggleUseLimit()
 }
 
 
+void DBObjectManagerLoadWidget::toggleUseColumnCache ()
+{
+    assert (column_cache_check_);
+    bool checked = column_cache_check_->checkState() == Qt::Checked;
+    object_manager_.useColumnCache(checked);
+}
+
 void DBObjectManagerLoadWidget::limitMinChanged()
 {
     assert (limit_min_edit_);
@@ -51,6 +51,8 @@ public slots:
     void limitMinChanged();
     /// @brief Called when limit maximum is changed
     void limitMaxChanged();
+    /// @brief Called when the use column cache checkbox is un/checked
+    void toggleUseColumnCache ();
 
     void loadButtonSlot ();
     void updateSlot ();
@@ -77,6 +79,7 @@ private:
     QLineEdit* limit_min_edit_ {nullptr};
     /// Limit maximum edit field
     QLineEdit* limit_max_edit_ {nullptr};
+    QCheckBox* column_cache_check_ {nullptr};
 
     QPushButton* load_button_ {nullptr};
 
@@ -130,6 +130,8 @@ public:
 
     DBObject& dbObject () const { assert (db_object_); return *db_object_; }
 
+    /// @brief Returns if minimum/maximum were already read, without database access
+    bool hasMinMax () const { return min_max_set_; }
     std::string getMinString ();
     std::string getMaxString ();
     std::string getMinStringRepresentation ();
@@ -18,6 +18,7 @@
 #include "dbschema.h"
 #include "dbtable.h"
 #include "dbtablecolumn.h"
+#include "dbtableindex.h"
 #include "dbtableinfo.h"
 #include "dbtablewidget.h"
 #include "atsdb.h"
@@ -43,6 +44,10 @@ DBTable::~DBTable()
         delete it.second;
     columns_.clear();
 
+    for (auto it : indexes_)
+        delete it.second;
+    indexes_.clear();
+
     if (widget_)
     {
         delete widget_;
@@ -64,6 +69,13 @@ void DBTable::generateSubConfigurable (const std::string& class_id, const std::s
         if (column->isKey())
             key_name_ = column->name();
     }
+    else if (class_id == "DBTableIndex")
+    {
+        DBTableIndex *index = new DBTableIndex ("DBTableIndex", instance_id, this, db_interface_);
+        assert (index->name().size() != 0);
+        assert (indexes_.find(index->name()) == indexes_.end());
+        indexes_.insert (std::pair <std::string, DBTableIndex*> (index->name(), index));
+    }
     else
         throw std::runtime_error ("DBTable: generateSubConfigurable: unknown class_id "+class_id);
 }
@@ -89,6 +101,21 @@ void DBTable::deleteColumn (const std::string &name)
     columns_.erase(columns_.find(name));
 }
 
+void DBTable::addIndex (const std::string& name, const std::string& column_names)
+{
+    loginf << "DBTable: addIndex: table " << name_ << " index " << name << " columns " << column_names;
+
+    if (hasIndex(name))
+        throw std::invalid_argument ("DBTable: addIndex: index '"+name+"' already defined");
+
+    Configuration &config = addNewSubConfiguration ("DBTableIndex", name);
+    config.addParameterString ("name", name);
+    config.addParameterString ("columns", column_names);
+    generateSubConfigurable("DBTableIndex", name);
+
+    indexes_.at(name)->updateOnDatabase();
+}
+
 void DBTable::populate ()
 {
     loginf << "DBTable: populate: table " << name_;
@@ -144,6 +171,9 @@ void DBTable::updateOnDatabase()
 
     exists_in_db_ = exists;
 
+    for (auto index_it : indexes_)
+        index_it.second->updateOnDatabase();
+
     logdbg << "DBTable: updateOnDatabase: " << name_ << " exists in db " << exists_in_db_;
 }
 
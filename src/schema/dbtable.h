@@ -21,6 +21,7 @@
 #include "configurable.h"
 
 class DBTableColumn;
+class DBTableIndex;
 class DBTableWidget;
 class DBSchema;
 class DBInterface;
@@ -28,8 +29,8 @@ class DBInterface;
 /**
  * @brief Database table definition
  *
- * Has some parameters (name, name in database, key column name, description) and a collection of DBTableColumn
- *  instances.
+ * Has some parameters (name, name in database, key column name, description), a collection of DBTableColumn
+ *  instances and a collection of secondary DBTableIndex definitions.
  */
 class DBTable : public Configurable
 {
@@ -60,6 +61,12 @@ public:
     /// @brief Returns container with all table columns
     const std::map <std::string, DBTableColumn*>& columns () const { return columns_; }
 
+    bool hasIndex (const std::string& name) const { return indexes_.count(name) > 0; }
+    /// @brief Returns container with all secondary index definitions
+    const std::map <std::string, DBTableIndex*>& indexes () const { return indexes_; }
+    /// @brief Adds secondary index definition over comma separated column names
+    void addIndex (const std::string& name, const std::string& column_names);
+
     /// @brief Returns if the name of the key column is defined
     bool hasKey() const { return key_name_.size() > 0; }
     /// @brief Sets the name of the key column
@@ -94,6 +101,8 @@ private:
     std::string key_name_;
     /// Container with all table columns (column name -> DBTableColumn)
     std::map <std::string, DBTableColumn*> columns_;
+    /// Container with all secondary index definitions (index name -> DBTableIndex)
+    std::map <std::string, DBTableIndex*> indexes_;
 
     bool exists_in_db_ {false};
 
@@ -76,6 +76,7 @@ void DBTableColumn::name (const std::string &name)
 {
     name_=name;
     table_.name()+"."+name_;
+    db_interface_.clearSQLCache();
 }
 
 bool DBTableColumn::operator ==(const DBTableColumn& b) const
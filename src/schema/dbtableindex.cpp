@@ -0,0 +1,56 @@
+/*
+ * This file is part of ATSDB.
+ *
+ * ATSDB is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * ATSDB is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with ATSDB.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "dbtableindex.h"
+#include "dbtable.h"
+#include "dbtableinfo.h"
+#include "dbinterface.h"
+#include "stringconv.h"
+#include "logger.h"
+
+DBTableIndex::DBTableIndex(const std::string& class_id, const std::string& instance_id, DBTable* table,
+                           DBInterface& db_interface)
+ : Configurable (class_id, instance_id, table), table_(*table), db_interface_(db_interface)
+{
+    registerParameter ("name", &name_, "");
+    registerParameter ("columns", &column_names_, "");
+}
+
+std::vector<std::string> DBTableIndex::columns() const
+{
+    std::vector<std::string> columns;
+
+    for (auto& column : Utils::String::split(column_names_, ','))
+    {
+        size_t begin = column.find_first_not_of(' ');
+
+        if (begin != std::string::npos)
+            columns.push_back(column.substr(begin, column.find_last_not_of(' ')-begin+1));
+    }
+
+    return columns;
+}
+
+void DBTableIndex::updateOnDatabase()
+{
+    const std::map <std::string, DBTableInfo> &all_table_infos = db_interface_.tableInfo ();
+
+    exists_in_db_ = all_table_infos.count(table_.name()) && all_table_infos.at(table_.name()).hasIndex(name_);
+
+    logdbg << "DBTableIndex: updateOnDatabase: table " << table_.name() << " index " << name_
+           << " exists in db " << exists_in_db_;
+}
@@ -0,0 +1,68 @@
+/*
+ * This file is part of ATSDB.
+ *
+ * ATSDB is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * ATSDB is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with ATSDB.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef DBTABLEINDEX_H_
+#define DBTABLEINDEX_H_
+
+#include <string>
+#include <vector>
+
+#include "configurable.h"
+
+class DBTable;
+class DBInterface;
+
+/**
+ * @brief Secondary index definition of a DBTable
+ *
+ * Index over one or more columns, given as comma separated names in index order. Created on the database by
+ * DBInterface::createIndexes if not existing there.
+ */
+class DBTableIndex : public Configurable
+{
+public:
+    /// @brief Constructor
+    DBTableIndex(const std::string& class_id, const std::string& instance_id, DBTable* table,
+                 DBInterface& db_interface);
+    /// @brief Destructor
+    virtual ~DBTableIndex() {}
+
+    /// @brief Returns the index name
+    const std::string& name() const { return name_; }
+    /// @brief Returns comma separated column names
+    const std::string& columnNames() const { return column_names_; }
+    /// @brief Returns column names in index order
+    std::vector<std::string> columns() const;
+
+    DBTable& table() const { return table_; }
+
+    void updateOnDatabase(); // check what informations is present in the current db
+    bool existsInDB () const { return exists_in_db_; }
+
+protected:
+    DBTable& table_;
+    DBInterface& db_interface_;
+
+    /// Name of the index, unique in the database
+    std::string name_;
+    /// Comma separated column names
+    std::string column_names_;
+
+    bool exists_in_db_ {false};
+};
+
+#endif /* DBTABLEINDEX_H_ */
@@ -127,6 +127,7 @@ void MetaDBTable::addSubTable (const std::string& local_key, const std::string&
     generateSubConfigurable ("SubTableDefinition", instance_id);
 
     assert (hasSubTable(sub_table_name));
+    db_interface_.clearSQLCache();
 }
 
 void MetaDBTable::removeSubTable (const std::string& name)
@@ -138,6 +139,7 @@ void MetaDBTable::removeSubTable (const std::string& name)
     sub_tables_.erase (name);
 
     updateColumns();
+    db_interface_.clearSQLCache();
 }
 
 void MetaDBTable::lock ()
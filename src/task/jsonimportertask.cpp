@@ -33,6 +33,7 @@
 #include "jobmanager.h"
 #include "jsonparsejob.h"
 #include "jsonmappingjob.h"
+#include "dbinterface.h"
 
 #include <stdexcept>
 #include <fstream>
@@ -59,6 +60,9 @@ JSONImporterTask::JSONImporterTask(const std::string& class_id, const std::strin
 
 JSONImporterTask::~JSONImporterTask()
 {
+    if (bulk_mode_) // left on all import exit paths and in shutdown, while the connection is open
+        logerr << "JSONImporterTask: destructor: still in bulk mode, deferred indexes not created";
+
     if (msg_box_)
     {
         delete msg_box_;
@@ -233,6 +237,14 @@ void JSONImporterTask::importFile(const std::string& filename, bool test)
 
     start_time_ = boost::posix_time::microsec_clock::local_time();
 
+    buffer_pool_ = std::make_shared<BufferPool>();
+
+    if (!test_)
+    {
+        ATSDB::instance().interface().bulkMode(true);
+        bulk_mode_ = true;
+    }
+
     read_json_job_ = std::shared_ptr<ReadJSONFilePartJob> (new ReadJSONFilePartJob (filename, false, 10000));
     connect (read_json_job_.get(), SIGNAL(obsoleteSignal()), this, SLOT(readJSONFilePartObsoleteSlot()),
              Qt::QueuedConnection);
@@ -276,6 +288,14 @@ void JSONImporterTask::importFileArchive (const std::string& filename, bool test
 
     start_time_ = boost::posix_time::microsec_clock::local_time();
 
+    buffer_pool_ = std::make_shared<BufferPool>();
+
+    if (!test_)
+    {
+        ATSDB::instance().interface().bulkMode(true);
+        bulk_mode_ = true;
+    }
+
     read_json_job_ = std::shared_ptr<ReadJSONFilePartJob> (new ReadJSONFilePartJob (filename, true, 10000));
     connect (read_json_job_.get(), SIGNAL(obsoleteSignal()), this, SLOT(readJSONFilePartObsoleteSlot()),
              Qt::QueuedConnection);
@@ -341,6 +361,9 @@ void JSONImporterTask::readJSONFilePartDoneSlot ()
 void JSONImporterTask::readJSONFilePartObsoleteSlot ()
 {
     logdbg << "JSONImporterTask: readJSONFilePartObsoleteSlot";
+
+    read_json_job_ = nullptr;
+    endBulkMode(); // import canceled
 }
 
 void JSONImporterTask::parseJSONDoneSlot ()
@@ -364,7 +387,8 @@ void JSONImporterTask::parseJSONDoneSlot ()
 
     std::shared_ptr<JSONMappingJob> json_map_job =
             std::shared_ptr<JSONMappingJob> (new JSONMappingJob (std::move(json_objects),
-                                                                 schemas_.at(current_schema_).parsers(), key_count_));
+                                                                 schemas_.at(current_schema_).parsers(), key_count_,
+                                                                 buffer_pool_));
     connect (json_map_job.get(), SIGNAL(obsoleteSignal()), this, SLOT(mapJSONObsoleteSlot()),
              Qt::QueuedConnection);
     connect (json_map_job.get(), SIGNAL(doneSignal()), this, SLOT(mapJSONDoneSlot()), Qt::QueuedConnection);
@@ -383,6 +407,8 @@ void JSONImporterTask::parseJSONDoneSlot ()
 void JSONImporterTask::parseJSONObsoleteSlot ()
 {
     logdbg << "JSONImporterTask: parseJSONObsoleteSlot";
+
+    endBulkMode(); // import canceled
 }
 
 void JSONImporterTask::mapJSONDoneSlot ()
@@ -455,6 +481,8 @@ void JSONImporterTask::mapJSONDoneSlot ()
 void JSONImporterTask::mapJSONObsoleteSlot ()
 {
     logdbg << "JSONImporterTask: mapJSONObsoleteSlot";
+
+    endBulkMode(); // import canceled
 }
 
 void JSONImporterTask::insertData ()
@@ -606,6 +634,9 @@ void JSONImporterTask::checkAllDone ()
         loginf << "JSONImporterTask: checkAllDone: read done after " << time_str;
 
         all_done_ = true;
+        buffer_pool_ = nullptr;
+
+        endBulkMode();
 
         if (widget_)
             widget_->importDoneSlot(test_);
@@ -614,6 +645,32 @@ void JSONImporterTask::checkAllDone ()
     logdbg << "JSONImporterTask: checkAllDone: done";
 }
 
+void JSONImporterTask::shutdown ()
+{
+    loginf << "JSONImporterTask: shutdown";
+
+    endBulkMode(); // import not finished
+}
+
+void JSONImporterTask::endBulkMode ()
+{
+    if (!bulk_mode_)
+        return;
+
+    loginf << "JSONImporterTask: endBulkMode";
+
+    bulk_mode_ = false;
+
+    if (!ATSDB::instance().interface().ready())
+    {
+        logerr << "JSONImporterTask: endBulkMode: connection closed, deferred indexes not created";
+        return;
+    }
+
+    ATSDB::instance().interface().createIndexes(); // deferred in bulk mode, built with bulk settings
+    ATSDB::instance().interface().bulkMode(false);
+}
+
 void JSONImporterTask::updateMsgBox ()
 {
     logdbg << "JSONImporterTask: updateMsgBox";
@@ -35,6 +35,7 @@ class SavedFile;
 class QMessageBox;
 class JSONParseJob;
 class JSONMappingJob;
+class BufferPool;
 
 class JSONImporterTask : public QObject, public Configurable
 {
@@ -60,6 +61,9 @@ public:
                      TaskManager* task_manager);
     virtual ~JSONImporterTask();
 
+    /// @brief Leaves bulk mode of an unfinished import, to be called while the database connection is open
+    void shutdown ();
+
     JSONImporterTaskWidget* widget();
 
     virtual void generateSubConfigurable (const std::string &class_id, const std::string &instance_id);
@@ -102,10 +106,14 @@ protected:
     std::shared_ptr <ReadJSONFilePartJob> read_json_job_;
     std::vector<std::shared_ptr <JSONParseJob>> json_parse_jobs_;
     std::vector<std::shared_ptr <JSONMappingJob>> json_map_jobs_;
+    /// Recycled buffer storage of the current import
+    std::shared_ptr<BufferPool> buffer_pool_;
 
     std::string filename_;
     bool test_ {false};
     bool archive_ {false};
+    /// Import switched the database interface to bulk mode
+    bool bulk_mode_ {false};
 
     boost::posix_time::ptime start_time_;
     boost::posix_time::ptime stop_time_;
@@ -136,6 +144,8 @@ protected:
     void insertData ();
 
     void checkAllDone ();
+    /// @brief Creates indexes deferred in bulk mode and leaves it, if entered by the import
+    void endBulkMode ();
 
     void updateMsgBox ();
 
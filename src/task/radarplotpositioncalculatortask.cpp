@@ -483,6 +483,18 @@ void RadarPlotPositionCalculatorTask::loadingDoneSlot (DBObject& object)
 
     size_t transformation_errors = 0;
 
+    NullableVector<int>& key_list = read_buffer->get<int>(read_buffer->handle<int>(key_var_str_));
+    NullableVector<int>& datasource_list = read_buffer->get<int>(read_buffer->handle<int>(datasource_var_str_));
+    NullableVector<double>& azimuth_list = read_buffer->get<double>(read_buffer->handle<double>(azimuth_var_str_));
+    NullableVector<double>& range_list = read_buffer->get<double>(read_buffer->handle<double>(range_var_str_));
+    NullableVector<int>& altitude_list = read_buffer->get<int>(read_buffer->handle<int>(altitude_var_str_));
+
+    ColumnHandle<double> latitude_handle = update_buffer->handle<double>(latitude_var_str_);
+    ColumnHandle<double> longitude_handle = update_buffer->handle<double>(longitude_var_str_);
+    ColumnHandle<int> key_handle = update_buffer->handle<int>(key_var_str_);
+
+    update_buffer->reserve(read_size);
+
     for (unsigned int cnt=0; cnt < read_size; cnt++)
     {
         if (cnt % 50000 == 0 && target_report_count_ != 0)
@@ -494,36 +506,35 @@ void RadarPlotPositionCalculatorTask::loadingDoneSlot (DBObject& object)
             QCoreApplication::processEvents(QEventLoop::ExcludeUserInputEvents);
         }
 
-        if (read_buffer->get<int>(key_var_str_).isNull(cnt))
+        if (key_list.isNull(cnt))
         {
             logerr << "RadarPlotPositionCalculatorTask: loadingDoneSlot: key null";
             continue;
         }
-        rec_num = read_buffer->get<int>(key_var_str_).get(cnt);
+        rec_num = key_list.get(cnt);
 
-        if (read_buffer->get<int>(datasource_var_str_).isNull(cnt))
+        if (datasource_list.isNull(cnt))
         {
             logerr << "RadarPlotPositionCalculatorTask: loadingDoneSlot: data source null";
             continue;
         }
-        sensor_id = read_buffer->get<int>(datasource_var_str_).get(cnt);
+        sensor_id = datasource_list.get(cnt);
 
         //sac = *((unsigned char*)adresses->at(1));
         //sic = *((unsigned char*)adresses->at(2));
 
-        if (read_buffer->get<double>(azimuth_var_str_).isNull(cnt)
-                || read_buffer->get<double>(range_var_str_).isNull(cnt))
+        if (azimuth_list.isNull(cnt) || range_list.isNull(cnt))
         {
             logdbg << "RadarPlotPositionCalculatorTask: loadingDoneSlot: position null";
             continue;
         }
 
-        pos_azm_deg =  read_buffer->get<double>(azimuth_var_str_).get(cnt);
-        pos_range_nm =  read_buffer->get<double>(range_var_str_).get(cnt);
+        pos_azm_deg =  azimuth_list.get(cnt);
+        pos_range_nm =  range_list.get(cnt);
 
-        has_altitude = !read_buffer->get<int>(altitude_var_str_).isNull(cnt);
+        has_altitude = !altitude_list.isNull(cnt);
         if (has_altitude)
-            altitude_ft = read_buffer->get<int>(altitude_var_str_).get(cnt);
+            altitude_ft = altitude_list.get(cnt);
         else
             altitude_ft = 0.0; // has to assumed in projection later on
 
@@ -612,9 +623,9 @@ void RadarPlotPositionCalculatorTask::loadingDoneSlot (DBObject& object)
             continue;
         }
 
-        update_buffer->get<double>(latitude_var_str_).set(update_cnt, lat);
-        update_buffer->get<double>(longitude_var_str_).set(update_cnt, lon);
-        update_buffer->get<int>(key_var_str_).set(update_cnt, rec_num);
+        update_buffer->get<double>(latitude_handle).set(update_cnt, lat);
+        update_buffer->get<double>(longitude_handle).set(update_cnt, lon);
+        update_buffer->get<int>(key_handle).set(update_cnt, rec_num);
         update_cnt++;
 
         //loginf << "uga cnt " << update_cnt << " rec_num " << rec_num << " lat " << lat << " long " << lon;
@@ -101,6 +101,7 @@ void TaskManager::shutdown ()
 
     if (json_importer_task_)
     {
+        json_importer_task_->shutdown();
         delete json_importer_task_;
         json_importer_task_ = nullptr;
     }
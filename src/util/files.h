@@ -12,9 +12,11 @@ static const std::string HOME_PATH = QDir::homePath().toStdString();
 static const std::string HOME_SUBDIRECTORY=HOME_PATH+"/.atsdb/";
 static const std::string CONF_SUBDIRECTORY="conf/";
 static const std::string DATA_SUBDIRECTORY="data/";
+static const std::string CACHE_SUBDIRECTORY="cache/";
 
 static const std::string HOME_CONF_DIRECTORY = HOME_SUBDIRECTORY+CONF_SUBDIRECTORY;
 static const std::string HOME_DATA_DIRECTORY = HOME_SUBDIRECTORY+DATA_SUBDIRECTORY;
+static const std::string HOME_CACHE_DIRECTORY = HOME_SUBDIRECTORY+CACHE_SUBDIRECTORY;
 
 extern std::string CURRENT_CONF_DIRECTORY;
 
@@ -0,0 +1,257 @@
+/*
+ * This file is part of ATSDB.
+ *
+ * ATSDB is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * ATSDB is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with ATSDB.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#define BOOST_TEST_MODULE BufferCacheTest
+#include <boost/test/included/unit_test.hpp>
+
+#include <cstdio>
+#include <cstdlib>
+#include <ctime>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <utime.h>
+
+#include "buffer.h"
+#include "buffercache.h"
+
+namespace
+{
+
+/// Temporary directory removed with all files at the end of a test
+struct CacheDirectory
+{
+    std::string path_;
+
+    CacheDirectory ()
+    {
+        char path[] = "/tmp/atsdb_buffercachetest_XXXXXX";
+        BOOST_REQUIRE (mkdtemp(path));
+        path_ = path;
+    }
+    ~CacheDirectory ()
+    {
+        std::string command = "rm -rf '" + path_ + "'";
+        if (system(command.c_str()))
+            BOOST_TEST_MESSAGE ("unable to remove " << path_);
+    }
+
+    std::string file (const std::string& name) const { return path_ + "/" + name; }
+};
+
+long fileSize (const std::string& file_name)
+{
+    struct stat status;
+    return stat(file_name.c_str(), &status) ? -1 : status.st_size;
+}
+
+void setModificationTime (const std::string& file_name, time_t time)
+{
+    struct utimbuf times {time, time};
+    BOOST_REQUIRE (!utime(file_name.c_str(), &times));
+}
+
+PropertyList testProperties ()
+{
+    PropertyList list;
+    list.addProperty("b", PropertyDataType::BOOL);
+    list.addProperty("i", PropertyDataType::INT);
+    list.addProperty("d", PropertyDataType::DOUBLE);
+    list.addProperty("s", PropertyDataType::STRING);
+    list.addProperty("ul", PropertyDataType::ULONGINT);
+    list.addProperty("c", PropertyDataType::CHAR);
+    return list;
+}
+
+/// Returns buffer of seized chunks with Nulls in all columns but "d" and "c", "ul" set in odd chunks only
+std::shared_ptr<Buffer> testBuffer ()
+{
+    std::shared_ptr<Buffer> all = std::make_shared<Buffer> (testProperties(), "Test");
+    size_t row = 0;
+
+    for (size_t chunk=0; chunk < 5; ++chunk)
+    {
+        Buffer buffer (testProperties(), "Test");
+        size_t size = 77+chunk;
+
+        for (size_t cnt=0; cnt < size; ++cnt)
+        {
+            size_t r = row+cnt;
+
+            if (r % 3)
+                buffer.get<bool>("b").set(cnt, r % 2);
+            else
+                buffer.get<bool>("b").setNull(cnt);
+
+            if (r % 5)
+                buffer.get<int>("i").set(cnt, -(int) r);
+            else
+                buffer.get<int>("i").setNull(cnt);
+
+            buffer.get<double>("d").set(cnt, r * 0.25);
+
+            if (r % 7)
+                buffer.get<std::string>("s").set(cnt, "s" + std::to_string(r % 11));
+            else
+                buffer.get<std::string>("s").setNull(cnt);
+
+            if (chunk % 2)
+                buffer.get<unsigned long>("ul").set(cnt, r * 1000000000ul);
+
+            buffer.get<char>("c").set(cnt, 'a' + r % 20);
+        }
+
+        all->seizeBuffer(buffer);
+        row += size;
+    }
+
+    return all;
+}
+
+template <typename T> void checkColumn (Buffer& expected, Buffer& actual, const std::string& name)
+{
+    NullableVector<T>& expected_column = expected.get<T>(name);
+    NullableVector<T>& actual_column = actual.get<T>(name);
+
+    for (size_t row=0; row < expected.size(); ++row)
+    {
+        BOOST_REQUIRE_EQUAL (actual_column.isNull(row), expected_column.isNull(row));
+
+        if (!expected_column.isNull(row))
+            BOOST_REQUIRE_EQUAL (actual_column.get(row), expected_column.get(row));
+    }
+}
+
+}
+
+BOOST_AUTO_TEST_CASE( write_and_read )
+{
+    CacheDirectory directory;
+    std::string file_name = directory.file("test.cache");
+
+    std::shared_ptr<Buffer> buffer = testBuffer();
+    std::shared_ptr<Buffer> copy = buffer->getPartialCopy(buffer->properties());
+
+    BufferCache cache (file_name, "key1", 1234);
+    BOOST_CHECK (!cache.valid());
+    BOOST_REQUIRE (cache.write(*copy));
+
+    BOOST_CHECK (cache.valid());
+    BOOST_CHECK (!BufferCache(file_name, "key2", 1234).valid());
+    BOOST_CHECK (!BufferCache(file_name, "key1", 1235).valid());
+    BOOST_CHECK (!BufferCache(file_name, "key1", 1235).read("Test"));
+    BOOST_CHECK (!BufferCache(directory.file("other.cache"), "key1", 1234).valid());
+
+    std::shared_ptr<Buffer> read = cache.read("Test");
+    BOOST_REQUIRE (read);
+    BOOST_CHECK_EQUAL (read->size(), buffer->size());
+    BOOST_CHECK_EQUAL (read->dboName(), "Test");
+    BOOST_CHECK_EQUAL (read->properties().size(), 6);
+
+    checkColumn<bool> (*buffer, *read, "b");
+    checkColumn<int> (*buffer, *read, "i");
+    checkColumn<double> (*buffer, *read, "d");
+    checkColumn<std::string> (*buffer, *read, "s");
+    checkColumn<unsigned long> (*buffer, *read, "ul");
+    checkColumn<char> (*buffer, *read, "c");
+
+    BOOST_REQUIRE (!truncate(file_name.c_str(), fileSize(file_name) / 2));
+    BOOST_CHECK (cache.valid()); // header still matches
+    BOOST_CHECK (!cache.read("Test"));
+}
+
+BOOST_AUTO_TEST_CASE( limit_directory )
+{
+    CacheDirectory directory;
+    std::shared_ptr<Buffer> buffer = testBuffer();
+
+    BufferCache first (directory.file("first.cache"), "key", 1);
+    BufferCache second (directory.file("second.cache"), "key", 1);
+
+    BOOST_REQUIRE (first.write(*buffer));
+    BOOST_REQUIRE (second.write(*buffer));
+
+    long size = fileSize(first.fileName());
+    BOOST_REQUIRE (size > 0);
+
+    time_t now = time(nullptr);
+    setModificationTime(first.fileName(), now - 100);
+    setModificationTime(second.fileName(), now - 50);
+
+    second.limitDirectory(2*size);
+    BOOST_CHECK (first.valid());
+    BOOST_CHECK (second.valid());
+
+    BOOST_CHECK (first.read("Test")); // now most recently used
+
+    second.limitDirectory(size+1);
+    BOOST_CHECK (first.valid());
+    BOOST_CHECK (!second.valid());
+    BOOST_CHECK_EQUAL (fileSize(second.fileName()), -1);
+}
+
+BOOST_AUTO_TEST_CASE( validity_beyond_data )
+{
+    CacheDirectory directory;
+    std::string file_name = directory.file("test.cache");
+
+    PropertyList list;
+    list.addProperty("i", PropertyDataType::INT);
+
+    Buffer buffer (list, "Test");
+
+    for (int row=0; row < 5; ++row)
+        buffer.get<int>("i").set(row, row);
+
+    buffer.get<int>("i").setNull(9); // flags beyond stored data
+
+    BufferCache cache (file_name, "key", 1);
+    BOOST_REQUIRE (cache.write(buffer));
+
+    std::shared_ptr<Buffer> read = cache.read("Test");
+    BOOST_REQUIRE (read);
+    BOOST_CHECK_EQUAL (read->size(), 10);
+
+    for (size_t row=0; row < 10; ++row)
+    {
+        BOOST_CHECK_EQUAL (read->get<int>("i").isNull(row), row >= 5);
+
+        if (row < 5)
+            BOOST_CHECK_EQUAL (read->get<int>("i").get(row), (int) row);
+    }
+
+    // magic, version, source time, key, size, number of properties, name, data type
+    long data_length_position = 8 + 4 + 8 + (8 + 3) + 8 + 8 + (8 + 1) + 4;
+
+    auto patch = [&] (long position, uint64_t value)
+    {
+        FILE* file = fopen(file_name.c_str(), "r+b");
+        BOOST_REQUIRE (file);
+        BOOST_REQUIRE (!fseek(file, position, SEEK_SET));
+        BOOST_REQUIRE_EQUAL (fwrite(&value, sizeof(value), 1, file), 1);
+        fclose(file);
+    };
+
+    patch (data_length_position + 8, 6); // validity size > data length
+    BOOST_CHECK (cache.valid());
+    BOOST_CHECK (!cache.read("Test"));
+
+    patch (data_length_position + 8, 5);
+    BOOST_CHECK (cache.read("Test"));
+
+    patch (data_length_position, 11); // data length > buffer size
+    BOOST_CHECK (!cache.read("Test"));
+}
@@ -0,0 +1,334 @@
+/*
+ * This file is part of ATSDB.
+ *
+ * ATSDB is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * ATSDB is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with ATSDB.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#define BOOST_TEST_MODULE BufferTest
+#include <boost/test/included/unit_test.hpp>
+
+#include "buffer.h"
+
+namespace
+{
+
+PropertyList testProperties ()
+{
+    PropertyList list;
+    list.addProperty("b", PropertyDataType::BOOL);
+    list.addProperty("i", PropertyDataType::INT);
+    list.addProperty("d", PropertyDataType::DOUBLE);
+    list.addProperty("s", PropertyDataType::STRING);
+    list.addProperty("ul", PropertyDataType::ULONGINT);
+    return list;
+}
+
+/// Sets row of buffer to values derived from row number r, "ul" only if set_ul
+void setRow (Buffer& buffer, size_t row, size_t r, bool set_ul)
+{
+    if (r % 3)
+        buffer.get<bool>("b").set(row, r % 2);
+    else
+        buffer.get<bool>("b").setNull(row);
+
+    if (r % 5)
+        buffer.get<int>("i").set(row, -(int) r);
+    else
+        buffer.get<int>("i").setNull(row);
+
+    buffer.get<double>("d").set(row, r * 0.25);
+
+    if (r % 7)
+        buffer.get<std::string>("s").set(row, "s" + std::to_string(r % 11));
+    else
+        buffer.get<std::string>("s").setNull(row);
+
+    if (set_ul)
+        buffer.get<unsigned long>("ul").set(row, r * 1000000000ul);
+}
+
+/// Checks row of buffer as set by setRow for r, "ul" Null unless has_ul
+void checkRow (Buffer& buffer, size_t row, size_t r, bool has_ul)
+{
+    BOOST_CHECK_EQUAL (buffer.get<bool>("b").isNull(row), r % 3 == 0);
+    if (r % 3)
+        BOOST_CHECK_EQUAL (buffer.get<bool>("b").get(row), (bool) (r % 2));
+
+    BOOST_CHECK_EQUAL (buffer.get<int>("i").isNull(row), r % 5 == 0);
+    if (r % 5)
+        BOOST_CHECK_EQUAL (buffer.get<int>("i").get(row), -(int) r);
+
+    BOOST_CHECK_EQUAL (buffer.get<double>("d").get(row), r * 0.25);
+
+    BOOST_CHECK_EQUAL (buffer.get<std::string>("s").isNull(row), r % 7 == 0);
+    if (r % 7)
+        BOOST_CHECK_EQUAL (buffer.get<std::string>("s").get(row), "s" + std::to_string(r % 11));
+
+    BOOST_CHECK_EQUAL (buffer.get<unsigned long>("ul").isNull(row), !has_ul);
+    if (has_ul)
+        BOOST_CHECK_EQUAL (buffer.get<unsigned long>("ul").get(row), r * 1000000000ul);
+}
+
+void checkRow (Buffer& buffer, size_t r, bool has_ul)
+{
+    checkRow (buffer, r, r, has_ul);
+}
+
+}
+
+BOOST_AUTO_TEST_CASE( seize_many_chunks )
+{
+    const size_t num_chunks = 500;
+
+    Buffer all (testProperties(), "Test");
+    std::vector<size_t> chunk_starts;
+    size_t rows = 0;
+
+    for (size_t chunk=0; chunk < num_chunks; ++chunk)
+    {
+        Buffer buffer (testProperties(), "Test");
+        size_t size = 1 + chunk % 97; // unaligned to validity words
+
+        for (size_t row=0; row < size; ++row)
+            setRow (buffer, row, rows+row, chunk % 2);
+
+        chunk_starts.push_back(rows);
+        all.seizeBuffer(buffer);
+        rows += size;
+
+        BOOST_CHECK_EQUAL (buffer.properties().size(), 0); // containers were moved
+    }
+
+    BOOST_CHECK_EQUAL (all.size(), rows);
+
+    for (size_t chunk=0; chunk < num_chunks; ++chunk)
+    {
+        size_t end = chunk+1 < num_chunks ? chunk_starts[chunk+1] : rows;
+
+        for (size_t r=chunk_starts[chunk]; r < end; ++r)
+            checkRow (all, r, chunk % 2);
+    }
+}
+
+BOOST_AUTO_TEST_CASE( seize_into_empty )
+{
+    Buffer all (testProperties(), "Test");
+    Buffer buffer (testProperties(), "Test");
+
+    for (size_t row=0; row < 70; ++row)
+        setRow (buffer, row, row, true);
+
+    all.seizeBuffer(buffer);
+
+    BOOST_CHECK_EQUAL (all.size(), 70);
+
+    for (size_t r=0; r < 70; ++r)
+        checkRow (all, r, true);
+}
+
+BOOST_AUTO_TEST_CASE( write_after_seize )
+{
+    Buffer all (testProperties(), "Test");
+
+    for (size_t chunk=0; chunk < 3; ++chunk)
+    {
+        Buffer buffer (testProperties(), "Test");
+
+        for (size_t row=0; row < 10; ++row)
+            setRow (buffer, row, chunk*10+row, true);
+
+        all.seizeBuffer(buffer);
+    }
+
+    for (size_t r=30; r < 40; ++r) // appends after pending chunks
+        setRow (all, r, r, true);
+
+    all.get<int>("i").set(5, 42); // overwrites inside a seized chunk
+
+    BOOST_CHECK_EQUAL (all.size(), 40);
+    BOOST_CHECK_EQUAL (all.get<int>("i").get(5), 42);
+
+    for (size_t r=0; r < 40; ++r)
+    {
+        if (r != 5)
+            checkRow (all, r, true);
+    }
+
+    all.cutToSize(15);
+    BOOST_CHECK_EQUAL (all.size(), 15);
+
+    for (size_t r=0; r < 15; ++r)
+    {
+        if (r != 5)
+            checkRow (all, r, true);
+    }
+}
+
+BOOST_AUTO_TEST_CASE( partial_copy_shares_until_written )
+{
+    Buffer buffer (testProperties(), "Test");
+
+    for (size_t row=0; row < 100; ++row)
+        setRow (buffer, row, row, true);
+
+    PropertyList partial;
+    partial.addProperty("i", PropertyDataType::INT);
+    partial.addProperty("s", PropertyDataType::STRING);
+
+    std::shared_ptr<Buffer> copy = buffer.getPartialCopy(partial);
+
+    BOOST_CHECK_EQUAL (copy->size(), 100);
+    BOOST_CHECK_EQUAL (copy->properties().size(), 2);
+    BOOST_CHECK (!copy->has<double>("d"));
+    BOOST_CHECK (copy->get<int>("i").data() == buffer.get<int>("i").data()); // not copied
+
+    copy->get<int>("i").set(1, 1000);
+    copy->get<std::string>("s").set(2, "copy");
+    copy->get<int>("i").setNull(3);
+
+    BOOST_CHECK (copy->get<int>("i").data() != buffer.get<int>("i").data());
+    BOOST_CHECK_EQUAL (copy->get<int>("i").get(1), 1000);
+    BOOST_CHECK_EQUAL (copy->get<std::string>("s").get(2), "copy");
+    BOOST_CHECK (copy->get<int>("i").isNull(3));
+
+    buffer.get<int>("i").set(4, 2000);
+    BOOST_CHECK_EQUAL (copy->get<int>("i").get(4), -4);
+
+    for (size_t r=0; r < 100; ++r)
+    {
+        if (r != 4)
+            checkRow (buffer, r, true);
+    }
+
+    BOOST_CHECK_EQUAL (buffer.get<int>("i").get(4), 2000);
+}
+
+BOOST_AUTO_TEST_CASE( partial_copy_of_seized )
+{
+    Buffer all (testProperties(), "Test");
+
+    for (size_t chunk=0; chunk < 4; ++chunk)
+    {
+        Buffer buffer (testProperties(), "Test");
+
+        for (size_t row=0; row < 50; ++row)
+            setRow (buffer, row, chunk*50+row, true);
+
+        all.seizeBuffer(buffer);
+    }
+
+    std::shared_ptr<Buffer> copy = all.getPartialCopy(all.properties());
+
+    for (size_t r=200; r < 210; ++r) // appending to the original must not change the copy
+        setRow (all, r, r, true);
+
+    BOOST_CHECK_EQUAL (copy->size(), 200);
+    BOOST_CHECK_EQUAL (all.size(), 210);
+
+    for (size_t r=0; r < 200; ++r)
+        checkRow (*copy, r, true);
+
+    for (size_t r=0; r < 210; ++r)
+        checkRow (all, r, true);
+}
+
+BOOST_AUTO_TEST_CASE( view_shares_rows )
+{
+    Buffer buffer (testProperties(), "Test");
+
+    for (size_t row=0; row < 200; ++row)
+        setRow (buffer, row, row, true);
+
+    std::shared_ptr<Buffer> view = buffer.getView(70, 50); // unaligned to validity words
+
+    BOOST_CHECK_EQUAL (view->size(), 50);
+    BOOST_CHECK_EQUAL (view->dboName(), "Test");
+    BOOST_CHECK (view->get<int>("i").data() == buffer.get<int>("i").data() + 70); // not copied
+
+    for (size_t row=0; row < 50; ++row)
+    {
+        size_t r = 70 + row;
+
+        BOOST_CHECK_EQUAL (view->get<int>("i").isNull(row), r % 5 == 0);
+        if (r % 5)
+            BOOST_CHECK_EQUAL (view->get<int>("i").get(row), -(int) r);
+
+        BOOST_CHECK_EQUAL (view->get<bool>("b").isNull(row), r % 3 == 0);
+        if (r % 3)
+            BOOST_CHECK_EQUAL (view->get<bool>("b").get(row), (bool) (r % 2));
+
+        BOOST_CHECK_EQUAL (view->get<std::string>("s").isNull(row), r % 7 == 0);
+        if (r % 7)
+            BOOST_CHECK_EQUAL (view->get<std::string>("s").get(row), "s" + std::to_string(r % 11));
+
+        BOOST_CHECK_EQUAL (view->get<double>("d").get(row), r * 0.25);
+    }
+
+    view->get<int>("i").set(1, 1000); // copies the view's rows only
+    view->get<int>("i").set(60, 60); // grows the view
+
+    BOOST_CHECK_EQUAL (view->size(), 61);
+    BOOST_CHECK_EQUAL (view->get<int>("i").get(1), 1000);
+    BOOST_CHECK_EQUAL (view->get<int>("i").get(2), -72);
+    BOOST_CHECK (view->get<int>("i").isNull(55));
+    BOOST_CHECK_EQUAL (buffer.get<int>("i").get(71), -71);
+    BOOST_CHECK_EQUAL (buffer.get<int>("i").get(131), -131);
+
+    buffer.get<double>("d").set(72, -1.0);
+    BOOST_CHECK_EQUAL (view->get<double>("d").get(2), 72 * 0.25);
+
+    for (size_t r=0; r < 200; ++r)
+    {
+        if (r != 72)
+            checkRow (buffer, r, true);
+    }
+}
+
+BOOST_AUTO_TEST_CASE( view_ranges )
+{
+    Buffer buffer (testProperties(), "Test");
+
+    for (size_t row=0; row < 100; ++row)
+        setRow (buffer, row, row, row < 50); // "ul" data ends before the buffer
+
+    std::shared_ptr<Buffer> tail = buffer.getView(90, 20); // clipped at the end
+    BOOST_CHECK_EQUAL (tail->size(), 10);
+
+    for (size_t row=0; row < 10; ++row)
+        checkRow (*tail, row, 90 + row, false);
+
+    BOOST_CHECK_EQUAL (buffer.getView(100, 10)->size(), 0);
+    BOOST_CHECK_EQUAL (buffer.getView(200, 10)->size(), 0);
+
+    std::shared_ptr<Buffer> middle = buffer.getView(40, 20);
+    BOOST_CHECK_EQUAL (middle->size(), 20);
+
+    Buffer all (testProperties(), "Test"); // views can be seized like any buffer
+    all.seizeBuffer(*middle);
+    all.seizeBuffer(*tail);
+
+    BOOST_CHECK_EQUAL (all.size(), 30);
+
+    for (size_t row=0; row < 20; ++row)
+    {
+        size_t r = 40 + row;
+        BOOST_CHECK_EQUAL (all.get<unsigned long>("ul").isNull(row), r >= 50);
+        BOOST_CHECK_EQUAL (all.get<int>("i").isNull(row), r % 5 == 0);
+        if (r % 5)
+            BOOST_CHECK_EQUAL (all.get<int>("i").get(row), -(int) r);
+    }
+
+    for (size_t row=20; row < 30; ++row)
+        BOOST_CHECK_EQUAL (all.get<double>("d").get(row), (70 + row) * 0.25);
+}
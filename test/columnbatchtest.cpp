@@ -0,0 +1,308 @@
+/*
+ * This file is part of ATSDB.
+ *
+ * ATSDB is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * ATSDB is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with ATSDB.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#define BOOST_TEST_MODULE ColumnBatchTest
+#include <boost/test/included/unit_test.hpp>
+
+#include "columnbatch.h"
+
+using namespace ColumnBatch;
+
+namespace
+{
+
+PropertyList testProperties ()
+{
+    PropertyList list;
+    list.addProperty("b", PropertyDataType::BOOL);
+    list.addProperty("i", PropertyDataType::INT);
+    list.addProperty("s", PropertyDataType::STRING);
+    return list;
+}
+
+/// 150 rows, every 4th row Null in all columns
+void fill (Buffer& buffer)
+{
+    for (int row=0; row < 150; ++row)
+    {
+        if (row % 4)
+        {
+            buffer.get<bool>("b").set(row, row % 2);
+            buffer.get<int>("i").set(row, row % 10);
+            buffer.get<std::string>("s").set(row, "s" + std::to_string(row % 3));
+        }
+        else
+        {
+            buffer.get<bool>("b").setNull(row);
+            buffer.get<int>("i").setNull(row);
+            buffer.get<std::string>("s").setNull(row);
+        }
+    }
+}
+
+}
+
+BOOST_AUTO_TEST_CASE( compare_bool_with_nulls )
+{
+    Buffer buffer (testProperties(), "Test");
+    fill (buffer);
+
+    Bitmap bitmap = compare<bool> (buffer.get<bool>("b"), buffer.size(), CompareOp::EQUAL, true);
+    Bitmap not_equal = compare<bool> (buffer.get<bool>("b"), buffer.size(), CompareOp::NOT_EQUAL, true);
+
+    BOOST_CHECK_EQUAL (bitmap.size(), 3);
+
+    for (size_t row=0; row < 150; ++row)
+    {
+        BOOST_CHECK_EQUAL (isSet(bitmap, row), row % 4 && row % 2);
+        BOOST_CHECK_EQUAL (isSet(not_equal, row), row % 4 && !(row % 2)); // Null never matches
+    }
+}
+
+BOOST_AUTO_TEST_CASE( compare_int )
+{
+    Buffer buffer (testProperties(), "Test");
+    fill (buffer);
+    NullableVector<int>& column = buffer.get<int>("i");
+
+    Bitmap less = compare<int> (column, buffer.size(), CompareOp::LESS, 5);
+    Bitmap greater_equal = compare<int> (column, buffer.size(), CompareOp::GREATER_EQUAL, 5);
+    Bitmap equal = compare<int> (column, buffer.size(), CompareOp::EQUAL, 3);
+
+    for (size_t row=0; row < 150; ++row)
+    {
+        bool valid = row % 4;
+        BOOST_CHECK_EQUAL (isSet(less, row), valid && row % 10 < 5);
+        BOOST_CHECK_EQUAL (isSet(greater_equal, row), valid && row % 10 >= 5);
+        BOOST_CHECK_EQUAL (isSet(equal, row), valid && row % 10 == 3);
+    }
+
+    BOOST_CHECK (!isSet(less, 150));
+    BOOST_CHECK (!isSet(less, 1000)); // beyond bitmap
+}
+
+BOOST_AUTO_TEST_CASE( compare_string )
+{
+    Buffer buffer (testProperties(), "Test");
+    fill (buffer);
+    NullableVector<std::string>& column = buffer.get<std::string>("s");
+
+    Bitmap equal = compare (column, buffer.size(), CompareOp::EQUAL, std::string("s1"));
+    Bitmap not_equal = compare (column, buffer.size(), CompareOp::NOT_EQUAL, std::string("s1"));
+    Bitmap greater = compare (column, buffer.size(), CompareOp::GREATER, std::string("s0"));
+    Bitmap unknown = compare (column, buffer.size(), CompareOp::EQUAL, std::string("x"));
+
+    for (size_t row=0; row < 150; ++row)
+    {
+        bool valid = row % 4;
+        BOOST_CHECK_EQUAL (isSet(equal, row), valid && row % 3 == 1);
+        BOOST_CHECK_EQUAL (isSet(not_equal, row), valid && row % 3 != 1);
+        BOOST_CHECK_EQUAL (isSet(greater, row), valid && row % 3 != 0);
+        BOOST_CHECK (!isSet(unknown, row));
+    }
+}
+
+BOOST_AUTO_TEST_CASE( bitmap_operations )
+{
+    Buffer buffer (testProperties(), "Test");
+    fill (buffer);
+
+    Bitmap valid = notNull (buffer.get<int>("i"), buffer.size());
+    Bitmap odd = compare<bool> (buffer.get<bool>("b"), buffer.size(), CompareOp::EQUAL, true);
+    Bitmap small = compare<int> (buffer.get<int>("i"), buffer.size(), CompareOp::LESS, 2);
+
+    Selection selection = select (valid);
+    BOOST_CHECK_EQUAL (selection.size(), 150 - 38);
+    BOOST_CHECK_EQUAL (selection.front(), 1);
+    BOOST_CHECK_EQUAL (selection.back(), 149);
+
+    Bitmap both = odd;
+    intersect (both, small);
+    Selection expected;
+
+    for (size_t row=1; row < 150; row += 10) // odd rows with value 1
+        expected.push_back(row);
+
+    BOOST_CHECK (select(both) == expected);
+
+    Bitmap either = odd;
+    unite (either, small);
+
+    for (size_t row=0; row < 150; ++row)
+        BOOST_CHECK_EQUAL (isSet(either, row), isSet(odd, row) || isSet(small, row));
+
+    PropertyList list;
+    list.addProperty("i", PropertyDataType::INT);
+    Buffer dense (list, "Test");
+
+    for (int row=0; row < 70; ++row)
+        dense.get<int>("i").set(row, row);
+
+    Bitmap all = notNull (dense.get<int>("i"), dense.size()); // without validity, last word masked
+    BOOST_CHECK_EQUAL (select(all).size(), 70);
+}
+
+BOOST_AUTO_TEST_CASE( gather_scatter )
+{
+    Buffer buffer (testProperties(), "Test");
+    fill (buffer);
+
+    Selection selection ({3, 4, 5, 149, 200}); // 4 Null, 200 beyond size
+
+    PropertyList list;
+    list.addProperty("i", PropertyDataType::INT);
+    Buffer target (list, "Test");
+    NullableVector<int>& gathered = target.get<int>("i");
+
+    gather<int> (buffer.get<int>("i"), selection, gathered);
+
+    BOOST_CHECK_EQUAL (gathered.size(), 5);
+    BOOST_CHECK_EQUAL (gathered.get(0), 3);
+    BOOST_CHECK (gathered.isNull(1));
+    BOOST_CHECK_EQUAL (gathered.get(2), 5);
+    BOOST_CHECK_EQUAL (gathered.get(3), 9);
+    BOOST_CHECK (gathered.isNull(4));
+
+    gathered.set(0, 100);
+    scatter<int> (gathered, Selection({10, 11, 12}), buffer.get<int>("i"));
+
+    BOOST_CHECK_EQUAL (buffer.get<int>("i").get(10), 100);
+    BOOST_CHECK (buffer.get<int>("i").isNull(11));
+    BOOST_CHECK_EQUAL (buffer.get<int>("i").get(12), 5);
+
+    std::shared_ptr<Buffer> rows = gather (buffer, Selection({1, 2, 4}));
+    BOOST_CHECK_EQUAL (rows->size(), 3);
+    BOOST_CHECK_EQUAL (rows->get<bool>("b").get(0), true);
+    BOOST_CHECK_EQUAL (rows->get<bool>("b").get(1), false);
+    BOOST_CHECK (rows->get<bool>("b").isNull(2));
+    BOOST_CHECK_EQUAL (rows->get<std::string>("s").get(1), "s2");
+    BOOST_CHECK (rows->get<std::string>("s").isNull(2));
+}
+
+BOOST_AUTO_TEST_CASE( aggregates )
+{
+    Buffer buffer (testProperties(), "Test");
+    fill (buffer);
+
+    int min, max;
+    BOOST_CHECK (minMax<int> (buffer.get<int>("i"), min, max));
+    BOOST_CHECK_EQUAL (min, 0);
+    BOOST_CHECK_EQUAL (max, 9);
+
+    double expected = 0;
+
+    for (int row=0; row < 150; ++row)
+    {
+        if (row % 4)
+            expected += row % 10;
+    }
+
+    BOOST_CHECK_EQUAL (sum<int> (buffer.get<int>("i")), expected);
+
+    PropertyList list;
+    list.addProperty("i", PropertyDataType::INT);
+    Buffer empty (list, "Test");
+    empty.get<int>("i").setNull(0);
+
+    BOOST_CHECK (!minMax<int> (empty.get<int>("i"), min, max));
+    BOOST_CHECK_EQUAL (sum<int> (empty.get<int>("i")), 0);
+}
+
+BOOST_AUTO_TEST_CASE( sort_permutation )
+{
+    Buffer buffer (testProperties(), "Test");
+    fill (buffer);
+
+    Selection ascending = sortPermutation<int> (buffer.get<int>("i"), buffer.size());
+    Selection descending = sortPermutation<int> (buffer.get<int>("i"), buffer.size(), false);
+    Selection strings = sortPermutation (buffer.get<std::string>("s"), buffer.size(), false);
+
+    BOOST_REQUIRE_EQUAL (ascending.size(), 150);
+    BOOST_REQUIRE_EQUAL (descending.size(), 150);
+    BOOST_REQUIRE_EQUAL (strings.size(), 150);
+
+    for (size_t cnt=1; cnt < 112; ++cnt)
+    {
+        int previous = ascending[cnt-1] % 10, current = ascending[cnt] % 10;
+        BOOST_CHECK (previous < current || (previous == current && ascending[cnt-1] < ascending[cnt])); // stable
+
+        BOOST_CHECK (descending[cnt-1] % 10 >= descending[cnt] % 10);
+        BOOST_CHECK (strings[cnt-1] % 3 >= strings[cnt] % 3);
+    }
+
+    for (size_t cnt=112; cnt < 150; ++cnt) // Null rows last, in row order
+    {
+        BOOST_CHECK_EQUAL (ascending[cnt] % 4, 0);
+        BOOST_CHECK_EQUAL (ascending[cnt], (cnt-112)*4);
+        BOOST_CHECK_EQUAL (strings[cnt] % 4, 0);
+    }
+}
+
+BOOST_AUTO_TEST_CASE( unset_trailing_rows )
+{
+    PropertyList list;
+    list.addProperty("i", PropertyDataType::INT);
+    list.addProperty("d", PropertyDataType::DOUBLE);
+    list.addProperty("s", PropertyDataType::STRING);
+
+    Buffer buffer (list, "Test");
+
+    for (int row=0; row < 10; ++row)
+        buffer.get<double>("d").set(row, row);
+
+    for (int row=0; row < 5; ++row) // rows 5 to 8 never set
+        buffer.get<int>("i").set(row, 5-row);
+
+    buffer.get<int>("i").setNull(9);
+    buffer.get<std::string>("s").set(0, "b");
+    buffer.get<std::string>("s").set(1, "a");
+
+    BOOST_REQUIRE_EQUAL (buffer.size(), 10);
+
+    Selection sorted = sortPermutation<int> (buffer.get<int>("i"), buffer.size());
+    BOOST_CHECK (sorted == Selection({4, 3, 2, 1, 0, 5, 6, 7, 8, 9}));
+
+    std::shared_ptr<Buffer> rows = gather (buffer, sorted);
+    BOOST_REQUIRE_EQUAL (rows->size(), 10);
+
+    for (size_t row=0; row < 10; ++row)
+    {
+        BOOST_CHECK_EQUAL (rows->get<double>("d").get(row), sorted[row]);
+        BOOST_CHECK_EQUAL (rows->get<int>("i").isNull(row), row >= 5);
+    }
+
+    Selection strings = sortPermutation (buffer.get<std::string>("s"), buffer.size());
+    BOOST_CHECK (strings == Selection({1, 0, 2, 3, 4, 5, 6, 7, 8, 9}));
+
+    Bitmap valid = notNull (buffer.get<int>("i"), buffer.size());
+    Bitmap not_equal = compare<int> (buffer.get<int>("i"), buffer.size(), CompareOp::NOT_EQUAL, 1);
+    Bitmap string_not_equal = compare (buffer.get<std::string>("s"), buffer.size(), CompareOp::NOT_EQUAL,
+                                       std::string("a"));
+
+    BOOST_CHECK (select(valid) == Selection({0, 1, 2, 3, 4}));
+    BOOST_CHECK (select(not_equal) == Selection({0, 1, 2, 3}));
+    BOOST_CHECK (select(string_not_equal) == Selection({0}));
+
+    PropertyList unset_list;
+    unset_list.addProperty("i", PropertyDataType::INT);
+    Buffer unset (unset_list, "Test");
+    NullableVector<int>& never_set = unset.get<int>("i");
+
+    BOOST_CHECK (select(notNull (never_set, 3)).empty());
+    BOOST_CHECK (select(compare<int> (never_set, 3, CompareOp::NOT_EQUAL, 0)).empty());
+    BOOST_CHECK (sortPermutation<int> (never_set, 3) == Selection({0, 1, 2}));
+}
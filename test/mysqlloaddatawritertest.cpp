@@ -0,0 +1,124 @@
+/*
+ * This file is part of ATSDB.
+ *
+ * ATSDB is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * ATSDB is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with ATSDB.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#define BOOST_TEST_MODULE MySQLLoadDataWriterTest
+#include <boost/test/included/unit_test.hpp>
+
+#include <climits>
+#include <cmath>
+#include <cstdlib>
+
+#include "mysqlloaddatawriter.h"
+
+BOOST_AUTO_TEST_CASE( escaping_and_nulls )
+{
+    PropertyList list;
+    list.addProperty("name", PropertyDataType::STRING);
+    list.addProperty("flag", PropertyDataType::BOOL);
+    list.addProperty("num", PropertyDataType::INT);
+
+    Buffer buffer (list, "Test");
+    buffer.get<std::string>("name").set(0, "plain");
+    buffer.get<std::string>("name").set(1, std::string("a\\b\tc\nd\re\0f", 11));
+    buffer.get<std::string>("name").setNull(2);
+    buffer.get<std::string>("name").set(3, "\\N"); // literal, not Null
+
+    buffer.get<bool>("flag").set(0, true);
+    buffer.get<bool>("flag").set(1, false);
+    buffer.get<bool>("flag").setNull(2);
+
+    buffer.get<int>("num").set(0, 1);
+    buffer.get<int>("num").setNull(1);
+    buffer.get<int>("num").set(2, -7);
+    // num and flag not set in row 3, Null
+
+    MySQLLoadDataWriter writer (buffer);
+    BOOST_CHECK_EQUAL (writer.columnList(), "name, flag, num");
+
+    std::string text;
+    writer.write(text, 0, 4);
+
+    BOOST_CHECK_EQUAL (text, "plain\t1\t1\n"
+                             "a\\\\b\\tc\\nd\\re\\0f\t0\t\\N\n"
+                             "\\N\t\\N\t-7\n"
+                             "\\\\N\t\\N\t\\N\n");
+
+    std::string range;
+    writer.write(range, 2, 3);
+    BOOST_CHECK_EQUAL (range, "\\N\t\\N\t-7\n");
+}
+
+BOOST_AUTO_TEST_CASE( integer_limits )
+{
+    PropertyList list;
+    list.addProperty("i", PropertyDataType::INT);
+    list.addProperty("l", PropertyDataType::LONGINT);
+    list.addProperty("ul", PropertyDataType::ULONGINT);
+    list.addProperty("c", PropertyDataType::CHAR);
+    list.addProperty("uc", PropertyDataType::UCHAR);
+
+    Buffer buffer (list, "Test");
+    buffer.get<int>("i").set(0, INT_MIN);
+    buffer.get<long int>("l").set(0, LONG_MIN);
+    buffer.get<unsigned long int>("ul").set(0, ULONG_MAX);
+    buffer.get<char>("c").set(0, -5);
+    buffer.get<unsigned char>("uc").set(0, 255);
+
+    buffer.get<int>("i").set(1, 0);
+    buffer.get<long int>("l").set(1, LONG_MAX);
+    buffer.get<unsigned long int>("ul").set(1, 0);
+    buffer.get<char>("c").set(1, 'A'); // written as number
+    buffer.get<unsigned char>("uc").set(1, 0);
+
+    MySQLLoadDataWriter writer (buffer);
+
+    std::string text;
+    writer.write(text, 0, 2);
+
+    BOOST_CHECK_EQUAL (text, std::to_string(INT_MIN) + "\t" + std::to_string(LONG_MIN) + "\t"
+                       + std::to_string(ULONG_MAX) + "\t-5\t255\n"
+                       "0\t" + std::to_string(LONG_MAX) + "\t0\t65\t0\n");
+}
+
+BOOST_AUTO_TEST_CASE( floating_point )
+{
+    PropertyList list;
+    list.addProperty("f", PropertyDataType::FLOAT);
+    list.addProperty("d", PropertyDataType::DOUBLE);
+
+    Buffer buffer (list, "Test");
+    buffer.get<float>("f").set(0, 0.1f);
+    buffer.get<double>("d").set(0, 0.1);
+    buffer.get<float>("f").set(1, NAN);
+    buffer.get<double>("d").set(1, INFINITY);
+    buffer.get<float>("f").set(2, -2.5f);
+    buffer.get<double>("d").set(2, 1e300);
+
+    MySQLLoadDataWriter writer (buffer);
+
+    std::string text;
+    writer.write(text, 0, 3);
+
+    size_t line_end = text.find('\n');
+    std::string first = text.substr(0, line_end);
+    size_t tab = first.find('\t');
+
+    BOOST_CHECK_EQUAL (std::strtof(first.substr(0, tab).c_str(), nullptr), 0.1f); // round-trip precision
+    BOOST_CHECK_EQUAL (std::strtod(first.substr(tab+1).c_str(), nullptr), 0.1);
+
+    BOOST_CHECK_EQUAL (text.substr(line_end+1), "\\N\t\\N\n-2.5\t1.0000000000000001e+300\n");
+}
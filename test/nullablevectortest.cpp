@@ -0,0 +1,298 @@
+/*
+ * This file is part of ATSDB.
+ *
+ * ATSDB is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * ATSDB is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with ATSDB.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#define BOOST_TEST_MODULE NullableVectorTest
+#include <boost/test/included/unit_test.hpp>
+
+#include <map>
+#include <set>
+
+#include "buffer.h"
+
+namespace
+{
+
+PropertyList intProperties ()
+{
+    PropertyList list;
+    list.addProperty("value", PropertyDataType::INT);
+    return list;
+}
+
+}
+
+BOOST_AUTO_TEST_CASE( validity_without_nulls )
+{
+    Buffer buffer (intProperties(), "Test");
+    NullableVector<int>& values = buffer.get<int>("value");
+
+    for (int cnt=0; cnt < 100; ++cnt)
+        values.set(cnt, cnt);
+
+    BOOST_CHECK_EQUAL (values.size(), 100);
+    BOOST_CHECK (values.validity() == nullptr);
+    BOOST_REQUIRE (values.data() != nullptr);
+
+    for (int cnt=0; cnt < 100; ++cnt)
+        BOOST_CHECK_EQUAL (values.data()[cnt], cnt);
+}
+
+BOOST_AUTO_TEST_CASE( validity_bitmap )
+{
+    Buffer buffer (intProperties(), "Test");
+    NullableVector<int>& values = buffer.get<int>("value");
+
+    for (int cnt=0; cnt < 200; ++cnt)
+    {
+        if (cnt % 3)
+            values.set(cnt, cnt);
+        else
+            values.setNull(cnt);
+    }
+
+    const uint64_t* validity = values.validity();
+    BOOST_REQUIRE (validity != nullptr);
+
+    for (int cnt=0; cnt < 200; ++cnt)
+    {
+        BOOST_CHECK_EQUAL (values.isNull(cnt), cnt % 3 == 0);
+        BOOST_CHECK_EQUAL (NullableVector<int>::isValid(validity, cnt), cnt % 3 != 0);
+    }
+
+    values.set(63, 63); // unsets Null at word boundary
+    BOOST_CHECK (!values.isNull(63));
+    BOOST_CHECK_EQUAL (values.get(63), 63);
+    BOOST_CHECK_THROW (values.get(0), std::runtime_error);
+}
+
+BOOST_AUTO_TEST_CASE( gap_is_null )
+{
+    Buffer buffer (intProperties(), "Test");
+    NullableVector<int>& values = buffer.get<int>("value");
+
+    values.set(0, 1);
+    values.set(130, 2);
+
+    BOOST_CHECK_EQUAL (values.size(), 131);
+    BOOST_CHECK (!values.isNull(0));
+    BOOST_CHECK (!values.isNull(130));
+
+    for (int cnt=1; cnt < 130; ++cnt)
+        BOOST_CHECK (values.isNull(cnt));
+
+    BOOST_CHECK (values.isNull(131)); // not yet set
+}
+
+BOOST_AUTO_TEST_CASE( append_with_validity )
+{
+    Buffer buffer (intProperties(), "Test");
+    NullableVector<int>& values = buffer.get<int>("value");
+
+    values.set(0, -1);
+    values.set(1, -2);
+    values.set(2, -3); // appends start unaligned to validity words
+
+    std::vector<int> chunk (100);
+    std::vector<uint64_t> chunk_validity (2, 0);
+
+    for (int cnt=0; cnt < 100; ++cnt)
+    {
+        chunk[cnt] = cnt;
+
+        if (cnt % 2)
+            chunk_validity[cnt / 64] |= uint64_t(1) << (cnt % 64);
+    }
+
+    values.append(chunk.data(), chunk_validity.data(), chunk.size());
+    values.append(chunk.data(), nullptr, 70);
+
+    BOOST_CHECK_EQUAL (values.size(), 173);
+
+    for (int cnt=0; cnt < 3; ++cnt)
+        BOOST_CHECK_EQUAL (values.get(cnt), -1-cnt);
+
+    for (int cnt=0; cnt < 100; ++cnt)
+    {
+        BOOST_CHECK_EQUAL (values.isNull(3+cnt), cnt % 2 == 0);
+
+        if (cnt % 2)
+            BOOST_CHECK_EQUAL (values.get(3+cnt), cnt);
+    }
+
+    for (int cnt=0; cnt < 70; ++cnt)
+        BOOST_CHECK_EQUAL (values.get(103+cnt), cnt);
+}
+
+BOOST_AUTO_TEST_CASE( cut_and_grow )
+{
+    Buffer buffer (intProperties(), "Test");
+    NullableVector<int>& values = buffer.get<int>("value");
+
+    for (int cnt=0; cnt < 100; ++cnt)
+        values.set(cnt, cnt);
+
+    buffer.cutToSize(10);
+    BOOST_CHECK_EQUAL (buffer.size(), 10);
+    BOOST_CHECK_EQUAL (values.size(), 10);
+
+    values.set(20, 20); // rows dropped by cut must not reappear
+
+    for (int cnt=0; cnt < 10; ++cnt)
+        BOOST_CHECK_EQUAL (values.get(cnt), cnt);
+
+    for (int cnt=10; cnt < 20; ++cnt)
+        BOOST_CHECK (values.isNull(cnt));
+
+    BOOST_CHECK_EQUAL (values.get(20), 20);
+}
+
+BOOST_AUTO_TEST_CASE( reserve_keeps_size )
+{
+    Buffer buffer (intProperties(), "Test");
+
+    buffer.reserve(1000);
+    BOOST_CHECK_EQUAL (buffer.size(), 0);
+    BOOST_CHECK_EQUAL (buffer.get<int>("value").size(), 0);
+}
+
+BOOST_AUTO_TEST_CASE( dictionary_strings )
+{
+    PropertyList list;
+    list.addProperty("s", PropertyDataType::STRING);
+
+    Buffer buffer (list, "Test");
+    NullableVector<std::string>& values = buffer.get<std::string>("s");
+
+    values.set(0, "a");
+    values.set(1, "b");
+    values.set(2, "a");
+    values.setNull(3);
+    values.set(4, "");
+
+    BOOST_CHECK_EQUAL (values.size(), 5);
+    BOOST_CHECK_EQUAL (values.get(0), "a");
+    BOOST_CHECK_EQUAL (values.get(1), "b");
+    BOOST_CHECK_EQUAL (values.get(4), "");
+    BOOST_CHECK (values.isNull(3));
+
+    const uint32_t* codes = values.data();
+    BOOST_CHECK_EQUAL (codes[0], codes[2]); // equal values share a code
+    BOOST_CHECK (codes[0] != codes[1]);
+    BOOST_CHECK_EQUAL (values.dictionary().value(codes[1]), "b");
+
+    std::map<std::string, std::vector<size_t>> indexes = values.distinctValuesWithIndexes(0, 4);
+    BOOST_CHECK_EQUAL (indexes.size(), 3);
+    BOOST_CHECK (indexes.at("a") == std::vector<size_t>({0, 2}));
+    BOOST_CHECK (indexes.at("b") == std::vector<size_t>({1}));
+    BOOST_CHECK (indexes.at("") == std::vector<size_t>({4}));
+
+    std::set<std::string> distinct = values.distinctValues();
+    BOOST_CHECK (distinct == std::set<std::string>({"", "a", "b"}));
+}
+
+BOOST_AUTO_TEST_CASE( dictionary_strings_seized )
+{
+    PropertyList list;
+    list.addProperty("s", PropertyDataType::STRING);
+
+    Buffer all (list, "Test");
+
+    for (int chunk=0; chunk < 3; ++chunk)
+    {
+        Buffer buffer (list, "Test");
+        NullableVector<std::string>& values = buffer.get<std::string>("s");
+
+        // dictionaries differ in content and code order between chunks
+        for (int cnt=0; cnt < 10; ++cnt)
+            values.set(cnt, "v" + std::to_string((cnt + chunk) % (4 + chunk)));
+
+        all.seizeBuffer(buffer);
+    }
+
+    NullableVector<std::string>& values = all.get<std::string>("s");
+    BOOST_CHECK_EQUAL (values.size(), 30);
+
+    for (int chunk=0; chunk < 3; ++chunk)
+    {
+        for (int cnt=0; cnt < 10; ++cnt)
+            BOOST_CHECK_EQUAL (values.get(chunk*10+cnt), "v" + std::to_string((cnt + chunk) % (4 + chunk)));
+    }
+
+    BOOST_CHECK_EQUAL (values.distinctValues().size(), 6);
+
+    std::shared_ptr<Buffer> copy = all.getPartialCopy(all.properties());
+    copy->get<std::string>("s").set(0, "new"); // copies the shared dictionary
+
+    BOOST_CHECK_EQUAL (copy->get<std::string>("s").get(0), "new");
+    BOOST_CHECK_EQUAL (values.get(0), "v0");
+
+    uint32_t code;
+    BOOST_CHECK (!values.dictionary().find("new", code));
+}
+
+BOOST_AUTO_TEST_CASE( scale_not_null )
+{
+    Buffer buffer (intProperties(), "Test");
+    NullableVector<int>& values = buffer.get<int>("value");
+
+    for (int cnt=0; cnt < 300; ++cnt)
+    {
+        if (cnt >= 64 && cnt < 192) // two all-Null words
+            values.setNull(cnt);
+        else
+            values.set(cnt, cnt);
+    }
+
+    values *= 2.5;
+
+    for (int cnt=0; cnt < 300; ++cnt)
+    {
+        BOOST_CHECK_EQUAL (values.isNull(cnt), cnt >= 64 && cnt < 192);
+
+        if (!values.isNull(cnt))
+            BOOST_CHECK_EQUAL (values.get(cnt), static_cast<int>(cnt * 2.5));
+    }
+}
+
+BOOST_AUTO_TEST_CASE( octal_format )
+{
+    Buffer buffer (intProperties(), "Test");
+    NullableVector<int>& values = buffer.get<int>("value");
+
+    std::vector<int> octal {0, 7, 10, 17, 777, -17, 7777, 128, 108};
+    std::vector<int> decimal {0, 7, 8, 15, 511, -15, 4095, 10, 8}; // as std::stoi, up to first non-octal digit
+
+    for (size_t cnt=0; cnt < 100; ++cnt)
+        values.set(cnt, octal.at(cnt % octal.size()));
+
+    values.set(100, 9);
+    values.setNull(100); // Null values are not parsed
+
+    values.convertToStandardFormat("octal");
+
+    for (size_t cnt=0; cnt < 100; ++cnt)
+        BOOST_CHECK_EQUAL (values.get(cnt), decimal.at(cnt % decimal.size()));
+
+    BOOST_CHECK (values.isNull(100));
+
+    Buffer invalid_buffer (intProperties(), "Test");
+    NullableVector<int>& invalid_values = invalid_buffer.get<int>("value");
+
+    invalid_values.set(0, 17);
+    invalid_values.set(1, 95); // no leading octal digit
+    BOOST_CHECK_THROW (invalid_values.convertToStandardFormat("octal"), std::invalid_argument);
+}